@@ -79,12 +79,22 @@ private:
          throw std::runtime_error("BridgeIteratorCached: dereferencing past end of sequence");
 #endif
       if (!m_cached) {
-         m_value = m_seq->element(this->base_reference());   
+         fetch(*m_seq, this->base_reference(), m_value, 0);
          m_cached = true;
       }
       return m_value;
    }
 
+   // updates the cached value in place if the sequence can store its elements
+   template <class S>
+   static auto fetch(const S& seq, const typename S::Base::const_iterator& it, value_type& value, int)
+      -> decltype(seq.storeElement(it, value), void())
+   { seq.storeElement(it, value); }
+
+   template <class S>
+   static void fetch(const S& seq, const typename S::Base::const_iterator& it, value_type& value, long)
+   { value = seq.element(it); }
+
    ptrdiff_t distance_to(const BridgeIteratorCached& other) const
    { return m_seq == other.m_seq ? other.base_reference() - this->base_reference() : std::numeric_limits<ptrdiff_t>::max(); }
 
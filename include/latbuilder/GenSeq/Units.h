@@ -0,0 +1,179 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LATBUILDER__GEN_SEQ__UNITS_H
+#define LATBUILDER__GEN_SEQ__UNITS_H
+
+#include "latbuilder/GenSeq/CyclicGroup.h"
+#include "latbuilder/GenSeq/GeneratingValues.h"
+#include "latbuilder/Util.h"
+
+#include <boost/iterator/iterator_facade.hpp>
+
+namespace LatBuilder { namespace GenSeq {
+
+/**
+ * Sequence of the integers coprime with a modulus \f$n\f$, for ordinary
+ * lattices.
+ *
+ * If \f$n\f$ is a prime power, the sequence is the cyclic group of units
+ * modulo \f$n\f$ and visits its elements in the same order as CyclicGroup.
+ * Otherwise, the units modulo \f$n\f$ do not form a cyclic group, and the
+ * sequence visits them in the order of GeneratingValues.
+ *
+ * \tparam COMPRESS  Compression type.
+ */
+template <Compress COMPRESS = Compress::NONE>
+class Units {
+public:
+   typedef CyclicGroup<LatticeType::ORDINARY, COMPRESS> Group;
+   typedef GeneratingValues<LatticeType::ORDINARY, COMPRESS> Values;
+
+   typedef typename Values::size_type size_type;
+   typedef typename Values::value_type value_type;
+   typedef typename Values::Modulus Modulus;
+
+   /**
+    * Traversal type.  Only its size is used.
+    */
+   typedef CyclicGroupTraversal<LatticeType::ORDINARY> Traversal;
+
+   class const_iterator;
+
+   static constexpr LatBuilder::Compress compress() { return COMPRESS; }
+
+   static std::string name()
+   { return std::string("units / ") + CompressTraits<COMPRESS>::name() + " / " + Traversal::name(); }
+
+   /**
+    * Constructor.
+    *
+    * \param modulus    Modulus \f$n\f$.
+    * \param trav       Traversal instance.
+    */
+   Units(Modulus modulus = (Modulus)(1), Traversal trav = Traversal());
+
+   /**
+    * Returns the modulus.
+    */
+   Modulus modulus() const
+   { return m_cyclic ? m_group.modulus() : m_values.modulus(); }
+
+   /**
+    * Returns the size of the sequence.
+    */
+   size_type size() const
+   { return m_cyclic ? m_group.size() : m_values.size(); }
+
+   /**
+    * Returns \c true if the sequence is the cyclic group of units modulo a
+    * prime power.
+    */
+   bool isCyclic() const
+   { return m_cyclic; }
+
+   /**
+    * Returns an iterator pointing to the first element.
+    */
+   const_iterator begin() const
+   { return m_cyclic ? const_iterator(m_group.begin()) : const_iterator(m_values.begin()); }
+
+   /**
+    * Returns an iterator pointing past the last element.
+    */
+   const_iterator end() const
+   { return m_cyclic ? const_iterator(m_group.end()) : const_iterator(m_values.end()); }
+
+private:
+   bool m_cyclic;
+   Group m_group;
+   Values m_values;
+};
+
+/**
+ * Immutable iterator over Units.
+ *
+ * It wraps the iterator of the underlying cyclic group or sequence of
+ * generating values.
+ */
+template <Compress COMPRESS>
+class Units<COMPRESS>::const_iterator :
+   public boost::iterators::iterator_facade<const_iterator,
+      const value_type,                                 // value
+      boost::iterators::random_access_traversal_tag,    // traversal
+      const value_type,                                 // reference
+      ptrdiff_t>                                        // difference
+{
+public:
+   const_iterator():
+      m_cyclic(false)
+   {}
+
+   explicit const_iterator(typename Group::const_iterator it):
+      m_cyclic(true), m_groupIt(std::move(it))
+   {}
+
+   explicit const_iterator(typename Values::const_iterator it):
+      m_cyclic(false), m_valuesIt(std::move(it))
+   {}
+
+private:
+   friend class boost::iterators::iterator_core_access;
+
+   value_type dereference() const
+   { return m_cyclic ? *m_groupIt : *m_valuesIt; }
+
+   void increment()
+   {
+      if (m_cyclic)
+         ++m_groupIt;
+      else
+         ++m_valuesIt;
+   }
+
+   bool equal(const const_iterator& other) const
+   { return m_cyclic == other.m_cyclic and (m_cyclic ? m_groupIt == other.m_groupIt : m_valuesIt == other.m_valuesIt); }
+
+   ptrdiff_t distance_to(const const_iterator& other) const
+   {
+      if (m_cyclic != other.m_cyclic)
+         return std::numeric_limits<ptrdiff_t>::max();
+      return m_cyclic ? other.m_groupIt - m_groupIt : other.m_valuesIt - m_valuesIt;
+   }
+
+   bool m_cyclic;
+   typename Group::const_iterator m_groupIt;
+   typename Values::const_iterator m_valuesIt;
+};
+
+//================================================================================
+// Implementation
+//================================================================================
+
+template <Compress COMPRESS>
+Units<COMPRESS>::Units(Modulus modulus, Traversal trav)
+{
+   const auto factors = primeFactorsMap(modulus);
+   m_cyclic = factors.size() == 1;
+   if (m_cyclic)
+      m_group = Group(factors.begin()->first, factors.begin()->second, std::move(trav));
+   else
+      m_values = Values(modulus, typename Values::Traversal(0, trav.size()));
+}
+
+}}
+
+#endif
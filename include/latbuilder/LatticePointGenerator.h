@@ -0,0 +1,173 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LATBUILDER__LATTICE_POINT_GENERATOR_H
+#define LATBUILDER__LATTICE_POINT_GENERATOR_H
+
+#include "latbuilder/Types.h"
+#include "latbuilder/LatDef.h"
+#include "latbuilder/LFSR258.h"
+
+#include "netbuilder/PointFile.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace LatBuilder
+{
+
+/**
+ * Generator of the points of an ordinary rank-1 lattice, possibly randomly shifted.
+ *
+ * Point \f$i\f$ of the lattice with \f$n\f$ points and generating vector \f$\boldsymbol a\f$ is
+ * \f$\{i \boldsymbol a / n + \boldsymbol\Delta\}\f$, where \f$\boldsymbol\Delta \in [0,1)^s\f$ is a shift
+ * (zero by default) and \f$\{\cdot\}\f$ denotes the fractional part. The baker's transformation
+ * \f$u \mapsto 1 - |2u - 1|\f$ can be applied to the shifted coordinates.
+ *
+ * The points are enumerated either in the natural order, or, for embedded lattices with \f$n = b^m\f$ points, in the
+ * radical-inverse order in base \f$b\f$ (see NetBuilder::PointOrder), where the first \f$b^k\f$ points form the lattice
+ * of level \f$k\f$. In both cases, the numerators \f$i a_j \bmod n\f$ are updated with one addition modulo \f$n\f$ per
+ * coordinate from one point to the next: in the radical-inverse order, the increment only depends on the number of carries
+ * when incrementing the index in base \f$b\f$ and is precomputed. Any block of consecutive points can be generated on its own.
+ * When compiled with AVX2, the coordinates are updated and converted four at a time.
+ */
+class LatticePointGenerator {
+public:
+   /**
+    * Constructor.
+    * \param numPoints     Number of points \f$n\f$ of the lattice.
+    * \param gen           Generating vector.
+    * \param order         Order of the points (natural or radical-inverse).
+    * \param base          Base \f$b\f$ of the radical-inverse order; \f$n\f$ must be a power of \f$b\f$.
+    */
+   LatticePointGenerator(uInteger numPoints, std::vector<uInteger> gen, NetBuilder::PointOrder order = NetBuilder::PointOrder::NATURAL, uInteger base = 2);
+
+   /**
+    * Constructs the generator of the points of \c lat in the natural order.
+    */
+   LatticePointGenerator(const LatDef<LatticeType::ORDINARY, EmbeddingType::UNILEVEL>& lat):
+      LatticePointGenerator(lat.sizeParam().numPoints(), lat.gen())
+   {}
+
+   /**
+    * Constructs the generator of the points of the embedded lattice \c lat in the radical-inverse order.
+    */
+   LatticePointGenerator(const LatDef<LatticeType::ORDINARY, EmbeddingType::MULTILEVEL>& lat):
+      LatticePointGenerator(lat.sizeParam().numPoints(), lat.gen(), NetBuilder::PointOrder::RADICAL_INVERSE, lat.sizeParam().base())
+   {}
+
+   /**
+    * Returns the number of points.
+    */
+   uInteger numPoints() const
+   { return m_numPoints; }
+
+   /**
+    * Returns the dimension of the points.
+    */
+   Dimension dimension() const
+   { return m_gen.size(); }
+
+   /**
+    * Returns the order of the points.
+    */
+   NetBuilder::PointOrder order() const
+   { return m_order; }
+
+   /**
+    * Writes the numerators \f$i a_j \bmod n\f$ of the points \c first to <code>first + count - 1</code>,
+    * point after point, in \c numerators.
+    */
+   void generateNumerators(uint64_t* numerators, uInteger first, uInteger count) const;
+
+   /**
+    * Writes the points \c first to <code>first + count - 1</code>, point after point, in \c points.
+    */
+   void generate(Real* points, uInteger first, uInteger count) const;
+
+   /**
+    * Writes the shifted points \c first to <code>first + count - 1</code>, point after point, in \c points.
+    * \param points        Buffer of size <code>count * dimension()</code>.
+    * \param first         Index of the first point.
+    * \param count         Number of points.
+    * \param shift         Shift of the points, in \f$[0,1)^s\f$; if empty, the points are not shifted.
+    * \param bakerTransform Whether to apply the baker's transformation.
+    */
+   void generate(Real* points, uInteger first, uInteger count, const std::vector<Real>& shift, bool bakerTransform = false) const;
+
+   /**
+    * Writes the points \c first to <code>first + count - 1</code> in the given format, point after point, in \c points.
+    * The integer formats contain the numerators \f$i a_j \bmod n\f$; the 32-bit format requires \f$n \leq 2^{32}\f$.
+    */
+   void generate(NetBuilder::PointFormat format, void* points, uInteger first, uInteger count) const;
+
+   /**
+    * Writes the shifted points \c first to <code>first + count - 1</code> in the given real format, point after point, in \c points.
+    * The integer formats are not available for shifted or transformed points.
+    */
+   void generate(NetBuilder::PointFormat format, void* points, uInteger first, uInteger count, const std::vector<Real>& shift, bool bakerTransform = false) const;
+
+   /**
+    * Writes all the points once for each shift, replicate after replicate, in \c points.
+    * \param points        Buffer of size <code>shifts.size() * numPoints() * dimension()</code>.
+    * \param shifts        Shifts of the replicates.
+    * \param bakerTransform Whether to apply the baker's transformation.
+    */
+   void generateReplicates(Real* points, const std::vector<std::vector<Real>>& shifts, bool bakerTransform = false) const;
+
+   /**
+    * Returns \c numReplicates independent random shifts, uniformly distributed in \f$[0,1)^s\f$.
+    * The shift of replicate \f$r\f$ is drawn from the <tt>LFSR258</tt> generator started from \c seed and jumped \f$r\f$
+    * times ahead by \f$2^{100}\f$ steps, as in NetBuilder::RandomizedPointGenerator.
+    */
+   std::vector<std::vector<Real>> randomShifts(unsigned int numReplicates, LFSR258::seed_type seed = LFSR258::default_seed) const;
+
+   /**
+    * Writes all the points in a point file (see NetBuilder::PointFileWriter), block after block, once for each shift.
+    * \param filename      Name of the file. The file is overwritten.
+    * \param format        Format of the values.
+    * \param useMemoryMap  Whether to write the file through a memory mapping.
+    * \param shifts        Shifts of the replicates; if empty, the points are written once without shift.
+    * \param bakerTransform Whether to apply the baker's transformation.
+    */
+   void generateToFile(const std::string& filename, NetBuilder::PointFormat format = NetBuilder::PointFormat::FLOAT64, bool useMemoryMap = false,
+         const std::vector<std::vector<Real>>& shifts = {}, bool bakerTransform = false) const;
+
+private:
+   /**
+    * Enumerates the numerators of the points \c first to <code>first + count - 1</code> and calls
+    * <code>visit(numerators)</code> for each point, where \c numerators is an array of size dimension().
+    */
+   template <typename VISIT>
+   void enumerate(uInteger first, uInteger count, VISIT visit) const;
+
+   /**
+    * Returns the index in the lattice of the point at position \c position in the order of the generator.
+    */
+   uInteger index(uInteger position) const;
+
+   uInteger m_numPoints;
+   std::vector<uInteger> m_gen;
+   NetBuilder::PointOrder m_order;
+   uInteger m_base;
+   unsigned int m_numDigits; // number of digits in base m_base of the positions, for the radical-inverse order
+   std::vector<uInteger> m_steps; // increments of the numerators, m_steps[c * dimension() + j] after c carries of the position
+};
+
+}
+
+#endif
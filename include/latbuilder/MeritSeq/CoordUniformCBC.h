@@ -245,7 +245,7 @@ public:
                throw std::runtime_error("CoordUniformCBC::Seq: dereferencing past end of sequence");
 #endif
             if (not m_cached) {
-               m_value = computeValue();
+               computeValue();
                m_cached = true;
             }
             return m_value;
@@ -258,12 +258,12 @@ public:
             m_cached = false;
          }
 
-         MeritValue computeValue() const
+         // computes the value in place, so that multilevel merit values reuse their storage
+         void computeValue() const
          {
-            auto merit = *m_prod;
-            m_lat->sizeParam().normalize(merit);
-            merit += seq().cbc().baseMerit();
-            return merit;
+            m_value = *m_prod;
+            m_lat->sizeParam().normalize(m_value);
+            m_value += seq().cbc().baseMerit();
          }
 
       private:
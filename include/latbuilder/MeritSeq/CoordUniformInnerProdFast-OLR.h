@@ -0,0 +1,678 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LATBUILDER__MERIT_SEQ__INNER_PROD_FAST_OLR_H
+#define LATBUILDER__MERIT_SEQ__INNER_PROD_FAST_OLR_H
+
+#include "latbuilder/MeritSeq/CoordUniformInnerProdFast.h"
+#include "latbuilder/GenSeq/GeneratingValues.h"
+#include "latbuilder/GenSeq/Units.h"
+#include "latbuilder/CompressTraits.h"
+#include "latbuilder/UnitGroup.h"
+
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+namespace LatBuilder { namespace MeritSeq {
+
+namespace detail {
+   template <class GENSEQ>
+   struct HasUnitsOnly
+   { static constexpr bool value = false; };
+
+   template <LatticeType LR, Compress COMPRESS, class TRAV, GenSeq::GroupOrder ORDER>
+   struct HasUnitsOnly<GenSeq::CyclicGroup<LR, COMPRESS, TRAV, ORDER>>
+   { static constexpr bool value = true; };
+
+   template <LatticeType LR, Compress COMPRESS, class TRAV>
+   struct HasUnitsOnly<GenSeq::GeneratingValues<LR, COMPRESS, TRAV>>
+   { static constexpr bool value = true; };
+
+   template <Compress COMPRESS>
+   struct HasUnitsOnly<GenSeq::Units<COMPRESS>>
+   { static constexpr bool value = true; };
+}
+
+/**
+ * FFT-based implementation of the inner product for ordinary lattices with a
+ * single level, for any number of points \f$n\f$.
+ *
+ * The points \f$i\f$ such that \f$\gcd(i, n) = n/m\f$ form a block indexed by
+ * the group of units modulo the divisor \f$m\f$ of \f$n\f$, which is a direct
+ * product of cyclic groups (see UnitGroup).  On each block, the inner products
+ * for all the generators coprime with \f$n\f$ are a correlation over this
+ * group, computed with a multi-dimensional FFT.  The contributions of the
+ * blocks are then added along the divisors of \f$n\f$, one prime factor at a
+ * time.  If \f$n\f$ is an integer power of a prime base, the blocks are the
+ * levels of the block-circulant matrix of \cite rCOO06a .
+ *
+ * The inner products are stored by generator value, so that the generators
+ * can be any sequence of integers modulo \f$n\f$.  The inner product for a
+ * generator \f$a\f$ that is not coprime with \f$n\f$ is that for the unit
+ * \f$a/e\f$ modulo \f$n/e\f$, where \f$e = \gcd(a, n)\f$, with the vector
+ * folded modulo \f$n/e\f$.  It is computed in the same way, only if the
+ * sequence of generators contains such values.
+ *
+ * When several threads are set with Parallel::setNumThreads() before
+ * construction, the independent blocks are convolved concurrently, and the
+ * transforms of the largest blocks use FFTW's threads if they are available
+ * (see fftw::set_planner_threads()).
+ */
+template <Compress COMPRESS, PerLevelOrder PLO>
+class CoordUniformInnerProdFast<LatticeType::ORDINARY, EmbeddingType::UNILEVEL, COMPRESS, PLO> {
+
+protected:
+   typedef typename fftw<Real>::complex Complex;
+   typedef typename fftw<Real>::complex_vector FFTComplexVector;
+   typedef LatBuilder::CompressTraits<COMPRESS> Compression;
+
+public:
+   typedef Storage<LatticeType::ORDINARY, EmbeddingType::UNILEVEL, COMPRESS, PLO> InternalStorage;
+   typedef CoordUniformStateList<LatticeType::ORDINARY, EmbeddingType::UNILEVEL, COMPRESS, PLO> StateList;
+   typedef typename InternalStorage::MeritValue MeritValue;
+   typedef UnitGroup::Modulus Modulus;
+
+   /**
+    * Block of the points \f$(n/m) v\f$, for the units \f$v\f$ modulo a
+    * divisor \f$m\f$ of \f$n\f$.
+    */
+   struct Block {
+      /// Divisor \f$m\f$ of \f$n\f$.
+      Modulus modulus;
+      /// Position of the values of the block in the work vector.
+      size_t offset;
+      /// Number of units (or of classes of opposite units) modulo \f$m\f$.
+      size_t size;
+      /// Order of each cyclic component modulo \f$m\f$.
+      std::vector<size_t> orders;
+      /// Dimensions of the transform: the orders larger than 1.
+      std::vector<int> dims;
+   };
+
+   /**
+    * Constructor.
+    *
+    * \param storage       Storage configuration.
+    * \param kernel        Kernel.  Used to create a sequence of
+    *                      permuatations of the kernel values evaluated at every
+    *                      one-dimensional lattice point.
+    */
+   template <class K>
+   CoordUniformInnerProdFast(
+         InternalStorage storage,
+         const Kernel::Base<K>& kernel
+         ):
+      m_storage(std::move(storage)),
+      m_kernelValues(kernel.valuesVector(this->internalStorage())),
+      m_group(this->storage().sizeParam().modulus(), this->storage().symmetric()),
+      m_blocks(computeBlocks()),
+      m_kernelFFT(computeKernelFFT()),
+      m_workspace(blocks(), Parallel::numThreads() > 1)
+   {}
+
+   /**
+    * Work buffers of the transforms computed by computeProdValues().
+    *
+    * As for the prime power case, the buffers are allocated once and the
+    * transforms are performed in place.  A single buffer sized for the
+    * largest block is shared by all blocks, unless the blocks are to be
+    * convolved concurrently.  The workspace also holds the values of all the
+    * blocks, and keeps the output vector of the last destroyed sequence of
+    * inner products, so that the next one reuses its storage.
+    */
+   class Workspace {
+   public:
+      /**
+       * Constructor.
+       *
+       * \param blocks     Blocks of points.
+       * \param perBlock   Whether each block has its own buffer.
+       */
+      explicit Workspace(
+            const std::vector<Block>& blocks = {},
+            bool perBlock = false
+            ):
+         m_perBlock(perBlock)
+      {
+         size_t size = 0;
+         size_t numValues = 0;
+         for (const auto& block : blocks) {
+            if (perBlock)
+               m_buffers.emplace_back(bufferSize(block));
+            size = std::max(size, bufferSize(block));
+            numValues = std::max(numValues, block.offset + block.size);
+         }
+         if (not perBlock)
+            m_buffers.emplace_back(size);
+         m_blockValues.resize(numValues);
+      }
+
+      /**
+       * Returns the number of complex values needed for the transform of \c
+       * block.
+       */
+      static size_t bufferSize(const Block& block)
+      { return fftw<Real>::fft_size(block.dims); }
+
+      /**
+       * Returns whether each block has its own buffer.
+       */
+      bool perBlock() const
+      { return m_perBlock; }
+
+      /**
+       * Returns the buffer of block \c block, which holds either real or
+       * complex values.
+       */
+      FFTComplexVector& buffer(size_t block)
+      { return m_buffers[m_perBlock ? block : 0]; }
+
+      /**
+       * Returns the values of all the blocks, one block after the other.
+       */
+      RealVector& blockValues()
+      { return m_blockValues; }
+
+      /**
+       * Moves the kept output vector into \c out and resizes it to \c size
+       * elements, which allocates memory only if its size changes.
+       */
+      void takeOutput(RealVector& out, size_t size)
+      {
+         out.swap(m_output);
+         if (out.size() != size)
+            out.resize(size, false);
+      }
+
+      /**
+       * Keeps the storage of \c out for the next call to takeOutput().
+       */
+      void keepOutput(RealVector& out)
+      {
+         if (out.size() > 0)
+            m_output.swap(out);
+      }
+
+   private:
+      bool m_perBlock;
+      std::vector<FFTComplexVector> m_buffers;
+      RealVector m_blockValues;
+      RealVector m_output;
+   };
+
+   /**
+    * Returns the storage configuration instance.
+    */
+   const InternalStorage& storage() const
+   { return m_storage; }
+
+   /**
+    * Returns the internal storage configuration instance.
+    */
+   const InternalStorage& internalStorage() const
+   { return m_storage; }
+
+   /**
+    * Returns the vector of kernel values.
+    */
+   const RealVector& kernelValues() const
+   { return m_kernelValues; }
+
+   /**
+    * Returns the group of units modulo the number of points.
+    */
+   const UnitGroup& unitGroup() const
+   { return m_group; }
+
+   /**
+    * Returns the blocks of points, by increasing divisor of the number of
+    * points.
+    */
+   const std::vector<Block>& blocks() const
+   { return m_blocks; }
+
+   /**
+    * Returns the FFT's of the kernel values of each block, multiplied by the
+    * number of units in each class of opposite units.
+    */
+   const std::vector<FFTComplexVector>& kernelFFT() const
+   { return m_kernelFFT; }
+
+private:
+   Modulus modulus() const
+   { return m_group.modulus(); }
+
+   /**
+    * Returns the index of the block of the divisor \c m.
+    */
+   size_t blockIndex(Modulus m) const
+   {
+      const auto& divisors = m_group.divisors();
+      return std::lower_bound(divisors.begin(), divisors.end(), m) - divisors.begin();
+   }
+
+   /**
+    * Returns the index, in the vector of inner products, of generator \c a.
+    */
+   size_t valueIndex(Modulus a) const
+   { return Compression::compressIndex(a % modulus(), modulus()); }
+
+   /**
+    * Returns the greatest common divisors, other than 1, of \f$n\f$ with the
+    * elements of \c genSeq.
+    */
+   template <class GENSEQ>
+   std::vector<Modulus> cofactors(const GENSEQ& genSeq) const
+   {
+      std::vector<Modulus> out;
+      // the sequences of units for the trivial modulus consist of 0
+      if (detail::HasUnitsOnly<GENSEQ>::value and genSeq.size() > 1)
+         return out;
+      std::vector<bool> found(blocks().size(), false);
+      for (const auto& a : genSeq) {
+         Modulus x = modulus();
+         Modulus y = static_cast<Modulus>(a) % x;
+         while (y != 0) {
+            const Modulus r = x % y;
+            x = y;
+            y = r;
+         }
+         if (x != 1)
+            found[blockIndex(x)] = true;
+      }
+      for (size_t i = 0; i < found.size(); i++) {
+         if (found[i])
+            out.push_back(m_group.divisors()[i]);
+      }
+      return out;
+   }
+
+   /**
+    * Computes the inner products of \c ve with all the vectors of the
+    * sequence, for the generators coprime with \f$n\f$ and for the
+    * generators whose greatest common divisor with \f$n\f$ is in \c
+    * cofactors, using the work buffers of \c workspace, and stores them into
+    * \c out by generator value.
+    */
+   template <class E>
+   void computeProdValues(
+         const boost::numeric::ublas::vector_expression<E>& ve,
+         RealVector& out,
+         const std::vector<Modulus>& cofactors,
+         Workspace& workspace
+         ) const
+   {
+      const RealVector& vec = ve();
+
+      if (vec.size() != storage().size() or out.size() != storage().size())
+         throw std::logic_error("invalid size of weighted state vector");
+
+      for (size_t i = 0; i < blocks().size(); i++) {
+         if (workspace.buffer(i).size() < Workspace::bufferSize(blocks()[i]))
+            throw std::logic_error("workspace is too small for the largest block");
+      }
+
+      computeFoldedProdValues(vec, 1, out, workspace);
+      for (const auto e : cofactors)
+         computeFoldedProdValues(vec, e, out, workspace);
+   }
+
+   /**
+    * Same as above, using the workspace of this instance.
+    */
+   template <class E>
+   void computeProdValues(
+         const boost::numeric::ublas::vector_expression<E>& ve,
+         RealVector& out,
+         const std::vector<Modulus>& cofactors
+         ) const
+   { computeProdValues(ve, out, cofactors, m_workspace); }
+
+   /**
+    * Computes the inner products for the generators \f$a\f$ such that
+    * \f$\gcd(a, n) = \f$ \c fold, i.e., for the units modulo \f$n\f$ / \c
+    * fold, with \c vec folded modulo \f$n\f$ / \c fold.
+    *
+    * The blocks whose transforms use FFTW's threads are convolved one after
+    * the other, and the other ones concurrently, largest first, if \c
+    * workspace has one buffer per block.
+    */
+   void computeFoldedProdValues(
+         const RealVector& vec,
+         Modulus fold,
+         RealVector& out,
+         Workspace& workspace
+         ) const
+   {
+      const Modulus n = modulus();
+      const Modulus sub = n / fold;
+      const size_t numBlocks = blocks().size();
+      RealVector& values = workspace.blockValues();
+
+      // threaded transforms, with the other loops split in blocks
+      for (size_t i = numBlocks; i-- > 0; ) {
+         if (sub % blocks()[i].modulus == 0 and fftw<Real>::is_threaded(blocks()[i].size))
+            convolveBlock(vec, fold, i, workspace, true);
+      }
+
+      // independent blocks
+      auto convolveSmallBlock = [&](size_t j) {
+         const size_t i = numBlocks - 1 - j;
+         if (sub % blocks()[i].modulus == 0 and not fftw<Real>::is_threaded(blocks()[i].size))
+            convolveBlock(vec, fold, i, workspace, false);
+      };
+      if (workspace.perBlock())
+         Parallel::forEachTask(numBlocks, convolveSmallBlock);
+      else
+         for (size_t j = 0; j < numBlocks; j++)
+            convolveSmallBlock(j);
+
+      // add the contributions of the divisors of each block, one prime factor
+      // at a time, from the smallest divisors up
+      for (const auto p : m_group.primes()) {
+         for (size_t i = 0; i < numBlocks; i++) {
+            const Modulus m = blocks()[i].modulus;
+            if (sub % m == 0 and m % p == 0)
+               addBlock(values, i, blockIndex(m / p));
+         }
+      }
+
+      // export by generator value
+      const Block& block = blocks()[blockIndex(sub)];
+      const bool unique = not Compression::symmetric() or m_group.symmetric();
+      Parallel::forEachBlock(block.size, [&](size_t begin, size_t end) {
+            UnitGroup::Cursor cursor(m_group, sub, begin);
+            for (size_t i = begin; i < end; i++, cursor.next()) {
+               const Modulus a = fold * cursor.value();
+               // with symmetric compression, a and n - a share their value
+               if (unique or 2 * a <= n)
+                  out[valueIndex(a)] = values[block.offset + i];
+            }
+            });
+   }
+
+   /**
+    * Correlates the values of \c vec for block \c index, folded modulo
+    * \f$n\f$ / \c fold, with the kernel values of this block, using the work
+    * buffer of this block, and stores the result into the work vector.
+    * If \c blocks is \c true, the element-wise loops are split in blocks
+    * processed concurrently.
+    */
+   void convolveBlock(
+         const RealVector& vec,
+         Modulus fold,
+         size_t index,
+         Workspace& workspace,
+         bool blocks
+         ) const
+   {
+      const Block& block = this->blocks()[index];
+      const Modulus n = modulus();
+      const Modulus sub = n / fold;
+      const Modulus stride = sub / block.modulus;
+      const FFTComplexVector& kernel = kernelFFT()[index];
+
+      FFTComplexVector& cvec = workspace.buffer(index);
+      Real* rvec = fftw<Real>::real_data(cvec);
+      RealVector& values = workspace.blockValues();
+
+      // copy the folded vector to the work buffer
+      forEachBlock(block.size, blocks, [&](size_t begin, size_t end) {
+            importBlock(block, begin, end, rvec, [&](Modulus v) {
+                  Real sum = 0.0;
+                  for (Modulus i = stride * v; i < n; i += sub)
+                     sum += vec[Compression::compressIndex(i, n)];
+                  return sum;
+                  });
+            });
+
+      if (block.dims.empty()) {
+         values[block.offset] = rvec[0] * kernel[0].real();
+         return;
+      }
+
+      fftw<Real>::fft_in_place(&cvec[0], block.dims);
+
+      // multiply in Fourier space: correlation rather than convolution
+      forEachBlock(Workspace::bufferSize(block), blocks, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+               cvec[i] = kernel[i] * std::conj(cvec[i]);
+            });
+
+      fftw<Real>::ifft_in_place(&cvec[0], block.dims, true);
+
+      // export to the work vector
+      forEachBlock(block.size, blocks, [&](size_t begin, size_t end) {
+            const size_t rowLength = block.dims.back();
+            const size_t paddedLength = 2 * (rowLength / 2 + 1);
+            for (size_t i = begin; i < end; i++)
+               values[block.offset + i] = rvec[i / rowLength * paddedLength + i % rowLength];
+            });
+   }
+
+   /**
+    * Stores \c value(v) for the units \f$v\f$ at indices \c begin to \c end -
+    * 1 of \c block into \c data, in the padded layout of the in-place
+    * multi-dimensional transforms.
+    */
+   template <class FUNC>
+   void importBlock(const Block& block, size_t begin, size_t end, Real* data, FUNC value) const
+   {
+      const size_t rowLength = block.dims.empty() ? 1 : block.dims.back();
+      const size_t paddedLength = 2 * (rowLength / 2 + 1);
+      UnitGroup::Cursor cursor(m_group, block.modulus, begin);
+      for (size_t i = begin; i < end; i++, cursor.next())
+         data[i / rowLength * paddedLength + i % rowLength] = value(cursor.value());
+   }
+
+   /**
+    * Adds to each value of block \c to the value of block \c from, whose
+    * divisor divides that of \c to, at the reduced exponents.
+    */
+   void addBlock(RealVector& values, size_t to, size_t from) const
+   {
+      const Block& dst = blocks()[to];
+      const Block& src = blocks()[from];
+      const size_t rank = dst.orders.size();
+
+      if (rank == 0) {
+         values[dst.offset] += values[src.offset];
+         return;
+      }
+
+      const size_t rowLength = dst.orders.back();
+      const size_t srcRowLength = src.orders.back();
+
+      Parallel::forEachBlock(dst.size, [&](size_t begin, size_t end) {
+            size_t i = begin;
+            while (i < end) {
+               // reduce the exponents of the current row
+               const size_t row = i / rowLength;
+               size_t srcRow = 0;
+               size_t stride = 1;
+               size_t r = row;
+               for (size_t k = rank - 1; k-- > 0; ) {
+                  srcRow += r % dst.orders[k] % src.orders[k] * stride;
+                  stride *= src.orders[k];
+                  r /= dst.orders[k];
+               }
+               Real* out = &values[dst.offset + row * rowLength];
+               const Real* in = &values[src.offset + srcRow * srcRowLength];
+               const size_t rowEnd = std::min(end - row * rowLength, rowLength);
+               size_t j = i % rowLength % srcRowLength;
+               for (size_t col = i % rowLength; col < rowEnd; col++) {
+                  out[col] += in[j];
+                  if (++j == srcRowLength)
+                     j = 0;
+               }
+               i = row * rowLength + rowEnd;
+            }
+            });
+   }
+
+   /**
+    * Calls \c func(begin, end) on blocks of indices covering the range from 0
+    * to \c size - 1, concurrently if \c blocks is \c true, or on the whole
+    * range otherwise.
+    */
+   template <class FUNC>
+   static void forEachBlock(size_t size, bool blocks, FUNC func)
+   {
+      if (blocks)
+         Parallel::forEachBlock(size, func);
+      else
+         func(size_t(0), size);
+   }
+
+public:
+   /**
+    * Sequence of inner product values.
+    *
+    * \tparam GENSEQ    Type of sequence of generator values.
+    */
+   template <class GENSEQ>
+   class Seq :
+      public BridgeSeq<
+         Seq<GENSEQ>,                           // self type
+         GENSEQ,                                // base type
+         MeritValue,                            // value type
+         BridgeIteratorCached> {
+
+   public:
+
+      typedef GENSEQ GenSeq;
+      typedef typename Seq::Base Base;
+      typedef typename Seq::size_type size_type;
+
+      /**
+       * Constructor.
+       *
+       * The vector of inner products is taken from the workspace of \c
+       * parent, and given back to it by the destructor.
+       *
+       * \param parent     Parent inner product instance.
+       * \param genSeq     Sequence of generator sequences that determines the
+       *                   order of the permutations of \c baseVec.
+       * \param vec        Second operand in the inner product.
+       */
+      template <class E>
+      Seq(
+            const CoordUniformInnerProdFast& parent,
+            GenSeq genSeq,
+            const boost::numeric::ublas::vector_expression<E>& vec
+            ):
+         Seq::BridgeSeq_(std::move(genSeq)),
+         m_parent(parent)
+      {
+         m_parent.m_workspace.takeOutput(m_values, m_parent.storage().size());
+         m_parent.computeProdValues(vec(), m_values, m_parent.cofactors(this->base()));
+      }
+
+      Seq(const Seq&) = default;
+      Seq(Seq&&) = default;
+
+      ~Seq()
+      { m_parent.m_workspace.keepOutput(m_values); }
+
+      /**
+       * Returns the parent inner product of this sequence.
+       */
+      const CoordUniformInnerProdFast& innerProd() const
+      { return m_parent; }
+
+      MeritValue element(const typename Base::const_iterator& it) const
+      { return m_values[m_parent.valueIndex(*it)]; }
+
+   private:
+      const CoordUniformInnerProdFast& m_parent;
+      RealVector m_values;
+   };
+
+   /**
+    * Creates a new sequence of inner product values by applying a stride
+    * permutation based on \c genSeq to the vector of kernel values, then by
+    * computing the inner product with \c vec.
+    *
+    * \param genSeq     Sequence of generator values.
+    * \param vec        Second operand in the inner product.
+    */
+   template <class GENSEQ, class E>
+   Seq<GENSEQ> prodSeq(
+         const GENSEQ& genSeq,
+         const boost::numeric::ublas::vector_expression<E>& vec
+         ) const
+   { return Seq<GENSEQ>(*this, genSeq, vec); }
+
+private:
+   std::vector<Block> computeBlocks() const
+   {
+      std::vector<Block> out;
+      size_t offset = 0;
+      for (const auto m : m_group.divisors()) {
+         Block block;
+         block.modulus = m;
+         block.offset = offset;
+         block.orders = m_group.orders(m);
+         block.size = 1;
+         for (const auto r : block.orders) {
+            block.size *= r;
+            if (r > 1)
+               block.dims.push_back(static_cast<int>(r));
+         }
+         offset += block.size;
+         out.push_back(std::move(block));
+      }
+      return out;
+   }
+
+   /**
+    * Computes the FFT's of the kernel values of each block.
+    */
+   std::vector<FFTComplexVector> computeKernelFFT() const
+   {
+      const Modulus n = modulus();
+      std::vector<FFTComplexVector> result;
+      for (const auto& block : blocks()) {
+         FFTComplexVector fvec(Workspace::bufferSize(block));
+         const Modulus stride = n / block.modulus;
+         importBlock(block, 0, block.size, fftw<Real>::real_data(fvec), [&](Modulus v) {
+               return m_kernelValues[Compression::compressIndex(stride * v, n)];
+               });
+         if (not block.dims.empty())
+            fftw<Real>::fft_in_place(&fvec[0], block.dims);
+         // the sum over a class of opposite units is twice the value for its
+         // representative
+         const Real ratio = m_group.classSize(block.modulus);
+         for (auto& x : fvec)
+            x *= ratio;
+         result.push_back(std::move(fvec));
+      }
+      return result;
+   }
+
+private:
+   InternalStorage m_storage;
+   RealVector m_kernelValues;
+   UnitGroup m_group;
+   std::vector<Block> m_blocks;
+   std::vector<FFTComplexVector> m_kernelFFT;
+   mutable Workspace m_workspace;
+};
+
+}}
+
+#endif
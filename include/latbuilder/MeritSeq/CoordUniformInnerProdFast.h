@@ -23,11 +23,13 @@
 #include "latbuilder/Storage.h"
 #include "latbuilder/CachedSeq.h"
 #include "latbuilder/IndexMap.h"
+#include "latbuilder/Parallel.h"
 #include "latbuilder/fftw++.h"
 
 #include <boost/numeric/ublas/expression_types.hpp>
 #include <boost/numeric/ublas/vector_proxy.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -48,9 +50,19 @@ namespace detail {
  * vector with a single vector.
  *
  * Implemented for integer powers of prime bases, as proposed in \cite rCOO06a .
+ * Ordinary lattices with a single level are handled by a specialization that
+ * accepts any number of points (see CoordUniformInnerProdFast-OLR.h).
+ * In base 2, without symmetric compression, each level of the matrix of
+ * kernel values consists of 2 circulant half-blocks instead of a single
+ * circulant block, because the group of units is not cyclic.
  *
  * Computes the inner product with a second vector for all vectors in the
  * sequence at once.
+ *
+ * When several threads are set with Parallel::setNumThreads() before
+ * construction, the independent levels are convolved concurrently, and the
+ * transforms of the largest levels use FFTW's threads if they are available
+ * (see fftw::set_planner_threads()).
  */
 template <LatticeType LR, EmbeddingType ET, Compress COMPRESS, PerLevelOrder PLO>
 class CoordUniformInnerProdFast {
@@ -81,9 +93,108 @@ public:
       m_internalStorage(asIntenalStorage(this->storage())),
       m_kernelValues(kernel.valuesVector(this->internalStorage())),
       m_levelRanges(cacheLevelRanges()),
-      m_circulantFFT(computeCirculantFFT())
+      m_halfBlockSizes(computeHalfBlockSizes()),
+      m_circulantFFT(computeCirculantFFT()),
+      m_workspace(levelRanges(), Parallel::numThreads() > 1)
    {}
 
+   /**
+    * Work buffers of the transforms computed by computeProdValues().
+    *
+    * The buffers are allocated once, with FFTW's allocator; the transforms
+    * are then performed in place, level by level, without allocating memory.
+    * A single buffer sized for the largest level is shared by all levels,
+    * unless the levels are to be convolved concurrently, in which case each
+    * level has its own buffer (about twice as much memory in base 2).
+    * The workspace also keeps the output vector of the last destroyed
+    * sequence of inner products, so that the next one reuses its storage.
+    * Threads computing inner products concurrently must use distinct
+    * workspaces.
+    */
+   class Workspace {
+   public:
+      /**
+       * Constructor.
+       *
+       * \param levelRanges   Per-level ranges of indices.
+       * \param perLevel      Whether each level has its own buffer.
+       */
+      explicit Workspace(
+            const std::vector<boost::numeric::ublas::range>& levelRanges = {},
+            bool perLevel = false
+            ):
+         m_perLevel(perLevel)
+      {
+         if (perLevel) {
+            for (const auto& range : levelRanges)
+               m_buffers.emplace_back(bufferSize(range.size()));
+         }
+         else {
+            size_t size = 0;
+            for (const auto& range : levelRanges)
+               size = std::max(size, range.size());
+            m_buffers.emplace_back(bufferSize(size));
+         }
+      }
+
+      /**
+       * Returns the number of complex values needed for a level of size \c
+       * levelSize: one transform of size \c levelSize or two transforms of
+       * size \c levelSize / 2.
+       */
+      static size_t bufferSize(size_t levelSize)
+      { return levelSize / 2 + 2; }
+
+      /**
+       * Returns whether each level has its own buffer.
+       */
+      bool perLevel() const
+      { return m_perLevel; }
+
+      /**
+       * Returns the buffer of level \c level, which holds either real or
+       * complex values.
+       */
+      FFTComplexVector& buffer(size_t level)
+      { return m_buffers[m_perLevel ? level : 0]; }
+
+      /**
+       * Moves the kept output vector into \c out and resizes it to \c size
+       * elements, which allocates memory only if its size changes.
+       */
+      void takeOutput(RealVector& out, size_t size)
+      {
+         out.swap(m_output);
+         if (out.size() != size)
+            out.resize(size, false);
+      }
+
+      /**
+       * Keeps the storage of \c out for the next call to takeOutput().
+       */
+      void keepOutput(RealVector& out)
+      {
+         if (out.size() > 0)
+            m_output.swap(out);
+      }
+
+   private:
+      bool m_perLevel;
+      std::vector<FFTComplexVector> m_buffers;
+      RealVector m_output;
+   };
+
+   /**
+    * Returns the size of the largest level.
+    */
+   size_t maxLevelSize() const
+   {
+      size_t size = 0;
+      for (const auto& range : levelRanges())
+         size = std::max(size, range.size());
+      return size;
+   }
+
    /**
     * Returns the storage configuration instance.
     */
@@ -111,10 +222,27 @@ public:
    /**
     * Returns the FFT's of the first column of each circulant submatrix in the
     * horizontal block-circulant matrix.
+    * For the levels made of 2 circulant half-blocks, the FFT's of both
+    * half-blocks are stored one after the other.
     */
    const std::vector<FFTComplexVector>& circulantFFT() const
    { return m_circulantFFT; }
 
+   /**
+    * Returns the size of the circulant half-blocks of level \c level, or 0 if
+    * the level is a single circulant block.
+    *
+    * In base 2, the group of units modulo \f$2^k\f$ is the direct product of
+    * \f$\{1, -1\}\f$ and of the cyclic group generated by the generator.
+    * Without symmetric compression, each level with at least 2 elements thus
+    * consists of 2 circulant half-blocks (see \cite rCOO06a ): the rows for the
+    * generators \f$g^j\f$ apply the first half-block to the first half of the
+    * level and the second half-block to the second half, and the rows for the
+    * generators \f$-g^j\f$ apply them the other way around.
+    */
+   size_t halfBlockSize(size_t level) const
+   { return m_halfBlockSizes[level]; }
+
 
 private:
    std::vector<boost::numeric::ublas::range> cacheLevelRanges() const
@@ -125,77 +253,237 @@ private:
       return out;
    }
 
-   template <class E>
-   RealVector computeProdValues(
-         const boost::numeric::ublas::vector_expression<E>& ve
-         ) const
+   std::vector<size_t> computeHalfBlockSizes() const
    {
+      std::vector<size_t> sizes(levelRanges().size(), 0);
       if(LR == LatticeType::ORDINARY){
-        // in base 2, on each level, we have 2 circulant half-blocks instead of
-        // a single circulant block
-        if (not internalStorage().symmetric() and internalStorage().sizeParam().base() == 2)
-           throw std::logic_error("not implemented for non-symmetric vectors in base 2");
-       }
+        if (not internalStorage().symmetric() and internalStorage().sizeParam().base() == 2) {
+           for (size_t level = 0; level < sizes.size(); level++) {
+              if (levelRanges()[level].size() >= 2)
+                 sizes[level] = levelRanges()[level].size() / 2;
+           }
+        }
+      }
+      return sizes;
+   }
 
-      const auto& vec = ve();
-      using namespace boost::numeric::ublas;
+   /**
+    * Returns the position, in the range of level \c level, of the inner
+    * product for the generator at index \c row of the sequence of generators.
+    */
+   size_t levelIndex(size_t row, size_t level) const
+   {
+      const size_t half = halfBlockSize(level);
+      if (half == 0)
+         return row % levelRanges()[level].size();
+      // the second half of the sequence of generators consists of the
+      // opposites of the first half
+      return (row >= levelRanges().back().size() / 2 ? half : 0) + row % half;
+   }
 
-      auto itRange = levelRanges().begin();
-      auto itRangePrev = itRange;
-      auto itCirculantFFT = circulantFFT().begin();
+   /**
+    * Returns the index of a generator whose inner product is stored at
+    * position \c index in the range of level \c level.
+    */
+   size_t levelRow(size_t index, size_t level) const
+   {
+      const size_t half = halfBlockSize(level);
+      if (half == 0 or index < half)
+         return index;
+      return levelRanges().back().size() / 2 + (index - half);
+   }
 
-      RealVector out(vec.size());
+   /**
+    * Computes the inner products of \c ve with all the vectors of the
+    * sequence, using the work buffers of \c workspace, and stores them into
+    * \c out, which must have the same size as \c ve.
+    *
+    * Each level is first convolved with its circulant block; the levels
+    * whose transforms use FFTW's threads are processed one after the other,
+    * and the other ones concurrently, largest first, if \c workspace has one
+    * buffer per level.  The contributions of the lower levels are then added,
+    * level by level.
+    */
+   template <class E>
+   void computeProdValues(
+         const boost::numeric::ublas::vector_expression<E>& ve,
+         RealVector& out,
+         Workspace& workspace
+         ) const
+   {
+      const RealVector& vec = ve();
+      using namespace boost::numeric::ublas;
 
-      while (itRange != levelRanges().end()) {
+      const size_t numLevels = levelRanges().size();
 
-         if (itCirculantFFT == circulantFFT().end())
-            throw std::logic_error("circulant FFT's have too few levels");
+      if (circulantFFT().size() < numLevels)
+         throw std::logic_error("circulant FFT's have too few levels");
 
-         // select vector range
-         vector_range<const RealVector> subvec(vec, *itRange);
+      for (size_t level = 0; level < numLevels; level++) {
+         if (workspace.buffer(level).size() < Workspace::bufferSize(levelRanges()[level].size()))
+            throw std::logic_error("workspace is too small for the largest level");
+      }
 
-         // convert to FFT-compatible vectors
-         FFTRealVector rvec(subvec.begin(), subvec.end());
+      // threaded transforms, with the other loops split in blocks
+      for (size_t level = numLevels; level-- > 0; ) {
+         if (fftw<Real>::is_threaded(levelRanges()[level].size()))
+            convolveLevel(vec, out, level, workspace, true);
+      }
 
-         // compute FFT
-         FFTComplexVector cvec = fftw<Real>::fft(rvec);
-
-         // ratio of the number or natural elements to the number of internal
-         // elements, multiplied by normalization
-         size_t compressionRatio = 1;
-         if(LR == LatticeType::ORDINARY){
-           if (internalStorage().symmetric() and (itRange - levelRanges().begin()) >= (internalStorage().sizeParam().base() == 2 ? 2 : 1)) {
-              // compressionRatio except if uncompressed level has only one element
-              compressionRatio = 2;
-           }
+      // independent levels
+      auto convolveSmallLevel = [&](size_t i) {
+         const size_t level = numLevels - 1 - i;
+         if (not fftw<Real>::is_threaded(levelRanges()[level].size()))
+            convolveLevel(vec, out, level, workspace, false);
+      };
+      if (workspace.perLevel())
+         Parallel::forEachTask(numLevels, convolveSmallLevel);
+      else
+         for (size_t i = 0; i < numLevels; i++)
+            convolveSmallLevel(i);
+
+      // add contributions from lower levels
+      for (size_t level = 1; level < numLevels; level++) {
+         vector_range<RealVector> curLevel(out, levelRanges()[level]);
+         vector_range<const RealVector> prevLevel(out, levelRanges()[level - 1]);
+         const size_t prevSize = prevLevel.size();
+         if (halfBlockSize(level) == 0 and halfBlockSize(level - 1) == 0) {
+            Parallel::forEachBlock(curLevel.size(), [&](size_t begin, size_t end) {
+                  for (size_t i = begin; i < end; i++)
+                     curLevel[i] += prevLevel[i % prevSize];
+                  });
          }
+         else {
+            Parallel::forEachBlock(curLevel.size(), [&](size_t begin, size_t end) {
+                  for (size_t i = begin; i < end; i++)
+                     curLevel[i] += prevLevel[levelIndex(levelRow(i, level), level - 1)];
+                  });
+         }
+      }
+   }
 
-         // multiply in Fourier space
-         for (size_t i = 0; i < cvec.size(); i++)
-            cvec[i] *= compressionRatio * (*itCirculantFFT)[i];
+   /**
+    * Same as above, using the workspace of this instance.
+    */
+   template <class E>
+   void computeProdValues(
+         const boost::numeric::ublas::vector_expression<E>& ve,
+         RealVector& out
+         ) const
+   { computeProdValues(ve, out, m_workspace); }
 
-         // inverse transform
-         fftw<Real>::ifft(cvec, rvec, true);
+   /**
+    * Convolves the vector range of \c vec for level \c level with the
+    * circulant block of this level, using the work buffer of this level, and
+    * stores the result into the same range of \c out.
+    * If \c blocks is \c true, the element-wise loops are split in blocks
+    * processed concurrently.
+    */
+   void convolveLevel(
+         const RealVector& vec,
+         RealVector& out,
+         size_t level,
+         Workspace& workspace,
+         bool blocks
+         ) const
+   {
+      using namespace boost::numeric::ublas;
 
-         // export to the output vector
-         std::copy(rvec.begin(), rvec.end(), &out[itRange->start()]);
+      const auto& range = levelRanges()[level];
+      const size_t levelSize = range.size();
+      const FFTComplexVector& circulant = circulantFFT()[level];
+
+      FFTComplexVector& cvec = workspace.buffer(level);
+      Real* rvec = fftw<Real>::real_data(cvec);
+
+      vector_range<const RealVector> subvec(vec, range);
+
+      const size_t half = halfBlockSize(level);
+      if (half > 0) {
+         // transform both halves of the level, then multiply each of them
+         // with both half-blocks
+         typedef typename fftw<Real>::complex Complex;
+         const size_t fftSize = half / 2 + 1;
+         Complex* fa = &cvec[0];
+         Complex* fb = fa + fftSize;
+         Real* ra = reinterpret_cast<Real*>(fa);
+         Real* rb = reinterpret_cast<Real*>(fb);
+         const Complex* ka = &circulant[0];
+         const Complex* kb = ka + fftSize;
+
+         forEachBlock(half, blocks, [&](size_t begin, size_t end) {
+               std::copy(subvec.begin() + begin, subvec.begin() + end, ra + begin);
+               std::copy(subvec.begin() + half + begin, subvec.begin() + half + end, rb + begin);
+               });
+
+         fftw<Real>::fft_in_place(fa, half);
+         fftw<Real>::fft_in_place(fb, half);
+
+         // rows for g^j in the first half, rows for -g^j in the second half
+         forEachBlock(fftSize, blocks, [&](size_t begin, size_t end) {
+               for (size_t i = begin; i < end; i++) {
+                  const Complex a = fa[i];
+                  const Complex b = fb[i];
+                  fa[i] = a * ka[i] + b * kb[i];
+                  fb[i] = a * kb[i] + b * ka[i];
+               }
+               });
+
+         fftw<Real>::ifft_in_place(fa, half, true);
+         fftw<Real>::ifft_in_place(fb, half, true);
+
+         forEachBlock(half, blocks, [&](size_t begin, size_t end) {
+               std::copy(ra + begin, ra + end, &out[range.start()] + begin);
+               std::copy(rb + begin, rb + end, &out[range.start()] + half + begin);
+               });
+         return;
+      }
 
-         // add contributions from lower levels
-         if (itRange != itRangePrev) {
-            typedef typename vector_range<RealVector>::size_type size_type;
-            vector_range<RealVector> curLevel(out, *itRange);
-            vector_range<const RealVector> prevLevel(out, *itRangePrev);
-            for (size_type i = 0; i < curLevel.size(); i++)
-               curLevel[i] += prevLevel[i % prevLevel.size()];
-         }
+      // copy the vector range to the work buffer
+      forEachBlock(levelSize, blocks, [&](size_t begin, size_t end) {
+            std::copy(subvec.begin() + begin, subvec.begin() + end, rvec + begin);
+            });
 
-         itRangePrev = itRange;
+      // compute FFT
+      fftw<Real>::fft_in_place(cvec, levelSize);
 
-         ++itCirculantFFT;
-         ++itRange;
+      // ratio of the number or natural elements to the number of internal
+      // elements, multiplied by normalization
+      size_t compressionRatio = 1;
+      if(LR == LatticeType::ORDINARY){
+        if (internalStorage().symmetric() and level >= (internalStorage().sizeParam().base() == 2 ? 2 : 1)) {
+           // compressionRatio except if uncompressed level has only one element
+           compressionRatio = 2;
+        }
       }
 
-      return out;
+      // multiply in Fourier space
+      forEachBlock(levelSize / 2 + 1, blocks, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+               cvec[i] *= compressionRatio * circulant[i];
+            });
+
+      // inverse transform
+      fftw<Real>::ifft_in_place(cvec, levelSize, true);
+
+      // export to the output vector
+      forEachBlock(levelSize, blocks, [&](size_t begin, size_t end) {
+            std::copy(rvec + begin, rvec + end, &out[range.start()] + begin);
+            });
+   }
+
+   /**
+    * Calls \c func(begin, end) on blocks of indices covering the range from 0
+    * to \c size - 1, concurrently if \c blocks is \c true, or on the whole
+    * range otherwise.
+    */
+   template <class FUNC>
+   static void forEachBlock(size_t size, bool blocks, FUNC func)
+   {
+      if (blocks)
+         Parallel::forEachBlock(size, func);
+      else
+         func(size_t(0), size);
    }
 
 public:
@@ -225,6 +513,9 @@ public:
       /**
        * Constructor.
        *
+       * The vector of inner products is taken from the workspace of \c
+       * parent, and given back to it by the destructor.
+       *
        * \param parent     Parent inner product instance.
        * \param genSeq     Sequence of generator sequences that determines the
        *                   order of the permutations of \c baseVec.
@@ -237,9 +528,17 @@ public:
             const boost::numeric::ublas::vector_expression<E>& vec
             ):
          Seq::BridgeSeq_(std::move(genSeq)),
-         m_parent(parent),
-         m_values(parent.computeProdValues(vec()))
-      {}
+         m_parent(parent)
+      {
+         m_parent.m_workspace.takeOutput(m_values, vec().size());
+         m_parent.computeProdValues(vec(), m_values);
+      }
+
+      Seq(const Seq&) = default;
+      Seq(Seq&&) = default;
+
+      ~Seq()
+      { m_parent.m_workspace.keepOutput(m_values); }
 
       /**
        * Returns the parent inner product of this sequence.
@@ -249,29 +548,55 @@ public:
 
       MeritValue element(const typename Base::const_iterator& it) const
       {
-         RealVector mlMerit(m_parent.levelRanges().size());
-         for (
-               auto itRange = m_parent.levelRanges().begin();
-               itRange != m_parent.levelRanges().end();
-               ++itRange
-               ) {
-            boost::numeric::ublas::vector_range<const RealVector> curLevel(m_values, *itRange);
-            mlMerit[itRange - m_parent.levelRanges().begin()] = curLevel[(it - it.seq().begin()) % curLevel.size()];
-         }
-
          MeritValue merit = m_parent.storage().createMeritValue(0.0);
-         return storeMeritValue(merit, std::move(mlMerit));
+         storeElement(it, merit);
+         return merit;
       }
 
+      /**
+       * Stores the merit value of the element pointed to by \c it into \c
+       * merit.
+       *
+       * Unlike element(), no memory is allocated once \c merit has one
+       * element per level, which is the case after the first call with a
+       * given RealVector.  BridgeIteratorCached uses this function to update
+       * its cached value in place.
+       */
+      void storeElement(const typename Base::const_iterator& it, Real& merit) const
+      { merit = levelValue(it - it.seq().begin(), m_parent.levelRanges().size() - 1); }
+
+      void storeElement(const typename Base::const_iterator& it, RealVector& merit) const
+      {
+         if (merit.size() != m_parent.levelRanges().size())
+            merit.resize(m_parent.levelRanges().size(), false);
+         storeLevelValues(it - it.seq().begin(), merit);
+      }
+
+      /**
+       * Stores the per-level merit values of the element pointed to by \c it
+       * into the caller-supplied view \c merit, which must have one element
+       * per level.
+       */
+      template <class V>
+      void storeElement(const typename Base::const_iterator& it, boost::numeric::ublas::vector_range<V>& merit) const
+      { storeLevelValues(it - it.seq().begin(), merit); }
+
    private:
       const CoordUniformInnerProdFast& m_parent;
       RealVector m_values;
 
-      Real& storeMeritValue(Real& dest, const RealVector& src) const
-      { return dest = src(src.size() - 1); }
+      Real levelValue(size_t index, size_t level) const
+      {
+         const auto& range = m_parent.levelRanges()[level];
+         return m_values[range.start() + m_parent.levelIndex(index, level)];
+      }
 
-      RealVector& storeMeritValue(RealVector& dest, RealVector src) const
-      { return dest = std::move(src); }
+      template <class V>
+      void storeLevelValues(size_t index, V& merit) const
+      {
+         for (size_t level = 0; level < m_parent.levelRanges().size(); level++)
+            merit[level] = levelValue(index, level);
+      }
    };
 
    /**
@@ -308,6 +633,26 @@ private:
             ++itRange
             ) {
 
+         const size_t level = itRange - ranges.begin();
+         const size_t half = halfBlockSize(level);
+
+         if (half > 0) {
+            // FFT's of both half-blocks, one after the other
+            FFTComplexVector& fvec = result[level];
+            fvec.reserve(2 * (half / 2 + 1));
+            for (size_t start = itRange->start(); start < itRange->start() + itRange->size(); start += half) {
+               boost::numeric::ublas::vector_range<const RealVector> lvec(
+                     kernelValues(),
+                     boost::numeric::ublas::range(start, start + half)
+                     );
+               const auto tvec = circulantTranspose(lvec);
+               FFTRealVector rvec(tvec.begin(), tvec.begin() + tvec.size());
+               const auto hvec = fftw<Real>::fft(rvec);
+               fvec.insert(fvec.end(), hvec.begin(), hvec.end());
+            }
+            continue;
+         }
+
          // select level
          boost::numeric::ublas::vector_range<const RealVector> lvec(
                kernelValues(),
@@ -321,7 +666,7 @@ private:
          FFTRealVector rvec(tvec.begin(), tvec.begin() + tvec.size());
 
          // compute FFT
-         result[itRange - ranges.begin()] =
+         result[level] =
             fftw<Real>::fft(rvec);
       }
 
@@ -364,10 +709,14 @@ private:
    InternalStorage m_internalStorage;
    RealVector m_kernelValues;
    std::vector<boost::numeric::ublas::range> m_levelRanges;
+   std::vector<size_t> m_halfBlockSizes;
    std::vector<FFTComplexVector> m_circulantFFT;
+   mutable Workspace m_workspace;
 };
 
 
 }}
 
+#include "latbuilder/MeritSeq/CoordUniformInnerProdFast-OLR.h"
+
 #endif
@@ -19,6 +19,7 @@
 
 #include "latbuilder/Types.h"
 #include "latbuilder/Storage.h"
+#include "latbuilder/Parallel.h"
 
 #include <memory>
 
@@ -94,6 +95,25 @@ public:
     */
    virtual std::unique_ptr<CoordUniformState> clone() const = 0;
 
+protected:
+   /**
+    * Calls \c func(begin, end) on contiguous blocks of indices covering the
+    * state vectors, concurrently when several threads are set with
+    * Parallel::setNumThreads().
+    *
+    * The blocks of polynomial lattices are processed sequentially: their
+    * strided kernel values are computed with NTL arithmetic, which is not
+    * assumed to be thread-safe.
+    */
+   template <class FUNC>
+   void forEachBlock(FUNC func) const
+   {
+      if (LR == LatticeType::ORDINARY)
+         Parallel::forEachBlock(storage().size(), func);
+      else
+         func(size_t(0), storage().size());
+   }
+
 private:
    Storage<LR, ET, COMPRESS, PLO> m_storage;
    Dimension m_dimension;
@@ -0,0 +1,143 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file
+ * Thread settings and parallel loops of the fast CBC construction.
+ */
+
+#ifndef LATBUILDER__PARALLEL_H
+#define LATBUILDER__PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace LatBuilder { namespace Parallel {
+
+/**
+ * Minimal number of vector elements processed by each thread in
+ * forEachBlock(), so that short vectors are not split.
+ */
+constexpr size_t minBlockSize = 1 << 14;
+
+namespace detail {
+   inline std::atomic<unsigned int>& numThreads()
+   {
+      static std::atomic<unsigned int> n(1);
+      return n;
+   }
+}
+
+/**
+ * Returns the number of threads used by the fast CBC construction (default:
+ * 1).
+ */
+inline unsigned int numThreads()
+{ return detail::numThreads().load(std::memory_order_relaxed); }
+
+/**
+ * Sets the number of threads used by the fast CBC construction.
+ * If \c n is 0, the number of hardware threads is used.
+ */
+inline void setNumThreads(unsigned int n)
+{
+   if (n == 0)
+      n = std::max(1u, std::thread::hardware_concurrency());
+   detail::numThreads().store(n, std::memory_order_relaxed);
+}
+
+/**
+ * Calls \c func(t) for every thread index \c t between 0 and \c nThreads - 1,
+ * concurrently.  Index 0 runs on the calling thread.  The first exception
+ * thrown by \c func is rethrown once all the threads have finished.
+ */
+template <class FUNC>
+void forEachThread(unsigned int nThreads, FUNC func)
+{
+   std::vector<std::exception_ptr> errors(nThreads);
+   auto work = [&](unsigned int t)
+   {
+      try {
+         func(t);
+      }
+      catch (...) {
+         errors[t] = std::current_exception();
+      }
+   };
+
+   std::vector<std::thread> threads;
+   for (unsigned int t = 1; t < nThreads; t++)
+      threads.emplace_back(work, t);
+   work(0);
+   for (auto& thread : threads)
+      thread.join();
+   for (const auto& error : errors)
+      if (error)
+         std::rethrow_exception(error);
+}
+
+/**
+ * Calls \c func(i) for every task index \c i between 0 and \c nTasks - 1,
+ * using at most numThreads() threads.  The tasks are handed out dynamically,
+ * in increasing order of their indices, so that the longest tasks should come
+ * first.
+ */
+template <class FUNC>
+void forEachTask(size_t nTasks, FUNC func)
+{
+   const unsigned int nThreads = (unsigned int) std::min<size_t>(numThreads(), nTasks);
+   if (nThreads <= 1) {
+      for (size_t i = 0; i < nTasks; i++)
+         func(i);
+      return;
+   }
+   std::atomic<size_t> next(0);
+   forEachThread(nThreads, [&](unsigned int) {
+         for (size_t i = next++; i < nTasks; i = next++)
+            func(i);
+         });
+}
+
+/**
+ * Calls \c func(begin, end) on contiguous blocks of indices covering the
+ * range from 0 to \c size - 1, one block per thread.
+ * Vectors shorter than numThreads() times \c minBlock are split in fewer
+ * blocks.
+ */
+template <class FUNC>
+void forEachBlock(size_t size, FUNC func, size_t minBlock = minBlockSize)
+{
+   const unsigned int nThreads = (unsigned int) std::max<size_t>(1,
+         std::min<size_t>(numThreads(), size / std::max<size_t>(1, minBlock)));
+   if (nThreads <= 1) {
+      func(size_t(0), size);
+      return;
+   }
+   const size_t blockSize = (size + nThreads - 1) / nThreads;
+   forEachThread(nThreads, [&](unsigned int t) {
+         const size_t begin = std::min(t * blockSize, size);
+         const size_t end = std::min(begin + blockSize, size);
+         func(begin, end);
+         });
+}
+
+}}
+
+#endif
@@ -23,6 +23,7 @@
 #include "latbuilder/CoordUniformFigureOfMerit.h"
 #include "latbuilder/MeritSeq/CoordUniformInnerProdFast.h"
 #include "latbuilder/GenSeq/CyclicGroup.h"
+#include "latbuilder/GenSeq/Units.h"
 #include "latbuilder/GenSeq/VectorCreator.h"
 #include "latbuilder/Util.h"
 
@@ -31,6 +32,22 @@ namespace LatBuilder { namespace Task {
 template <LatticeType LR, EmbeddingType ET, Compress COMPRESS, PerLevelOrder PLO, class FIGURE>
 struct FastCBCTag {};
 
+namespace detail {
+   /**
+    * Sequence of generator values explored by the fast CBC: the cyclic group of
+    * units, or, for ordinary lattices with a single level, for which the number
+    * of points need not be a prime power, the cyclic group of units when it
+    * exists and the units in the order of GenSeq::GeneratingValues otherwise.
+    */
+   template <LatticeType LR, EmbeddingType ET, Compress COMPRESS>
+   struct FastCBCGenSeq
+   { typedef GenSeq::CyclicGroup<LR, COMPRESS> Type; };
+
+   template <Compress COMPRESS>
+   struct FastCBCGenSeq<LatticeType::ORDINARY, EmbeddingType::UNILEVEL, COMPRESS>
+   { typedef GenSeq::Units<COMPRESS> Type; };
+}
+
 
 /// Fast CBC exploration.
 template <LatticeType LR, EmbeddingType ET, Compress COMPRESS, PerLevelOrder PLO, class FIGURE> using FastCBC =
@@ -54,7 +71,7 @@ struct CBCBasedSearchTraits<FastCBCTag<LR, ET, COMPRESS, PLO, CoordUniformFigure
    typedef typename LatBuilder::Storage<LR, ET, COMPRESS, PLO>::SizeParam SizeParam;
    typedef MeritSeq::CoordUniformCBC<LR, ET, COMPRESS, PLO, KERNEL, MeritSeq::CoordUniformInnerProdFast> CBC;
    typedef typename CBC::FigureOfMerit FigureOfMerit;
-   typedef GenSeq::CyclicGroup<LR, COMPRESS> GenSeqType;
+   typedef typename detail::FastCBCGenSeq<LR, ET, COMPRESS>::Type GenSeqType;
 
    std::vector<GenSeqType> genSeqs(const SizeParam& sizeParam, Dimension dimension) const
    {
@@ -78,7 +95,7 @@ struct CBCBasedSearchTraits<FastCBCTag<LR, ET, COMPRESS, PLO, FIGURE>> {
    typedef FIGURE FigureOfMerit;
    typedef typename LatBuilder::Storage<LR, ET, COMPRESS, PLO>::SizeParam SizeParam;
    typedef typename CBCSelector<LR, ET, COMPRESS, PLO, FIGURE>::CBC CBC;
-   typedef GenSeq::CyclicGroup<LR, COMPRESS> GenSeqType;
+   typedef typename detail::FastCBCGenSeq<LR, ET, COMPRESS>::Type GenSeqType;
 
    virtual ~CBCBasedSearchTraits() {}
 
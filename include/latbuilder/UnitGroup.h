@@ -0,0 +1,186 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LATBUILDER__UNIT_GROUP_H
+#define LATBUILDER__UNIT_GROUP_H
+
+#include "latbuilder/Types.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace LatBuilder {
+
+/**
+ * Decomposition of the group of units modulo \f$n\f$ into a direct product of
+ * cyclic groups.
+ *
+ * By the Chinese remainder theorem, the group of units modulo \f$n = \prod_p
+ * p^{e_p}\f$ is the direct product of the groups of units modulo the prime
+ * powers \f$p^{e_p}\f$.  Each of them is cyclic for odd \f$p\f$, and the group
+ * of units modulo \f$2^e\f$ is the direct product of \f$\{1, -1\}\f$ and of the
+ * cyclic group generated by 5.  Each cyclic component has a generator modulo
+ * \f$n\f$, congruent to 1 modulo the other prime powers.
+ *
+ * The generators are chosen such that their residues modulo any divisor
+ * \f$m\f$ of \f$n\f$ generate the group of units modulo \f$m\f$, with the same
+ * components, possibly of order 1.  Hence, an element with exponents
+ * \f$(x_1, \dots, x_r)\f$ modulo \f$n\f$ reduces to the element with exponents
+ * \f$(x_1 \bmod r_1, \dots, x_r \bmod r_r)\f$ modulo \f$m\f$, where \f$r_k\f$
+ * is the order of the \f$k\f$-th generator modulo \f$m\f$.
+ *
+ * The elements are indexed in row-major order of their exponents.  The
+ * components are sorted by increasing order modulo \f$n\f$, so that the
+ * exponent of the largest component varies fastest.
+ *
+ * With symmetric compression, the opposite units \f$a\f$ and \f$-a\f$ can
+ * be identified when \f$-1\f$ is a power of a single generator, i.e., when
+ * \f$n\f$ is \f$p^e\f$, \f$2 p^e\f$ or \f$2^e\f$: the order of this
+ * generator is then halved modulo every divisor \f$m > 2\f$ of \f$n\f$, and
+ * the elements are representatives of the classes \f$\{a, -a\}\f$.
+ */
+class UnitGroup {
+public:
+   typedef uInteger Modulus;
+
+   /**
+    * Constructor.
+    *
+    * \param modulus    Modulus \f$n\f$.
+    * \param symmetric  Whether to identify the opposite units, if possible.
+    */
+   explicit UnitGroup(Modulus modulus, bool symmetric = false);
+
+   /**
+    * Returns the modulus \f$n\f$.
+    */
+   Modulus modulus() const
+   { return m_modulus; }
+
+   /**
+    * Returns \c true if the opposite units are identified.
+    */
+   bool symmetric() const
+   { return m_symmetric; }
+
+   /**
+    * Returns the number of units modulo the divisor \c m of \f$n\f$ in each
+    * class of identified units: 2 if the opposite units are identified and
+    * distinct, and 1 otherwise.
+    */
+   size_t classSize(Modulus m) const
+   { return symmetric() and m > 2 ? 2 : 1; }
+
+   /**
+    * Returns the number of cyclic components.
+    */
+   size_t rank() const
+   { return m_components.size(); }
+
+   /**
+    * Returns the generators of the cyclic components, modulo \f$n\f$.
+    */
+   std::vector<Modulus> generators() const;
+
+   /**
+    * Returns the divisors of \f$n\f$, in increasing order.
+    */
+   const std::vector<Modulus>& divisors() const
+   { return m_divisors; }
+
+   /**
+    * Returns the distinct prime factors of \f$n\f$, in increasing order.
+    */
+   const std::vector<Modulus>& primes() const
+   { return m_primes; }
+
+   /**
+    * Returns the order of the generator of each component modulo the divisor
+    * \c m of \f$n\f$.
+    */
+   std::vector<size_t> orders(Modulus m) const;
+
+   /**
+    * Returns the number of units (or of classes of identified units) modulo
+    * the divisor \c m of \f$n\f$.
+    */
+   size_t size(Modulus m) const;
+
+   /**
+    * Returns the unit modulo the divisor \c m of \f$n\f$ at index \c index.
+    */
+   Modulus element(Modulus m, size_t index) const;
+
+   /**
+    * Cursor over the units modulo a divisor of \f$n\f$, in the order of their
+    * indices.
+    *
+    * Moving to the next unit takes an amortized constant number of modular
+    * multiplications.
+    */
+   class Cursor {
+   public:
+      /**
+       * Constructor.
+       *
+       * \param group      Group of units modulo \f$n\f$.
+       * \param m          Divisor of \f$n\f$.
+       * \param index      Index of the first unit.
+       */
+      Cursor(const UnitGroup& group, Modulus m, size_t index = 0);
+
+      /**
+       * Returns the current unit.
+       */
+      Modulus value() const
+      { return m_partial.empty() ? 1 % m_modulus : m_partial.back(); }
+
+      /**
+       * Moves to the next unit.
+       */
+      void next();
+
+   private:
+      Modulus m_modulus;
+      std::vector<Modulus> m_generators;
+      std::vector<size_t> m_orders;
+      std::vector<size_t> m_exponents;
+      // products of the powers of the generators up to each component
+      std::vector<Modulus> m_partial;
+   };
+
+private:
+   struct Component {
+      Modulus prime;
+      // the component {1, -1} of the units modulo a power of 2
+      bool sign;
+      Modulus generator;
+      // whether -1 is a power of the generator
+      bool opposite;
+   };
+
+   Modulus m_modulus;
+   bool m_symmetric;
+   std::vector<Modulus> m_primes;
+   std::vector<Modulus> m_divisors;
+   std::vector<Component> m_components;
+
+   size_t order(const Component& component, Modulus m) const;
+};
+
+}
+
+#endif
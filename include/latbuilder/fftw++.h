@@ -30,11 +30,29 @@
 
 #include <stdexcept>
 #include <complex>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
 #include <fftw3.h>
 
 
 /**
- * Wrapper for a subset of FFTW: FFT's for real functions in one dimension.
+ * Wrapper for a subset of FFTW: FFT's for real functions in one dimension, and
+ * in several dimensions in place.
+ *
+ * The plans are created once for each size, direction and alignment of the
+ * arrays, and are kept in a process-wide cache.  Hence, the plans can be
+ * created with planner flags more expensive than \c FFTW_ESTIMATE (see
+ * set_planner_flags()), and the planning time can be saved across runs by
+ * importing and exporting FFTW wisdom (see import_wisdom() and
+ * export_wisdom()).
+ *
+ * If the library is compiled with \c HAVE_FFTW_THREADS defined (and linked
+ * with \c fftw3_threads), the plans of the transforms of size at least
+ * threaded_size() are created with FFTW's threaded planner (see
+ * set_planner_threads()).
  */
 template <typename T>
 struct fftw
@@ -101,6 +119,114 @@ struct fftw
    typedef std::vector<complex, allocator<complex> > complex_vector;
 #endif
 
+   /**
+    * Sets the planner flags used to create new plans, e.g., \c FFTW_MEASURE or
+    * \c FFTW_PATIENT (default: \c FFTW_ESTIMATE).
+    * The plans created with the previous flags are discarded.
+    * Planning with flags other than \c FFTW_ESTIMATE takes time, which is
+    * paid once per size of transform thanks to the plan cache.
+    */
+   static void set_planner_flags(unsigned flags)
+   {
+      auto& c = cache();
+      std::lock_guard<std::mutex> lock(c.mutex);
+      c.clear();
+      c.flags = flags;
+   }
+
+   /**
+    * Returns the planner flags used to create new plans.
+    */
+   static unsigned planner_flags()
+   {
+      auto& c = cache();
+      std::lock_guard<std::mutex> lock(c.mutex);
+      return c.flags;
+   }
+
+   /**
+    * Sets the number of threads used by the plans of the transforms of size at
+    * least threaded_size() (default: 1).
+    * The plans created with the previous number of threads are discarded.
+    * Returns \c false if FFTW's threads are not available, in which case all
+    * the plans are single-threaded.
+    */
+   static bool set_planner_threads(int threads)
+   {
+#ifdef HAVE_FFTW_THREADS
+      auto& c = cache();
+      std::lock_guard<std::mutex> lock(c.mutex);
+      if (!c.threads_initialized) {
+         if (!c_api::init_threads())
+            return false;
+         c.threads_initialized = true;
+      }
+      c.clear();
+      c.threads = threads < 1 ? 1 : threads;
+      return true;
+#else
+      return threads <= 1;
+#endif
+   }
+
+   /**
+    * Returns the number of threads used by the plans of the transforms of
+    * size at least threaded_size().
+    */
+   static int planner_threads()
+   {
+      auto& c = cache();
+      std::lock_guard<std::mutex> lock(c.mutex);
+      return c.threads;
+   }
+
+   /**
+    * Returns the minimal size of the transforms planned with several threads.
+    * Smaller transforms do not gain from threads.
+    */
+   static constexpr size_t threaded_size()
+   { return size_t(1) << 16; }
+
+   /**
+    * Returns \c true if the transforms of size \c n are executed with several
+    * threads.
+    */
+   static bool is_threaded(size_t n)
+   { return n >= threaded_size() and planner_threads() > 1; }
+
+   /**
+    * Discards the cached plans.
+    */
+   static void forget_plans()
+   {
+      auto& c = cache();
+      std::lock_guard<std::mutex> lock(c.mutex);
+      c.clear();
+   }
+
+   /**
+    * Imports FFTW wisdom from the file named \c filename, so that the plans
+    * accumulated in a previous run are created without measurements.
+    * Returns \c false if the file cannot be read.
+    */
+   static bool import_wisdom(const std::string& filename)
+   {
+      auto& c = cache();
+      std::lock_guard<std::mutex> lock(c.mutex);
+      return c_api::import_wisdom_from_filename(filename.c_str()) != 0;
+   }
+
+   /**
+    * Exports the FFTW wisdom accumulated so far to the file named \c filename.
+    * Returns \c false if the file cannot be written.
+    */
+   static bool export_wisdom(const std::string& filename)
+   {
+      auto& c = cache();
+      std::lock_guard<std::mutex> lock(c.mutex);
+      return c_api::export_wisdom_to_filename(filename.c_str()) != 0;
+   }
+
    /**
     * Computes the real-to-complex Fourier transform of \c v into \c result.
     * The size of the transform is that of the real component.
@@ -113,13 +239,10 @@ struct fftw
       if (result.size() < fft_size(v))
          throw std::invalid_argument("fftw::fft(): result must have size v.size() / 2 + 1");
       // the transform is performed out-of-place, hence the const_cast is safe
-      typename c_api::plan p = c_api::plan_dft_r2c_1d(
-            static_cast<int>(v.size()),
-            const_cast<typename real_vector::value_type*>(&v[0]),
-            &result[0],
-            FFTW_ESTIMATE);
-      c_api::execute(p);
-      c_api::destroy_plan(p);
+      real* in = const_cast<typename real_vector::value_type*>(&v[0]);
+      typename c_api::plan p = cache().get(static_cast<int>(v.size()), true, false,
+            c_api::alignment_of(in), c_api::alignment_of(reinterpret_cast<real*>(&result[0])));
+      c_api::execute_dft_r2c(p, in, &result[0]);
       return result;
    }
 
@@ -162,13 +285,10 @@ struct fftw
       if (v.size() < fft_size(result))
          throw std::invalid_argument("fftw::ifft(): v must have size result.size() / 2 + 1");
       // the transform is performed out-of-place, hence the const_cast is safe
-      typename c_api::plan p = c_api::plan_dft_c2r_1d(
-            static_cast<int>(result.size()),
-            const_cast<typename complex_vector::value_type*>(&v[0]),
-            &result[0],
-            FFTW_ESTIMATE);
-      c_api::execute(p);
-      c_api::destroy_plan(p);
+      complex* in = const_cast<typename complex_vector::value_type*>(&v[0]);
+      typename c_api::plan p = cache().get(static_cast<int>(result.size()), false, false,
+            c_api::alignment_of(reinterpret_cast<real*>(in)), c_api::alignment_of(&result[0]));
+      c_api::execute_dft_c2r(p, in, &result[0]);
       if (normalize) {
          real norm = static_cast<real>(1.0 / result.size());
          for (typename real_vector::iterator it = result.begin(); it != result.end(); ++it)
@@ -177,6 +297,130 @@ struct fftw
       return result;
    }
 
+   /**
+    * Returns a pointer to the elements of \c data viewed as an array of real
+    * numbers, as used by the in-place transforms.
+    */
+   static real* real_data(complex_vector& data)
+   { return reinterpret_cast<real*>(&data[0]); }
+
+   /**
+    * Computes in place the real-to-complex Fourier transform of size \c n.
+    * The input consists of the first \c n elements of real_data(\c data);
+    * it is replaced by the first \c n / 2 + 1 elements of \c data.
+    * No memory is allocated, so that the same buffer can be reused for many
+    * transforms.
+    *
+    * \warning \c data must have at least \c n / 2 + 1 elements.
+    */
+   static complex_vector& fft_in_place(complex_vector& data, size_t n)
+   {
+      if (data.size() < n / 2 + 1)
+         throw std::invalid_argument("fftw::fft_in_place(): data must have size n / 2 + 1");
+      fft_in_place(&data[0], n);
+      return data;
+   }
+
+   /**
+    * Same as above, for the array of \c n / 2 + 1 elements starting at \c
+    * data, which can be part of a larger buffer.
+    */
+   static void fft_in_place(complex* data, size_t n)
+   {
+      real* in = reinterpret_cast<real*>(data);
+      typename c_api::plan p = cache().get(static_cast<int>(n), true, true,
+            c_api::alignment_of(in), c_api::alignment_of(in));
+      c_api::execute_dft_r2c(p, in, data);
+   }
+
+   /**
+    * Computes in place the complex-to-real Fourier transform of size \c n.
+    * The input consists of the first \c n / 2 + 1 elements of \c data; it is
+    * replaced by the first \c n elements of real_data(\c data).
+    * If \c normalize is \c true, the result is divided by \c n.
+    *
+    * \warning \c data must have at least \c n / 2 + 1 elements.
+    */
+   static complex_vector& ifft_in_place(complex_vector& data, size_t n, bool normalize=true)
+   {
+      if (data.size() < n / 2 + 1)
+         throw std::invalid_argument("fftw::ifft_in_place(): data must have size n / 2 + 1");
+      ifft_in_place(&data[0], n, normalize);
+      return data;
+   }
+
+   /**
+    * Same as above, for the array of \c n / 2 + 1 elements starting at \c
+    * data, which can be part of a larger buffer.
+    */
+   static void ifft_in_place(complex* data, size_t n, bool normalize=true)
+   {
+      real* out = reinterpret_cast<real*>(data);
+      typename c_api::plan p = cache().get(static_cast<int>(n), false, true,
+            c_api::alignment_of(out), c_api::alignment_of(out));
+      c_api::execute_dft_c2r(p, data, out);
+      if (normalize) {
+         real norm = static_cast<real>(1.0 / n);
+         for (size_t i = 0; i < n; i++)
+            out[i] *= norm;
+      }
+   }
+
+   /**
+    * Returns the number of complex numbers in the output of the
+    * multi-dimensional real-to-complex Fourier transform with dimensions \c
+    * dims: the last dimension is reduced to \c dims.back() / 2 + 1.
+    */
+   static size_t fft_size(const std::vector<int>& dims)
+   {
+      size_t size = 1;
+      for (size_t k = 0; k + 1 < dims.size(); k++)
+         size *= dims[k];
+      return dims.empty() ? 1 : size * (dims.back() / 2 + 1);
+   }
+
+   /**
+    * Computes in place the multi-dimensional real-to-complex Fourier
+    * transform with dimensions \c dims, in row-major order.
+    * The input consists of real_data(\c data) in the padded layout of FFTW:
+    * each row along the last dimension is stored on 2 * (\c dims.back() / 2 +
+    * 1) real numbers, of which only the first \c dims.back() are used.
+    * It is replaced by the first fft_size(\c dims) elements of \c data.
+    */
+   static void fft_in_place(complex* data, const std::vector<int>& dims)
+   {
+      real* in = reinterpret_cast<real*>(data);
+      typename c_api::plan p = cache().get(dims, true, c_api::alignment_of(in));
+      c_api::execute_dft_r2c(p, in, data);
+   }
+
+   /**
+    * Computes in place the multi-dimensional complex-to-real Fourier
+    * transform with dimensions \c dims, in row-major order.
+    * The input consists of the first fft_size(\c dims) elements of \c data;
+    * it is replaced by real_data(\c data) in the padded layout described in
+    * fft_in_place().
+    * If \c normalize is \c true, the result is divided by the product of the
+    * dimensions.
+    */
+   static void ifft_in_place(complex* data, const std::vector<int>& dims, bool normalize=true)
+   {
+      real* out = reinterpret_cast<real*>(data);
+      typename c_api::plan p = cache().get(dims, false, c_api::alignment_of(out));
+      c_api::execute_dft_c2r(p, data, out);
+      if (normalize and not dims.empty()) {
+         size_t n = 1;
+         for (const int d : dims)
+            n *= d;
+         const real norm = static_cast<real>(1.0 / n);
+         const size_t rowLength = dims.back();
+         const size_t paddedLength = 2 * (rowLength / 2 + 1);
+         for (size_t row = 0; row < n / rowLength; row++)
+            for (size_t i = 0; i < rowLength; i++)
+               out[row * paddedLength + i] *= norm;
+      }
+   }
+
    /**
     * Returns the output size (guessed) for complex-to-real Fourier transform of \c v.
     * \sa transform(const complex_vector&, real_vector&)
@@ -198,6 +442,114 @@ struct fftw
       ifft(v, fv, normalize);
       return fv;
    }
+
+private:
+   /**
+    * Process-wide cache of plans, keyed by the size of the transform, its
+    * direction (\c true for real-to-complex), whether it is performed in place
+    * and the alignments of the input and output arrays.
+    * The plans of the multi-dimensional transforms, which are performed in
+    * place, are keyed by their dimensions, direction and alignment.
+    * The FFTW planner is not thread-safe, hence all planning is done under
+    * \c mutex; the execution of a plan on new arrays is thread-safe.
+    */
+   struct plan_cache
+   {
+      typedef std::tuple<int, bool, bool, int, int> key_type;
+
+      std::mutex mutex;
+      unsigned flags = FFTW_ESTIMATE;
+      int threads = 1;
+      bool threads_initialized = false;
+      std::map<key_type, typename c_api::plan> plans;
+      std::map<std::tuple<std::vector<int>, bool, int>, typename c_api::plan> nd_plans;
+
+      ~plan_cache()
+      {
+         clear();
+#ifdef HAVE_FFTW_THREADS
+         if (threads_initialized)
+            c_api::cleanup_threads();
+#endif
+      }
+
+      void clear()
+      {
+         for (auto& kv : plans)
+            c_api::destroy_plan(kv.second);
+         plans.clear();
+         for (auto& kv : nd_plans)
+            c_api::destroy_plan(kv.second);
+         nd_plans.clear();
+      }
+
+      typename c_api::plan get(int n, bool forward, bool in_place, int in_alignment, int out_alignment)
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         const key_type key(n, forward, in_place, in_alignment, out_alignment);
+         auto it = plans.find(key);
+         if (it != plans.end())
+            return it->second;
+
+         // planners other than FFTW_ESTIMATE overwrite the arrays: plan on
+         // scratch arrays with the same alignments as the actual arrays
+         const size_t real_bytes = n * sizeof(real) + in_alignment + out_alignment;
+         const size_t complex_bytes = (n / 2 + 1) * sizeof(complex) + in_alignment + out_alignment;
+         char* complex_buffer = static_cast<char*>(c_api::malloc(complex_bytes));
+         char* real_buffer = in_place ? complex_buffer : static_cast<char*>(c_api::malloc(real_bytes));
+#ifdef HAVE_FFTW_THREADS
+         if (threads_initialized)
+            c_api::plan_with_nthreads(static_cast<size_t>(n) >= threaded_size() ? threads : 1);
+#endif
+         typename c_api::plan p = forward ?
+            c_api::plan_dft_r2c_1d(n, reinterpret_cast<real*>(real_buffer + in_alignment),
+                  reinterpret_cast<complex*>(complex_buffer + out_alignment), flags) :
+            c_api::plan_dft_c2r_1d(n, reinterpret_cast<complex*>(complex_buffer + in_alignment),
+                  reinterpret_cast<real*>(real_buffer + out_alignment), flags);
+         if (!in_place)
+            c_api::free(real_buffer);
+         c_api::free(complex_buffer);
+         if (!p)
+            throw std::runtime_error("fftw: cannot create plan");
+         plans.emplace(key, p);
+         return p;
+      }
+
+      typename c_api::plan get(const std::vector<int>& dims, bool forward, int alignment)
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         auto key = std::make_tuple(dims, forward, alignment);
+         auto it = nd_plans.find(key);
+         if (it != nd_plans.end())
+            return it->second;
+
+         size_t n = 1;
+         for (const int d : dims)
+            n *= d;
+         const size_t complex_bytes = fft_size(dims) * sizeof(complex) + alignment;
+         char* buffer = static_cast<char*>(c_api::malloc(complex_bytes));
+         complex* data = reinterpret_cast<complex*>(buffer + alignment);
+#ifdef HAVE_FFTW_THREADS
+         if (threads_initialized)
+            c_api::plan_with_nthreads(n >= threaded_size() ? threads : 1);
+#endif
+         const int rank = static_cast<int>(dims.size());
+         typename c_api::plan p = forward ?
+            c_api::plan_dft_r2c(rank, dims.data(), reinterpret_cast<real*>(data), data, flags) :
+            c_api::plan_dft_c2r(rank, dims.data(), data, reinterpret_cast<real*>(data), flags);
+         c_api::free(buffer);
+         if (!p)
+            throw std::runtime_error("fftw: cannot create plan");
+         nd_plans.emplace(std::move(key), p);
+         return p;
+      }
+   };
+
+   static plan_cache& cache()
+   {
+      static plan_cache c;
+      return c;
+   }
 };
 
 /**
@@ -224,11 +576,44 @@ struct fftw<float>::c_api
    static plan plan_dft_c2r_1d(int n, complex *in, real *out, unsigned flags)
    { return fftwf_plan_dft_c2r_1d(n, reinterpret_cast<fftwf_complex*>(in), out, flags); }
 
+   static plan plan_dft_r2c(int rank, const int *n, real *in, complex *out, unsigned flags)
+   { return fftwf_plan_dft_r2c(rank, n, in, reinterpret_cast<fftwf_complex*>(out), flags); }
+
+   static plan plan_dft_c2r(int rank, const int *n, complex *in, real *out, unsigned flags)
+   { return fftwf_plan_dft_c2r(rank, n, reinterpret_cast<fftwf_complex*>(in), out, flags); }
+
    static void destroy_plan(plan p)
    { fftwf_destroy_plan(p); }
 
    static void execute(const plan p)
    { return fftwf_execute(p); }
+
+   // new-array execution: the arrays must have the same alignment as those used for planning
+   static void execute_dft_r2c(const plan p, real *in, complex *out)
+   { fftwf_execute_dft_r2c(p, in, reinterpret_cast<fftwf_complex*>(out)); }
+
+   static void execute_dft_c2r(const plan p, complex *in, real *out)
+   { fftwf_execute_dft_c2r(p, reinterpret_cast<fftwf_complex*>(in), out); }
+
+   static int alignment_of(real *p)
+   { return fftwf_alignment_of(p); }
+
+   static int import_wisdom_from_filename(const char *filename)
+   { return fftwf_import_wisdom_from_filename(filename); }
+
+   static int export_wisdom_to_filename(const char *filename)
+   { return fftwf_export_wisdom_to_filename(filename); }
+
+#ifdef HAVE_FFTW_THREADS
+   static int init_threads()
+   { return fftwf_init_threads(); }
+
+   static void plan_with_nthreads(int threads)
+   { fftwf_plan_with_nthreads(threads); }
+
+   static void cleanup_threads()
+   { fftwf_cleanup_threads(); }
+#endif
 };
 
 /**
@@ -255,11 +640,44 @@ struct fftw<double>::c_api
    static plan plan_dft_c2r_1d(int n, complex *in, real *out, unsigned flags)
    { return fftw_plan_dft_c2r_1d(n, reinterpret_cast<fftw_complex*>(in), out, flags); }
 
+   static plan plan_dft_r2c(int rank, const int *n, real *in, complex *out, unsigned flags)
+   { return fftw_plan_dft_r2c(rank, n, in, reinterpret_cast<fftw_complex*>(out), flags); }
+
+   static plan plan_dft_c2r(int rank, const int *n, complex *in, real *out, unsigned flags)
+   { return fftw_plan_dft_c2r(rank, n, reinterpret_cast<fftw_complex*>(in), out, flags); }
+
    static void destroy_plan(plan p)
    { fftw_destroy_plan(p); }
 
    static void execute(const plan p)
    { return fftw_execute(p); }
+
+   // new-array execution: the arrays must have the same alignment as those used for planning
+   static void execute_dft_r2c(const plan p, real *in, complex *out)
+   { fftw_execute_dft_r2c(p, in, reinterpret_cast<fftw_complex*>(out)); }
+
+   static void execute_dft_c2r(const plan p, complex *in, real *out)
+   { fftw_execute_dft_c2r(p, reinterpret_cast<fftw_complex*>(in), out); }
+
+   static int alignment_of(real *p)
+   { return fftw_alignment_of(p); }
+
+   static int import_wisdom_from_filename(const char *filename)
+   { return fftw_import_wisdom_from_filename(filename); }
+
+   static int export_wisdom_to_filename(const char *filename)
+   { return fftw_export_wisdom_to_filename(filename); }
+
+#ifdef HAVE_FFTW_THREADS
+   static int init_threads()
+   { return fftw_init_threads(); }
+
+   static void plan_with_nthreads(int threads)
+   { fftw_plan_with_nthreads(threads); }
+
+   static void cleanup_threads()
+   { fftw_cleanup_threads(); }
+#endif
 };
 
 
@@ -71,11 +71,16 @@
 
 #include "netbuilder/Types.h"
 #include "netbuilder/GeneratingMatrix.h"
+#include "netbuilder/PackedGeneratingMatrix.h"
 #include "netbuilder/NetConstructionTraits.h"
+#include "netbuilder/Helpers/CoordinateList.h"
+#include "netbuilder/Helpers/PoolAllocator.h"
 
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 
 namespace NetBuilder {
 
@@ -83,6 +88,11 @@ namespace NetBuilder {
  * 
  * Digital nets in other bases are not implemented.
  * An abstract digital net essentially corresponds to a vector of generating matrices.
+ * When the matrices have at most 64 columns, a word-packed copy of each matrix (see PackedGeneratingMatrix) is used by
+ * the computations based on row reductions. It is built once per coordinate, the first time it is requested, so that
+ * the nets evaluated by other figures of merit do not store it.
+ * The coordinates are stored in a CoordinateList, so that the nets obtained by adding a coordinate to a net share
+ * the coordinates of this net.
  * This class is used to reason about digital nets whenever we do not need to actually construct them, e.g. to compute
  * figures of merit from the matrices.
  * 
@@ -140,7 +150,23 @@ class AbstractDigitalNet
          */
         const GeneratingMatrix& generatingMatrix(Dimension coord) const 
         {
-            return *m_generatingMatrices[coord];
+            return m_coordinates[coord].matrix;
+        }
+
+        /** 
+         * Returns whether the word-packed representation of the generating matrices is available,
+         * that is whether the generating matrices have at most 64 columns.
+         */
+        bool hasPackedGeneratingMatrices() const { return PackedGeneratingMatrix::fits(m_nCols); }
+
+        /** 
+         * Returns the word-packed generating matrix corresponding to coordinate \c coord.
+         * Should only be called if hasPackedGeneratingMatrices() returns true.
+         * @param coord A coordinate (between 0 and dimension() - 1 ).
+         */
+        const PackedGeneratingMatrix& packedGeneratingMatrix(Dimension coord) const 
+        {
+            return m_coordinates[coord].packed();
         }
 
         /**
@@ -156,28 +182,81 @@ class AbstractDigitalNet
          */ 
         virtual bool isSequenceViewable() const = 0;
 
+        /** 
+         * Returns the columns of the generating matrices computed with \c nRows rows, in the integer representation
+         * of GeneratingMatrix::getColsReverse. This gives the first \c nRows digits of the points of the net, which may be 
+         * more than the number of rows of the matrices used to evaluate the net.
+         * @param nRows Number of rows (at most the number of bits of an unsigned long).
+         */ 
+        virtual std::vector<std::vector<unsigned long>> generatingMatricesColumns(unsigned int nRows) const = 0;
+
     protected:
 
+        /**
+         * Data stored for each coordinate of the net.
+         */
+        struct Coordinate
+        {
+            /**
+             * Constructor.
+             * @param mat Generating matrix of the coordinate.
+             */
+            Coordinate(GeneratingMatrix mat):
+                matrix(std::move(mat))
+            {}
+
+            /**
+             * Returns the word-packed copy of the matrix, packing it at the first call.
+             * The matrix must have at most 64 columns. Can be called concurrently by several threads.
+             */
+            const PackedGeneratingMatrix& packed() const
+            {
+                std::call_once(packOnce, [this] () { packedMatrix.assign(matrix); });
+                return packedMatrix;
+            }
+
+            GeneratingMatrix matrix; // generating matrix of the coordinate
+
+        private:
+            mutable std::once_flag packOnce; // guards the packing of the matrix
+            mutable PackedGeneratingMatrix packedMatrix; // word-packed generating matrix (empty until packed() is called)
+        };
+
         Dimension m_dimension; // dimension of the net
         unsigned int m_nRows; // number of rows in generating matrices
         unsigned int m_nCols; // number of columns in generating matrices
-        mutable std::vector<std::shared_ptr<GeneratingMatrix>> m_generatingMatrices; // vector of shared pointers to the generating matrices
-        // The generating matrix class is defined in GeneratingMatrix.h.
+        CoordinateList<Coordinate> m_coordinates; // persistent list of the coordinates, shared with the nets obtained by appending coordinates
 
         /** 
          * Most general constructor. Designed to be used by derived classes. 
          * @param dimension Dimension of the net.
          * @param nRows Number of rows of the generating matrices.
          * @param nCols Number of columns of the generating matrices.
-         * @param genMatrices Vector of shared pointers to the generating matrices.
+         * @param coordinates List of the coordinates.
          */
-        AbstractDigitalNet(Dimension dimension, unsigned int nRows, unsigned int nCols, std::vector<std::shared_ptr<GeneratingMatrix>> genMatrices):
+        AbstractDigitalNet(Dimension dimension, unsigned int nRows, unsigned int nCols, CoordinateList<Coordinate> coordinates):
             m_dimension(dimension),
             m_nRows(nRows),
             m_nCols(nCols),
-            m_generatingMatrices(genMatrices)
+            m_coordinates(std::move(coordinates))
         {};
 
+        /** 
+         * Returns the vector of shared pointers to the generating matrices.
+         * The pointers share the ownership of the coordinates.
+         */
+        std::vector<std::shared_ptr<GeneratingMatrix>> generatingMatrices() const
+        {
+            std::vector<std::shared_ptr<GeneratingMatrix>> res;
+            res.reserve(m_coordinates.size());
+            for(std::size_t coord = 0; coord < m_coordinates.size(); ++coord)
+            {
+                const auto& coordinate = m_coordinates.pointer(coord);
+                res.push_back(std::shared_ptr<GeneratingMatrix>(coordinate, &coordinate->matrix));
+            }
+            return res;
+        }
+
 };
 
 /** Derived class of AbstractDigitalNet designed to implement specific construction methods. The available construction methods
@@ -217,15 +296,13 @@ class DigitalNet : public AbstractDigitalNet
             SizeParameter sizeParameter, 
             std::vector<GenValue> genValues):
                 AbstractDigitalNet(dimension, ConstructionMethod::nRows(sizeParameter), ConstructionMethod::nCols(sizeParameter)),
-                m_sizeParameter(std::move(sizeParameter))
+                m_sizeParameter(std::make_shared<const SizeParameter>(std::move(sizeParameter)))
         {
-            m_genValues.reserve(m_dimension);
             Dimension dimension_j = 0; //index of the dimension of the net, used for creating JoeKuo net 
-            for(const auto& genValue : genValues)
+            for(auto& genValue : genValues)
             {
-                // construct the generating matrix and store them and the generating values
-                m_generatingMatrices.push_back(std::shared_ptr<GeneratingMatrix>(ConstructionMethod::createGeneratingMatrix(genValue,m_sizeParameter,dimension_j)));
-                m_genValues.push_back(std::shared_ptr<GenValue>(new GenValue(std::move(genValue))));
+                // construct the generating matrix and store it with the generating value
+                m_coordinates.push_back(makeCoordinate(std::move(genValue), dimension_j));
                 dimension_j++;
             }
         }
@@ -239,7 +316,7 @@ class DigitalNet : public AbstractDigitalNet
             Dimension dimension = 0,
             SizeParameter sizeParameter = SizeParameter()):
                 AbstractDigitalNet(dimension, ConstructionMethod::nRows(sizeParameter), ConstructionMethod::nCols(sizeParameter)),
-                m_sizeParameter(std::move(sizeParameter))
+                m_sizeParameter(std::make_shared<const SizeParameter>(std::move(sizeParameter)))
         {}
 
         /**
@@ -247,26 +324,40 @@ class DigitalNet : public AbstractDigitalNet
          */
         ~DigitalNet() = default;
 
+        /**
+         * Allocates the memory of a net from a pool recycling the memory of destroyed nets.
+         */
+        static void* operator new(std::size_t size)
+        {
+            return (size == sizeof(DigitalNet<NC>)) ? BlockPool<sizeof(DigitalNet<NC>)>::allocate() : ::operator new(size);
+        }
+
+        /**
+         * Releases the memory of a net allocated by operator new.
+         */
+        static void operator delete(void* p, std::size_t size)
+        {
+            if (size == sizeof(DigitalNet<NC>))
+            {
+                BlockPool<sizeof(DigitalNet<NC>)>::deallocate(p);
+            }
+            else
+            {
+                ::operator delete(p);
+            }
+        }
+
         /** Adds a new coordinate at the end of a digital net using the generating value \c newGenValue. 
          * Note that the resources (generating matrices, generatins values and computation data) for the lower dimensions are not copied. The net on 
-         * which this method is called and the new net share these resources.
+         * which this method is called and the new net share these resources. The cost of this operation does not depend on the dimension
+         * of the net: apart from the construction of the new generating matrix, the new coordinate and the new net are allocated from pools
+         * and the coordinates of the net are shared through a CoordinateList.
          * @param newGenValue  Generating value used to extend the net.
          * @return A <code>std::unique_ptr</code> to the instantiated net.
          */ 
         std::unique_ptr<DigitalNet<NC>> appendNewCoordinate(const GenValue& newGenValue) const 
         {
-            std::shared_ptr<GeneratingMatrix> newMat(ConstructionMethod::createGeneratingMatrix(newGenValue, m_sizeParameter, m_dimension));
-
-            // copy the vector of pointers to matrices and add the new matrix
-            auto genMats = m_generatingMatrices; 
-            genMats.push_back(std::move(newMat));
-
-            // copy the vector of pointers to generating values and add the new generating value
-            auto genVals = m_genValues;
-            genVals.push_back(std::shared_ptr<GenValue>(new GenValue(newGenValue)));
-
-            // instantiate the new net and return the unique pointer to it
-            return std::unique_ptr<DigitalNet<NC>>(new DigitalNet<NC>(m_dimension+1, m_sizeParameter, std::move(genVals), std::move(genMats)));
+            return std::unique_ptr<DigitalNet<NC>>(new DigitalNet<NC>(m_dimension+1, m_sizeParameter, m_coordinates.append(makeCoordinate(newGenValue, m_dimension))));
         }
 
 
@@ -308,15 +399,16 @@ class DigitalNet : public AbstractDigitalNet
                 else {
                     res += "# Columns of gen. matrices C_1,...,C_{ds}, one matrix per line\n";
                 }
-                for(unsigned int coord = 0; coord < m_genValues.size(); coord++)
+                for(unsigned int coord = 0; coord < m_coordinates.size(); coord++)
                 {
-                    res += ConstructionMethod::createGeneratingMatrix(*(m_genValues[coord]), m_sizeParameter, coord, 31)->formatToColumnsReverse();
+                    std::unique_ptr<GeneratingMatrix> mat(ConstructionMethod::createGeneratingMatrix(genValue(coord), *m_sizeParameter, coord, 31));
+                    res += mat->formatToColumnsReverse();
                     res += "\n";
                 }
                 res.pop_back();
             }
 
-            res += ConstructionMethod::format(m_generatingMatrices, m_genValues, m_sizeParameter, outputStyle, interlacingFactor);
+            res += ConstructionMethod::format(generatingMatrices(), genValues(), *m_sizeParameter, outputStyle, interlacingFactor);
 
             return res;
         }
@@ -329,29 +421,128 @@ class DigitalNet : public AbstractDigitalNet
             return ConstructionMethod::isSequenceViewable;
         }
 
-        SizeParameter sizeParameter() const { return m_sizeParameter ; }
+        /**
+         * {@inheritDoc}
+         */ 
+        virtual std::vector<std::vector<unsigned long>> generatingMatricesColumns(unsigned int nRows) const 
+        {
+            std::vector<std::vector<unsigned long>> res;
+            res.reserve(m_coordinates.size());
+            for(unsigned int coord = 0; coord < m_coordinates.size(); coord++)
+            {
+                std::unique_ptr<GeneratingMatrix> mat(ConstructionMethod::createGeneratingMatrix(genValue(coord), *m_sizeParameter, coord, nRows));
+                std::vector<unsigned long> columns = mat->getColsReverse();
+                for(auto& column : columns) // some constructions ignore the requested number of rows
+                {
+                    column = (mat->nRows() <= nRows) ? column << (nRows - mat->nRows()) : column >> (mat->nRows() - nRows);
+                }
+                res.push_back(std::move(columns));
+            }
+            return res;
+        }
+
+        SizeParameter sizeParameter() const { return *m_sizeParameter ; }
+
+        /** 
+         * Returns the generating value of coordinate \c coord.
+         * @param coord A coordinate (between 0 and dimension() - 1 ).
+         */
+        const GenValue& genValue(Dimension coord) const
+        {
+            return static_cast<const Entry&>(m_coordinates[coord]).genValue;
+        }
     
     private:
 
-        SizeParameter m_sizeParameter; // size parameter of the net
-        std::vector<std::shared_ptr<GenValue>> m_genValues; // vector of shared pointers to the generating values of the net
+        /** 
+         * Data stored for each coordinate of the net: the generating matrices and the generating value.
+         * The generating matrix is handed back to the spare matrices of the destroying thread.
+         */
+        struct Entry : public Coordinate
+        {
+            Entry(GeneratingMatrix mat, GenValue value):
+                Coordinate(std::move(mat)),
+                genValue(std::move(value))
+            {}
+
+            ~Entry()
+            {
+                std::vector<GeneratingMatrix>& spare = spareMatrices();
+                if (spare.size() < spare.capacity())
+                {
+                    spare.push_back(std::move(this->matrix));
+                }
+            }
+
+            GenValue genValue; // generating value of the coordinate
+        };
+
+        /// Maximal number of spare matrices kept by each thread.
+        static constexpr std::size_t maxSpareMatrices = 1024;
+
+        /**
+         * Returns the per-thread list of the generating matrices released by the destroyed coordinates.
+         * The storage of these matrices is reused by the next coordinates constructed by the thread.
+         */
+        static std::vector<GeneratingMatrix>& spareMatrices()
+        {
+            static thread_local std::vector<GeneratingMatrix> spare = [] () {
+                std::vector<GeneratingMatrix> res;
+                res.reserve(maxSpareMatrices);
+                return res;
+            }();
+            return spare;
+        }
+
+        std::shared_ptr<const SizeParameter> m_sizeParameter; // size parameter of the net, shared with the nets obtained by appending coordinates
 
         /** Constructor used internally to avoid recomputing known generating matrices.
          * @param dimension Dimension of the net.
          * @param sizeParameter Size parameter of the net.
-         * @param genValues Vector of shared pointers to the generating values of each coordinate.
-         * @param genMatrices Vector of shared pointers to the generating matrices of each coordinate.
+         * @param coordinates List of the coordinates.
         */ 
         DigitalNet(
             Dimension dimension,
-            SizeParameter sizeParameter,
-            std::vector<std::shared_ptr<GenValue>> genValues,
-            std::vector<std::shared_ptr<GeneratingMatrix>> genMatrices
+            std::shared_ptr<const SizeParameter> sizeParameter,
+            CoordinateList<Coordinate> coordinates
             ):
-                AbstractDigitalNet(dimension, ConstructionMethod::nRows(sizeParameter), ConstructionMethod::nCols(sizeParameter), std::move(genMatrices)),
-                m_sizeParameter(std::move(sizeParameter)),
-                m_genValues(std::move(genValues))
+                AbstractDigitalNet(dimension, ConstructionMethod::nRows(*sizeParameter), ConstructionMethod::nCols(*sizeParameter), std::move(coordinates)),
+                m_sizeParameter(std::move(sizeParameter))
         {};
+
+        /** Constructs the generating matrix of a coordinate and stores it with its generating value in memory taken from a pool.
+         * The matrix is filled in place in a spare matrix of the thread, if any.
+         * @param genValue Generating value of the coordinate.
+         * @param coord Index of the coordinate.
+         */
+        std::shared_ptr<Coordinate> makeCoordinate(GenValue genValue, Dimension coord) const
+        {
+            std::vector<GeneratingMatrix>& spare = spareMatrices();
+            GeneratingMatrix mat;
+            if (!spare.empty())
+            {
+                mat = std::move(spare.back());
+                spare.pop_back();
+            }
+            ConstructionMethod::fillGeneratingMatrix(mat, genValue, *m_sizeParameter, coord);
+            return std::allocate_shared<Entry>(PoolAllocator<Entry>(), std::move(mat), std::move(genValue));
+        }
+
+        /** 
+         * Returns the vector of shared pointers to the generating values.
+         * The pointers share the ownership of the coordinates.
+         */
+        std::vector<std::shared_ptr<GenValue>> genValues() const
+        {
+            std::vector<std::shared_ptr<GenValue>> res;
+            res.reserve(m_coordinates.size());
+            for(std::size_t coord = 0; coord < m_coordinates.size(); ++coord)
+            {
+                const auto& coordinate = m_coordinates.pointer(coord);
+                res.push_back(std::shared_ptr<GenValue>(coordinate, &static_cast<Entry*>(coordinate.get())->genValue));
+            }
+            return res;
+        }
 };
 }
 
@@ -151,6 +151,14 @@ class BitEquidistribution : public CBCFigureOfMerit{
                 {
                     m_tmpRankComputer = std::move(m_newRankComputer);
                 }
+
+                /**
+                 * Tells the evaluator that the best net so far is the one of \c other and copies its reduction
+                 */
+                virtual void copyBestNet(const CBCFigureOfMeritEvaluator& other) override
+                {
+                    m_tmpRankComputer = dynamic_cast<const BitEquidistributionEvaluator&>(other).m_tmpRankComputer;
+                }
                 
                 /**
                  * Tells the evaluator that no more net will be evaluate for the current dimension,
@@ -220,7 +228,7 @@ MeritValue BitEquidistribution<EmbeddingType::UNILEVEL>::BitEquidistributionEval
 
     for(unsigned int bit = 0; bit < m_figure->nbBits(); ++bit) // for each bit of equidistribution
     {
-        m_newRankComputer.addRow(net.generatingMatrix(dimension).subMatrix(bit, 0, 1, nCols )); // add the new row
+        m_newRankComputer.addRow(net.generatingMatrix(dimension)[bit]); // add the new row
         if (m_newRankComputer.computeRank() < m_newRankComputer.numRows())
         {
             acc.accumulate(m_figure->weight(), 1, m_figure->expNorm()); // the points are not equidistributed: set the merit
@@ -257,7 +265,7 @@ MeritValue BitEquidistribution<EmbeddingType::MULTILEVEL>::BitEquidistributionEv
 
     for(unsigned int bit = 0; bit < m_figure->nbBits(); ++bit) // for each bit of equidistribution
     {
-        m_newRankComputer.addRow(net.generatingMatrix(dimension).subMatrix(bit, 0, 1, nCols )); // add the new row
+        m_newRankComputer.addRow(net.generatingMatrix(dimension)[bit]); // add the new row
         std::vector<unsigned int> ranks = m_newRankComputer.computeRanks(0,nCols); // compute the rank
 
         for(unsigned int m = 1; m <= nCols; ++m) // for each level of points
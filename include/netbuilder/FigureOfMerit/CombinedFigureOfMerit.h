@@ -195,6 +195,18 @@ class CombinedFigureOfMerit : public CBCFigureOfMerit{
                     m_oldMerits = std::vector<Real>(m_figure->size(),0);
                 }
 
+                /**
+                 * Sets the number of threads used by the evaluators of the combined figures to evaluate a single net.
+                 * @param nThreads Number of threads.
+                 */
+                virtual void setNumThreads(unsigned int nThreads) override
+                {
+                    for(auto& eval : m_evaluators)
+                    {
+                        eval->setNumThreads(nThreads);
+                    }
+                }
+
                 /**
                  * Tells the evaluator that the last net was the best so far and store the relevant information
                  */
@@ -221,6 +233,19 @@ class CombinedFigureOfMerit : public CBCFigureOfMerit{
                     }
                 }
 
+                /**
+                 * Tells the evaluator that the best net so far is the one of \c other and copies the relevant information from \c other
+                 */
+                virtual void copyBestNet(const CBCFigureOfMeritEvaluator& other) override
+                {
+                    const auto& source = dynamic_cast<const CombinedFigureOfMeritEvaluator&>(other);
+                    m_bestNewMerits = source.m_bestNewMerits;
+                    for(unsigned int i = 0; i < m_evaluators.size(); ++i)
+                    {
+                        m_evaluators[i]->copyBestNet(*source.m_evaluators[i]);
+                    }
+                }
+
             private:
                 CombinedFigureOfMerit* m_figure; // pointer to the figure
                 std::vector<std::unique_ptr<CBCFigureOfMeritEvaluator>> m_evaluators; // evaluators
@@ -272,6 +272,16 @@ namespace NetBuilder{ namespace FigureOfMerit {
                             }
                         }
 
+                        /**
+                         * Tells the evaluator that the best net so far is the one of \c other and copies its states
+                         */
+                        virtual void copyBestNet(const CBCFigureOfMeritEvaluator& other) override
+                        {
+                            const auto& source = dynamic_cast<const CoordUniformFigureOfMeritEvaluator&>(other);
+                            updateSizeParam(source.m_numLevels);
+                            m_tmpStates = source.m_tmpStates;
+                        }
+
                         void updateSizeParam(unsigned int m)
                         {
                             if (m != m_numLevels)
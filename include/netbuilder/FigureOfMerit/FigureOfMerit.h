@@ -32,6 +32,7 @@
 #include <string>
 #include <limits>
 #include <functional>
+#include <stdexcept>
 
 #include <boost/signals2.hpp>
 
@@ -98,6 +99,13 @@ class FigureOfMeritEvaluator
          */ 
         virtual void reset() = 0;
 
+        /**
+         * Sets the number of threads the evaluator may use to evaluate a single net.
+         * Evaluators which cannot evaluate a net concurrently ignore it.
+         * @param nThreads Number of threads.
+         */
+        virtual void setNumThreads(unsigned int nThreads) {}
+
     private:
         std::unique_ptr<OnProgress> m_onProgress; 
         std::unique_ptr<OnAbort> m_onAbort;
@@ -199,6 +207,48 @@ class CBCFigureOfMeritEvaluator:
          */
         virtual void lastNetWasBest() = 0;
 
+        /**
+         * Tells the evaluator that the best net so far is the one of \c other and copies the relevant information from \c other,
+         * so that the net does not need to be evaluated again. Both evaluators must evaluate the same figure of merit and be at the same dimension.
+         * @param other Evaluator of the same figure of merit.
+         */
+        virtual void copyBestNet(const CBCFigureOfMeritEvaluator& other) = 0;
+
+        /**
+         * Returns the maximum number of nets which can be evaluated at once by evaluateBatch().
+         */
+        virtual unsigned int batchSize() const { return 1; }
+
+        /** 
+         * Computes the figure of merit of several nets for the given \c dimension (partial computation), 
+         * starting from the initial value \c initialValue. The nets must only differ by their coordinate \c dimension,
+         * which is the case of the candidates of a CBC search for this coordinate. At most batchSize() nets can be
+         * evaluated at once. Evaluators which do not override this function evaluate the nets one by one.
+         *  @param nets Nets to evaluate.
+         *  @param dimension Dimension to compute.
+         *  @param initialValue Initial value of the merit.
+         *  @param verbose Verbosity level.
+         */ 
+        virtual std::vector<MeritValue> evaluateBatch(const std::vector<const AbstractDigitalNet*>& nets, Dimension dimension, MeritValue initialValue, int verbose = 0)
+        {
+            if (nets.size() > batchSize())
+            {
+                throw std::logic_error("In CBC figure of merit evaluator: batch is too large.");
+            }
+            std::vector<MeritValue> res;
+            for(const AbstractDigitalNet* net : nets)
+            {
+                res.push_back(operator()(*net, dimension, initialValue, verbose));
+            }
+            return res;
+        }
+
+        /**
+         * Tells the evaluator that the net at position \c index of the last batch was the best so far and store the relevant information.
+         * @param index Position of the net in the last batch given to evaluateBatch().
+         */
+        virtual void batchNetWasBest(unsigned int index) { lastNetWasBest(); }
+
 };
 
 /**
@@ -19,18 +19,78 @@
 
 #include "netbuilder/FigureOfMerit/WeightedFigureOfMerit.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
 namespace NetBuilder { namespace FigureOfMerit {
 
+/** 
+ * Read-only view of the coordinates of a projection, sorted in increasing order and stored contiguously.
+ * Used to pass the projections cached by ProjectionDependentEvaluator without copying them.
+ */ 
+class ProjectionView
+{
+    public:
+
+        typedef const unsigned int* const_iterator;
+
+        /** 
+         * Constructor.
+         * @param coords Pointer to the first coordinate of the projection.
+         * @param size Number of coordinates of the projection.
+         */ 
+        ProjectionView(const unsigned int* coords, unsigned int size):
+            m_coords(coords),
+            m_size(size)
+        {};
+
+        /** 
+         * Returns the number of coordinates of the projection.
+         */ 
+        unsigned int size() const { return m_size; }
+
+        const_iterator begin() const { return m_coords; }
+
+        const_iterator end() const { return m_coords + m_size; }
+
+        /** 
+         * Returns a copy of the projection as a LatticeTester::Coordinates.
+         */ 
+        LatticeTester::Coordinates toCoordinates() const { return LatticeTester::Coordinates(begin(), end()); }
+
+    private:
+        const unsigned int* m_coords; // pointer to the first coordinate
+        unsigned int m_size; // number of coordinates
+};
+
 /** 
  * Class to implement the evaluation of specific projection-dependent weighted figure of merit where
  * the merits of the subprojections of order one less are used to compute the merit of a bigger projection, for instance
  * the t-value of subprojections. 
+ *
+ * The projections are stored in an arena of contiguous arrays (weights, coordinates, subprojections and merits), indexed
+ * by node. The nodes of the projections whose highest coordinate is the same form a dimension. Within a dimension,
+ * the nodes are grouped in layers by increasing cardinal and sorted by decreasing weight inside each layer, which is the
+ * order of evaluation.
  * @tparam PROJDEP Template parameter representing the projection-dependent merit.
  */ 
 template <typename PROJDEP>
 class ProjectionDependentEvaluator : public CBCFigureOfMeritEvaluator 
 {
 
+        /// Type of merit value storage.
+        typedef typename PROJDEP::Merit MeritStorage;
+
+        /// Type of the combination of the merits of the subprojections.
+        typedef typename PROJDEP::SubProjCombination SubProjCombination;
+
+        /// Type of the index of a node in the arena.
+        typedef unsigned int NodeIndex;
 
     public:
 
@@ -42,27 +102,13 @@ class ProjectionDependentEvaluator : public CBCFigureOfMeritEvaluator
                     m_figure(figure),
                     m_numCoordinates(0),
                     m_maxNumCoordinates(0),
-                    m_maxCardinal(m_figure->projDepMerit().maxCardinal())
+                    m_maxCardinal(m_figure->projDepMerit().maxCardinal()),
+                    m_nThreads(1),
+                    m_firstLayer(1, 0),
+                    m_firstNode(1, 0),
+                    m_batchSize(0)
         {};
 
-        /** 
-         * Destructor. */
-        ~ProjectionDependentEvaluator()
-        {
-            for(Dimension dim = 0; dim < m_maxNumCoordinates; ++dim)
-            {
-                ProjectionNode* it = m_roots[dim];
-                ProjectionNode* nextIt = nullptr;
-                do
-                {
-                    nextIt = it->getNextNode();
-                    delete it;
-                    it = nextIt;
-                }
-                while(it != nullptr);
-            }
-        }
-
         /** 
          * Computes the figure of merit for the given \c net for the given \c dimension (partial computation), 
          * starting from the initial value \c initialValue.
@@ -73,59 +119,86 @@ class ProjectionDependentEvaluator : public CBCFigureOfMeritEvaluator
          */ 
         virtual MeritValue operator() (const AbstractDigitalNet& net, Dimension dimension, MeritValue initialValue, int verbose = 0) override
         {
+            if (m_nThreads > 1)
+            {
+                return evaluateInParallel(net, dimension, std::move(initialValue));
+            }
+
             unsigned int nLevels = PROJDEP::numLevels(net); // determine the number of levels
 
             auto acc = m_figure->accumulator(std::move(initialValue));
 
-            ProjectionNode* it = m_roots[dimension]; // iterator over the nodes
-            do
-            {   
-                Real weight = it->getWeight();
-                
-                if (PROJDEP::size(it->getSubProjCombination()) < nLevels) // resize the subprojections combination if required
+            SubProjCombination subProjCombination;
+            PROJDEP::resize(subProjCombination, nLevels);
+
+            const NodeIndex dimensionBegin = firstNode(dimension);
+
+            for(size_t l = m_firstLayer[dimension]; l < m_firstLayer[dimension+1]; ++l) // for each layer
+            {
+                const Layer& layer = m_layers[l];
+                for(NodeIndex k = 0; k < layer.numNodes; ++k)
                 {
-                    PROJDEP::resize(it->getSubProjCombination(), nLevels);
-                }
+                    const NodeIndex node = layer.firstNode + k;
 
-                it->updateSubProjCombination(); // update the subprojection combination
+                    updateSubProjCombination(layer, k, dimensionBegin, subProjCombination); // update the subprojection combination
 
-                LatticeTester::Coordinates proj = it->getProjectionRepresentation();
+                    const ProjectionView proj = projection(layer, k);
 
-                auto grossMerit = m_figure->projDepMerit()(net, proj ,it->getSubProjCombination()); // compute the merit of the projection
+                    auto grossMerit = m_figure->projDepMerit()(net, proj, subProjCombination); // compute the merit of the projection
 
-                Real merit = m_figure->projDepMerit().combine(grossMerit, net, proj); // combine in a single merit value
+                    Real merit = m_figure->projDepMerit().combine(grossMerit, net, proj); // combine in a single merit value
 
-                acc.accumulate(weight,merit,1);
+                    acc.accumulate(m_weights[node], merit, 1);
 
-                if (!onProgress()(acc.value()))  // if someone is listening, may tell that the computation is useless
-                {
-                    acc.accumulate(std::numeric_limits<Real>::infinity(), merit, 1); // set the merit to infinity
-                    onAbort()(net); // abort the computation
-                    break;
-                }
+                    if (!onProgress()(acc.value()))  // if someone is listening, may tell that the computation is useless
+                    {
+                        acc.accumulate(std::numeric_limits<Real>::infinity(), merit, 1); // set the merit to infinity
+                        onAbort()(net); // abort the computation
+                        return acc.value();
+                    }
 
-                it->setMeritTmp(grossMerit); // update the merit of the node
-                it = it->getNextNode(); // skip to next node
+                    m_meritTmp[node] = std::move(grossMerit); // update the merit of the node
+                }
             }
-            while(it != nullptr);
 
             return acc.value();
         }
 
-        /**     
+        /** 
          * Resets the evaluator and prepare it to evaluate a new net.
          */ 
         virtual void reset() override { m_numCoordinates=0; }
 
-        /**
+        /** 
+         * Sets the number of threads used to evaluate the projections of a net. When more than one thread is used,
+         * the projections of each cardinal are evaluated concurrently.
+         * @param nThreads Number of threads.
+         */ 
+        virtual void setNumThreads(unsigned int nThreads) override { m_nThreads = std::max(nThreads, 1u); }
+
+        /** 
          * Tells the evaluator that the last net was the best so far and store the relevant information
-         */
+         */ 
         virtual void lastNetWasBest() override
         {
             saveMerits(m_numCoordinates-1);
         }
 
-        /**
+        /** 
+         * Tells the evaluator that the best net so far is the one of \c other and copies the stored merits of the nodes of the last dimension
+         */ 
+        virtual void copyBestNet(const CBCFigureOfMeritEvaluator& other) override
+        {
+            const auto& source = dynamic_cast<const ProjectionDependentEvaluator&>(other);
+            const Dimension dimension = m_numCoordinates-1;
+            const NodeIndex dimensionEnd = firstNode(dimension+1);
+            for(NodeIndex node = firstNode(dimension); node < dimensionEnd; ++node)
+            {
+                m_meritMem[node] = source.m_meritMem[node];
+            }
+        }
+
+        /** 
          * Tells the evaluator that no more net will be evaluate for the current dimension,
          * store information about the best net for the dimension which is over and prepare data structures
          * for the next dimension.
@@ -147,258 +220,536 @@ class ProjectionDependentEvaluator : public CBCFigureOfMeritEvaluator
             }
         }
 
-    private:
+    protected:
 
         /** 
-         * Represents a projection. The node is linked to the projections with order one less and with the following
-         * projection in the evaluation order. The node store some merit values.
+         * Computes the figure of merit of several nets for the given \c dimension (partial computation), 
+         * starting from the initial value \c initialValue. The nets must only differ by their coordinate \c dimension.
+         * The projection-dependent merit must provide a batch evaluation operator taking the vector of nets and the
+         * vector of the subprojection combinations of each net.
+         * The merits of the projections are kept for each net until batchNetWasBest() is called.
+         * @param nets Nets to evaluate.
+         * @param dimension Dimension to compute.
+         * @param initialValue Initial value of the merit.
          */ 
-        struct ProjectionNode
+        std::vector<MeritValue> evaluateBatchImpl(const std::vector<const AbstractDigitalNet*>& nets, Dimension dimension, MeritValue initialValue)
         {
-            /// Type of merit value storage.
-            typedef typename PROJDEP::Merit MeritStorage;
-
-            /// Type of the combination of the merits of the subprojections.
-            typedef typename PROJDEP::SubProjCombination SubProjCombination; 
-
-            /** 
-             * Constructor.
-             * @param dimension Highest coordinate in all the projections of the layer.
-             * @param cardinal Cardinal of the projection.
-             * @param weight Importance of the projection in the figure of merit.
-             */ 
-            ProjectionNode(Dimension dimension, unsigned int cardinal, double weight):
-                m_weight(weight),
-                m_dimension(dimension),
-                m_cardinal(cardinal)
-            {};
-
-            /** 
-             * Returns the cardinal of the projection represented by the node.
-             */ 
-            unsigned int getCardinal() const { return m_cardinal; }
-
-            /** 
-             * Returns the maximum dimension, that is the highest coordinate in all the projections of the layer.
-             */ 
-            Dimension getMaxDimension() const { return m_dimension; }
-
-            /** Returns a pointer to the next projection to evaluate. May be null.
-             */ 
-            ProjectionNode* getNextNode() const { return m_nextNode; }
-
-            /** Set the next node of the current node.
-             * @param node is a pointer to the next node.
-             */ 
-            void setNextNode(ProjectionNode* node){ m_nextNode = node; }
-
-            /** 
-             * Returns a vector of pointers to the subprojections whose cardinal is one less than the
-             * projection's.
-             */ 
-            const std::vector<ProjectionNode*>& getMotherNodes() const { return m_mothersNodes; }
-
-            /** 
-             * Returns the projection represented by the node.
-             */ 
-            LatticeTester::Coordinates getProjectionRepresentation() const { 
-                LatticeTester::Coordinates res;
-                accumulateProjectionRepresentation(res);
-                return res;
+            const unsigned int nNets = (unsigned int) nets.size();
+            unsigned int nLevels = PROJDEP::numLevels(*nets[0]); // determine the number of levels
+
+            std::vector<Accumulator> accs;
+            accs.reserve(nNets);
+            for(unsigned int i = 0; i < nNets; ++i)
+            {
+                accs.push_back(m_figure->accumulator(initialValue));
             }
 
-            /**
-             * Add a mother to the projection node.
-             * @param mother Pointer to the new mother.
-             */ 
-            void addMother(ProjectionNode* mother) { m_mothersNodes.push_back(mother); }
-
-            /** 
-             * Returns the weight of the projection represented by the node.
-             */ 
-            Real getWeight() const { return m_weight; }
-
-
-            /** Returns the stored merit of the projection represented by the node.
-             */ 
-            MeritStorage getMeritMem() const {return m_meritMem; }
-
-            /** Returns the temporary merit of the projection represented by the node.
-             */ 
-            MeritStorage getMeritTmp() const {return m_meritTmp; }
-
-
-            /** 
-             * Returns the maximum of the merits of the subprojections.
-             */ 
-            SubProjCombination& getSubProjCombination() { return m_subProjCombination; }
-
-            /** 
-             * Set the temporary merit of the node to be the given merit
-             * @param merit is the merit to assign to the node.
-             */ 
-            void setMeritTmp(MeritStorage merit) {m_meritTmp = merit; }
-
-            /** 
-             * Save the temporary merit in the m_meritMem field. 
-             */ 
-            void saveMerit() {m_meritMem = m_meritTmp; }
-
-            /** 
-             * Updates the combination of the merits of the subprojections (mothers). Note that for
-             * subprojections which also contain getMaxDimension(), the temporary merit is used
-             * whereas for other nodes, the stored merit is used. This allows component-by-component
-             * evaluation for several nets with a unique datastructure..
-             */ 
-            void updateSubProjCombination()
+            std::vector<unsigned int> active(nNets); // nets whose computation was not aborted
+            for(unsigned int i = 0; i < nNets; ++i)
             {
-                if (getCardinal() > 1)
+                active[i] = i;
+            }
+
+            std::vector<const AbstractDigitalNet*> activeNets;
+            std::vector<SubProjCombination> subProjCombinations;
+
+            const NodeIndex dimensionBegin = firstNode(dimension);
+            m_batchSize = nNets;
+            m_meritBatch.resize((size_t) (firstNode(dimension+1) - dimensionBegin) * nNets);
+
+            for(size_t l = m_firstLayer[dimension]; l < m_firstLayer[dimension+1] && !active.empty(); ++l) // for each layer
+            {
+                const Layer& layer = m_layers[l];
+                for(NodeIndex k = 0; k < layer.numNodes && !active.empty(); ++k)
                 {
-                    PROJDEP::setToZero(m_subProjCombination);
-                    for (auto const* m : m_mothersNodes)
+                    const NodeIndex node = layer.firstNode + k;
+                    Real weight = m_weights[node];
+
+                    activeNets.clear();
+                    subProjCombinations.resize(active.size());
+                    for(unsigned int i = 0; i < active.size(); ++i)
                     {
-                        if (m->getMaxDimension() < m_dimension)
+                        activeNets.push_back(nets[active[i]]);
+                        if (PROJDEP::size(subProjCombinations[i]) < nLevels) // resize the subprojections combination if required
                         {
-                            PROJDEP::update(m->getMeritMem(), m_subProjCombination);
+                            PROJDEP::resize(subProjCombinations[i], nLevels);
                         }
-                        else{
-                            PROJDEP::update(m->getMeritTmp(), m_subProjCombination);
-                        } 
+                        updateSubProjCombination(layer, k, dimensionBegin, subProjCombinations[i], active[i]); // update the subprojection combination
                     }
+
+                    const ProjectionView proj = projection(layer, k);
+
+                    auto grossMerits = m_figure->projDepMerit()(activeNets, proj, subProjCombinations); // compute the merits of the projection
+
+                    unsigned int nActive = 0;
+                    for(unsigned int i = 0; i < active.size(); ++i)
+                    {
+                        const unsigned int index = active[i];
+                        Real merit = m_figure->projDepMerit().combine(grossMerits[i], *nets[index], proj); // combine in a single merit value
+
+                        accs[index].accumulate(weight,merit,1);
+
+                        if (!onProgress()(accs[index].value()))  // if someone is listening, may tell that the computation is useless
+                        {
+                            accs[index].accumulate(std::numeric_limits<Real>::infinity(), merit, 1); // set the merit to infinity
+                            onAbort()(*nets[index]); // abort the computation
+                            continue;
+                        }
+
+                        meritBatch(node, dimensionBegin, index) = std::move(grossMerits[i]); // update the merit of the node
+                        active[nActive++] = index;
+                    }
+                    active.resize(nActive);
                 }
             }
 
-            /** 
-             * Overloads operator < to compare projections. A projection is smaller (less important) than another one if they have the same cardinal and its weight is smaller
-             * of if it has a strictly bigger cardinal.
-             */ 
-            bool operator>(const ProjectionNode &b) const
+            std::vector<MeritValue> res;
+            res.reserve(nNets);
+            for(const auto& acc : accs)
             {
-                return (getCardinal() == b.getCardinal()) ? 
-                            (getWeight() > b.getWeight()) : 
-                            (getCardinal() < b.getCardinal());
+                res.push_back(acc.value());
             }
+            return res;
+        }
 
-            /** 
-             * Comparison between pointers to nodes by dereferencing. Used to sort by decreasing importance.
-             */ 
-            static bool compareNodePointers(const ProjectionNode* a, const ProjectionNode* b){
-                return (*a > * b);
-            }
-                    
-            /** 
-             * Overloading of the << operator to print projection nodes.
-             */
-            friend std::ostream& operator<<(std::ostream& os, const ProjectionNode& dt)
+        /** Save the merits computed for the net at position \c index of the last batch, for all the nodes corresponding to the last dimension.
+         * @param index Position of the net in the last batch.
+         */ 
+        void saveBatchMerits(unsigned int index)
+        {
+            const NodeIndex dimensionBegin = firstNode(m_numCoordinates-1);
+            const NodeIndex dimensionEnd = firstNode(m_numCoordinates);
+            for(NodeIndex node = dimensionBegin; node < dimensionEnd; ++node)
             {
-                os << "projection: " << dt.getProjectionRepresentation() << " - weight: " << dt.getWeight();
-                return os;
+                m_meritMem[node] = meritBatch(node, dimensionBegin, index);
             }
+        }
 
-            double m_weight; // weight of the projection
-            Dimension m_dimension; // last dimension (highest coordinate in the projection)
-            unsigned int m_cardinal; // cardinal of the projection
+    private:
 
-            ProjectionNode* m_nextNode = nullptr; // pointer to the next projection to evaluate
-            std::vector<ProjectionNode*> m_mothersNodes; // pointers to the subprojections whose cardinal is one less
+        /** 
+         * Layer of the arena: projections with the same highest coordinate and the same cardinal. The nodes of a layer are contiguous,
+         * and so are their coordinates and their subprojections: node \c k of the layer has its coordinates and its subprojections
+         * in the \c cardinal entries of \c m_coordinates and \c m_mothers starting at <code>firstItem + k * cardinal</code>.
+         */ 
+        struct Layer
+        {
+            unsigned int cardinal; // cardinal of the projections
+            NodeIndex firstNode; // index of the first node of the layer
+            NodeIndex numNodes; // number of nodes in the layer
+            size_t firstItem; // index of the coordinates and of the subprojections of the first node of the layer
+        };
 
-            SubProjCombination m_subProjCombination; // combination of the merits of the subprojections
+        /** 
+         * Returns the index of the first node of \c dimension. For <code>dimension == m_maxNumCoordinates</code>, returns the number of nodes.
+         * @param dimension Dimension.
+         */ 
+        NodeIndex firstNode(Dimension dimension) const { return m_firstNode[dimension]; }
 
-            MeritStorage m_meritMem; // stored merit
-            MeritStorage m_meritTmp; // temporay merit
+        /** 
+         * Returns the projection represented by node \c k of \c layer.
+         */ 
+        ProjectionView projection(const Layer& layer, NodeIndex k) const
+        {
+            return ProjectionView(&m_coordinates[layer.firstItem + (size_t) k * layer.cardinal], layer.cardinal);
+        }
 
-            void accumulateProjectionRepresentation(LatticeTester::Coordinates& projection) const
+        /** 
+         * Returns the merit of \c node for the net at position \c index of the last batch.
+         * @param node Node of the last dimension.
+         * @param dimensionBegin First node of the last dimension.
+         * @param index Position of the net in the batch.
+         */ 
+        MeritStorage& meritBatch(NodeIndex node, NodeIndex dimensionBegin, unsigned int index)
+        {
+            return m_meritBatch[(size_t) (node - dimensionBegin) * m_batchSize + index];
+        }
+
+        /** 
+         * Computes in \c subProjCombination the combination of the merits of the subprojections (mothers) of node \c k of \c layer. Note that
+         * for subprojections which also contain the highest coordinate, the temporary merit is used whereas for other nodes,
+         * the stored merit is used. This allows component-by-component evaluation for several nets with a unique datastructure.
+         * @param layer Layer of the node.
+         * @param k Position of the node in the layer.
+         * @param dimensionBegin First node of the dimension of the layer.
+         * @param subProjCombination Combination of merit to update.
+         */ 
+        void updateSubProjCombination(const Layer& layer, NodeIndex k, NodeIndex dimensionBegin, SubProjCombination& subProjCombination) const
+        {
+            PROJDEP::setToZero(subProjCombination);
+            if (layer.cardinal > 1)
             {
-                projection.insert(m_dimension);
-                if(m_cardinal>1)
+                const size_t first = layer.firstItem + (size_t) k * layer.cardinal;
+                for(size_t i = first; i < first + layer.cardinal; ++i)
                 {
-                    m_mothersNodes[0]->accumulateProjectionRepresentation(projection);
+                    const NodeIndex m = m_mothers[i];
+                    PROJDEP::update((m < dimensionBegin) ? m_meritMem[m] : m_meritTmp[m], subProjCombination);
                 }
             }
-        };
+        }
 
         /** 
-         * Extends by one dimension the evaluator. This creates new nodes corresponding to the new projections to consider
-         * while evaluating figures of merits.
+         * Computes in \c subProjCombination the combination of the merits of the subprojections for the net at position \c index
+         * of the batch. As for the sequential evaluation, the merits of the batch are used for subprojections which also contain
+         * the highest coordinate whereas the stored merits are used for the other nodes.
+         * @param layer Layer of the node.
+         * @param k Position of the node in the layer.
+         * @param dimensionBegin First node of the dimension of the layer.
+         * @param subProjCombination Combination of merit to update.
+         * @param index Position of the net in the batch.
          */ 
-        void extend(){
-            ++m_maxNumCoordinates; // increase maximal number of coordinates
-            std::vector<ProjectionNode*> newNodes; // to store new nodes
+        void updateSubProjCombination(const Layer& layer, NodeIndex k, NodeIndex dimensionBegin, SubProjCombination& subProjCombination, unsigned int index)
+        {
+            PROJDEP::setToZero(subProjCombination);
+            if (layer.cardinal > 1)
+            {
+                const size_t first = layer.firstItem + (size_t) k * layer.cardinal;
+                for(size_t i = first; i < first + layer.cardinal; ++i)
+                {
+                    const NodeIndex m = m_mothers[i];
+                    PROJDEP::update((m < dimensionBegin) ? m_meritMem[m] : meritBatch(m, dimensionBegin, index), subProjCombination);
+                }
+            }
+        }
+
+        /** 
+         * Computes the figure of merit for the given \c net for the given \c dimension using several threads.
+         * The layers of projections with the same cardinal are evaluated one after the other, the projections
+         * of a layer being independent of each other once the merits of the previous layer are known.
+         * The threads are started once for all the layers and wait for each other at the end of each layer.
+         * The threads share an accumulator used to abort the computation as soon as possible. The returned value
+         * is accumulated in the order of the projections, as by the sequential evaluation.
+         * @param net Net to evaluate.
+         * @param dimension Dimension to compute.
+         * @param initialValue Initial value of the merit.
+         */ 
+        MeritValue evaluateInParallel(const AbstractDigitalNet& net, Dimension dimension, MeritValue initialValue)
+        {
+            unsigned int nLevels = PROJDEP::numLevels(net); // determine the number of levels
 
-            std::map<LatticeTester::Coordinates,ProjectionNode*> mapsToNodes; // map between new projections and new nodes
+            auto acc = m_figure->accumulator(initialValue);
 
-            // create projection {m_numCoordinates} 
-            LatticeTester::Coordinates proj1DRep;
-            proj1DRep.insert(m_maxNumCoordinates-1);
-            double weight = m_figure->weights().getWeight(proj1DRep);
-            ProjectionNode* proj1D = new ProjectionNode(m_maxNumCoordinates-1, (unsigned int) proj1DRep.size(), weight);
+            const NodeIndex dimensionBegin = firstNode(dimension);
+            const size_t firstLayer = m_firstLayer[dimension];
+            const size_t lastLayer = m_firstLayer[dimension+1];
+            if (firstLayer == lastLayer)
+            {
+                return acc.value();
+            }
 
-            if(m_maxNumCoordinates==1){
-                m_roots.push_back(proj1D);
-                return;
+            NodeIndex maxNumNodes = 0;
+            for(size_t l = firstLayer; l < lastLayer; ++l)
+            {
+                maxNumNodes = std::max(maxNumNodes, m_layers[l].numNodes);
             }
+            const unsigned int nThreads = std::min(m_nThreads, maxNumNodes);
+
+            std::atomic<Real> sharedValue(initialValue); // value accumulated by all the threads, in any order
+            std::atomic<bool> aborted(false);
+            std::vector<Real> merits(maxNumNodes); // merits of the projections of the current layer
+            std::atomic<NodeIndex> nextNode(0); // next node of the current layer
+
+            std::mutex mutex; // protects the following variables
+            std::condition_variable layerDone;
+            unsigned int nArrived = 0; // number of threads done with the current layer
+            size_t currentLayer = firstLayer;
+            bool over = false; // whether the threads must stop after the current layer
+
+            // waits for all the threads to be done with the current layer; the last thread accumulates the merits of the layer
+            // in the order of the projections and prepares the next layer
+            auto endLayer = [&] ()
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                const size_t layerIndex = currentLayer;
+                if (++nArrived == nThreads)
+                {
+                    const Layer& layer = m_layers[layerIndex];
+                    if (!aborted)
+                    {
+                        for(NodeIndex k = 0; k < layer.numNodes; ++k)
+                        {
+                            acc.accumulate(m_weights[layer.firstNode + k], merits[k], 1);
+                        }
+                    }
+                    nArrived = 0;
+                    nextNode = 0;
+                    over = aborted || layerIndex + 1 == lastLayer;
+                    ++currentLayer;
+                    layerDone.notify_all();
+                }
+                else
+                {
+                    layerDone.wait(lock, [&] () { return currentLayer != layerIndex; });
+                }
+                return over;
+            };
 
-            newNodes.push_back(proj1D);
+            auto task = [this, &net, dimensionBegin, &merits, &nextNode, &sharedValue, &aborted, nLevels, firstLayer, &endLayer] ()
+            {
+                auto localAcc = m_figure->accumulator(0); // used to apply the accumulation operation to the shared value
+                SubProjCombination subProjCombination;
+                PROJDEP::resize(subProjCombination, nLevels);
+                std::exception_ptr error;
+                for(size_t l = firstLayer; ; ++l) // for each layer, until endLayer() tells to stop
+                {
+                    const Layer& layer = m_layers[l];
+                    try
+                    {
+                        NodeIndex k;
+                        while (!aborted.load() && (k = nextNode.fetch_add(1)) < layer.numNodes)
+                        {
+                            const NodeIndex node = layer.firstNode + k;
 
-            mapsToNodes.insert(std::pair<LatticeTester::Coordinates,ProjectionNode*>(std::move(proj1DRep),proj1D));
+                            updateSubProjCombination(layer, k, dimensionBegin, subProjCombination); // update the subprojection combination
 
+                            const ProjectionView proj = projection(layer, k);
 
-            for(unsigned int i = 0; i < m_maxNumCoordinates-1; ++i) // for each previous dimensions
-            {
-                ProjectionNode* it = m_roots[i];
-                do
-                {   if (it->getCardinal() <= m_maxCardinal-1)
+                            auto grossMerit = m_figure->projDepMerit()(net, proj, subProjCombination); // compute the merit of the projection
+
+                            merits[k] = m_figure->projDepMerit().combine(grossMerit, net, proj); // combine in a single merit value
+
+                            m_meritTmp[node] = std::move(grossMerit); // update the merit of the node
+
+                            Real expected = sharedValue.load();
+                            Real desired;
+                            do
+                            {
+                                localAcc.set(expected);
+                                desired = localAcc.tryAccumulate(m_weights[node], merits[k], 1);
+                            }
+                            while (!sharedValue.compare_exchange_weak(expected, desired));
+
+                            if (!onProgress()(desired))  // if someone is listening, may tell that the computation is useless
+                            {
+                                aborted = true;
+                            }
+                        }
+                    }
+                    catch (...)
                     {
-                        LatticeTester::Coordinates projectionRep = it->getProjectionRepresentation(); // consider the projection
-                        projectionRep.insert(m_maxNumCoordinates-1);
-                        double weight =  m_figure->weights().getWeight(projectionRep);
-                        ProjectionNode* newNode = new ProjectionNode(m_maxNumCoordinates-1, (unsigned int) projectionRep.size() , weight); // create the node
-                        newNode->addMother(it);
-                        mapsToNodes.insert(std::pair<LatticeTester::Coordinates,ProjectionNode*>(std::move(projectionRep),newNode));
-                        newNodes.push_back(newNode);
+                        error = std::current_exception();
+                        aborted = true; // the other threads stop at the end of the layer
                     }
-                    it = it->getNextNode();
+                    if (endLayer())
+                    {
+                        break;
+                    }
+                }
+                if (error)
+                {
+                    std::rethrow_exception(error);
                 }
-                while(it != nullptr);
+            };
+
+            runConcurrently(task, nThreads, aborted);
+
+            if (aborted)
+            {
+                acc.set(std::numeric_limits<Real>::infinity()); // set the merit to infinity
+                onAbort()(net); // abort the computation
             }
 
-            std::sort(newNodes.begin(), newNodes.end(), ProjectionNode::compareNodePointers); // sort the nodes by increasing cardinal and decreasing weights
+            return acc.value();
+        }
 
-            m_roots.push_back(newNodes[0]); // add the root corresponding to the dimension
+        /** 
+         * Runs \c task on \c nThreads threads, including the calling thread, and waits for all of them. If a thread 
+         * throws, \c aborted is set so that the other threads stop as soon as possible and the exception is rethrown.
+         * @param task Task to run.
+         * @param nThreads Number of threads.
+         * @param aborted Flag telling the threads to stop.
+         */ 
+        template <typename TASK>
+        static void runConcurrently(TASK& task, unsigned int nThreads, std::atomic<bool>& aborted)
+        {
+            std::vector<std::exception_ptr> errors(nThreads);
+            auto guardedTask = [&task, &errors, &aborted] (unsigned int t)
+            {
+                try
+                {
+                    task();
+                }
+                catch (...)
+                {
+                    errors[t] = std::current_exception();
+                    aborted = true;
+                }
+            };
 
-            for(size_t i = 0; i < newNodes.size()-1; ++i)
+            std::vector<std::thread> threads;
+            for(unsigned int t = 1; t < nThreads; ++t)
             {
-                newNodes[i]->setNextNode(newNodes[i+1]); // link the new nodes
+                threads.emplace_back(guardedTask, t);
+            }
+            guardedTask(0);
+            for(auto& thread : threads)
+            {
+                thread.join();
             }
 
-            for (ProjectionNode* node : newNodes) // for each new nodes
-            {   
-                LatticeTester::Coordinates tmp = node->getProjectionRepresentation();
-                for(unsigned int i = 0; i < m_maxNumCoordinates-1; ++i) // link to mothers which contains m_numCoordinates
+            for(const auto& error : errors)
+            {
+                if (error)
                 {
-                    if (tmp.find(i) != tmp.end())
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+
+        /** 
+         * Returns the rank of the sorted coordinates \c coords in the colexicographic order of the subsets with \c size elements,
+         * using the combinatorial number system.
+         * @param coords Pointer to the sorted coordinates.
+         * @param size Number of coordinates.
+         * @param binomials Table of the binomial coefficients, <code>binomials[k][n]</code> being n choose k.
+         * @param skip Position of a coordinate to ignore, or \c size to use all the coordinates.
+         */ 
+        static size_t colexRank(const unsigned int* coords, unsigned int size, const std::vector<std::vector<size_t>>& binomials, unsigned int skip)
+        {
+            size_t rank = 0;
+            unsigned int k = 1;
+            for(unsigned int i = 0; i < size; ++i)
+            {
+                if (i != skip)
+                {
+                    rank += binomials[k++][coords[i]];
+                }
+            }
+            return rank;
+        }
+
+        /** 
+         * Extends by one dimension the evaluator. This creates new nodes corresponding to the new projections to consider
+         * while evaluating figures of merits, that is the projections whose highest coordinate is the new coordinate \c d.
+         * A projection of cardinal \c c is the union of \c d and of a subset of previous coordinates with <code>c-1</code> elements. These
+         * subsets are indexed by their rank in the combinatorial number system, which allows to find the subprojections
+         * without searching for them.
+         */ 
+        void extend(){
+            const unsigned int d = (unsigned int) m_maxNumCoordinates; // new coordinate
+            const unsigned int maxCardinal = std::min(d + 1, m_maxCardinal);
+            ++m_maxNumCoordinates; // increase maximal number of coordinates
+
+            std::vector<std::vector<size_t>> binomials(maxCardinal, std::vector<size_t>(d + 1, 0)); // binomials[k][n] is n choose k
+            for(unsigned int n = 0; n <= d; ++n)
+            {
+                binomials[0][n] = 1;
+                for(unsigned int k = 1; k < maxCardinal && k <= n; ++k)
+                {
+                    binomials[k][n] = binomials[k-1][n-1] + ((k < n) ? binomials[k][n-1] : 0);
+                }
+            }
+
+            std::vector<NodeIndex> withoutNewCoordinate; // node of each subset of previous coordinates, indexed by rank
+            std::vector<Real> weights; // weight of each new projection, indexed by rank
+            std::vector<NodeIndex> order; // ranks sorted by decreasing weight
+            std::vector<NodeIndex> previousLayerNodes; // node of each projection of the previous layer of the new dimension, indexed by rank
+            std::vector<NodeIndex> layerNodes;
+
+            for(unsigned int cardinal = 1; cardinal <= maxCardinal; ++cardinal) // for each new layer
+            {
+                const size_t numNodes = binomials[cardinal-1][d];
+                if (m_weights.size() + numNodes > std::numeric_limits<NodeIndex>::max())
+                {
+                    throw std::runtime_error("In projection-dependent figure of merit evaluator: too many projections.");
+                }
+
+                // find the nodes of the projections without the new coordinate, which have cardinal-1 coordinates
+                withoutNewCoordinate.assign(numNodes, 0);
+                for(Dimension dim = 0; cardinal > 1 && dim < d; ++dim)
+                {
+                    if (m_firstLayer[dim] + cardinal - 2 < m_firstLayer[dim+1])
                     {
-                        tmp.erase(i);
-                        auto foo = mapsToNodes.find(tmp)->second;
-                        node->addMother(foo);
-                        tmp.insert(i);
+                        const Layer& layer = m_layers[m_firstLayer[dim] + cardinal - 2];
+                        for(NodeIndex k = 0; k < layer.numNodes; ++k)
+                        {
+                            const unsigned int* coords = &m_coordinates[layer.firstItem + (size_t) k * layer.cardinal];
+                            withoutNewCoordinate[colexRank(coords, layer.cardinal, binomials, layer.cardinal)] = layer.firstNode + k;
+                        }
+                    }
+                }
+
+                // compute the weights of the new projections
+                weights.resize(numNodes);
+                for(size_t rank = 0; rank < numNodes; ++rank)
+                {
+                    LatticeTester::Coordinates projectionRep;
+                    if (cardinal > 1)
+                    {
+                        const Layer& motherLayer = layerOf(withoutNewCoordinate[rank]);
+                        projectionRep = projection(motherLayer, withoutNewCoordinate[rank] - motherLayer.firstNode).toCoordinates();
                     }
+                    projectionRep.insert(d);
+                    weights[rank] = m_figure->weights().getWeight(projectionRep);
                 }
+
+                order.resize(numNodes);
+                std::iota(order.begin(), order.end(), 0);
+                std::stable_sort(order.begin(), order.end(), [&weights](NodeIndex a, NodeIndex b) { return weights[a] > weights[b]; }); // sort the nodes by decreasing weights
+
+                Layer layer;
+                layer.cardinal = cardinal;
+                layer.firstNode = (NodeIndex) m_weights.size();
+                layer.numNodes = (NodeIndex) numNodes;
+                layer.firstItem = m_coordinates.size();
+                m_layers.push_back(layer);
+
+                layerNodes.resize(numNodes);
+                for(NodeIndex k = 0; k < numNodes; ++k)
+                {
+                    layerNodes[order[k]] = layer.firstNode + k;
+                }
+
+                m_coordinates.resize(layer.firstItem + numNodes * cardinal);
+                m_mothers.resize(layer.firstItem + numNodes * cardinal, 0);
+                for(NodeIndex k = 0; k < numNodes; ++k)
+                {
+                    const NodeIndex rank = order[k];
+                    const size_t item = layer.firstItem + (size_t) k * cardinal;
+                    m_weights.push_back(weights[rank]);
+                    m_coordinates[item + cardinal - 1] = d;
+                    if (cardinal > 1)
+                    {
+                        const NodeIndex mother = withoutNewCoordinate[rank];
+                        const Layer& motherLayer = layerOf(mother);
+                        const unsigned int* coords = &m_coordinates[motherLayer.firstItem + (size_t) (mother - motherLayer.firstNode) * motherLayer.cardinal];
+                        std::copy(coords, coords + cardinal - 1, &m_coordinates[item]);
+
+                        m_mothers[item] = mother; // subprojection without the new coordinate
+                        for(unsigned int i = 0; i < cardinal - 1; ++i) // subprojections with the new coordinate
+                        {
+                            m_mothers[item + i + 1] = previousLayerNodes[colexRank(&m_coordinates[item], cardinal - 1, binomials, i)];
+                        }
+                    }
+                }
+                std::swap(previousLayerNodes, layerNodes);
             }
+
+            m_firstLayer.push_back(m_layers.size());
+            m_firstNode.push_back((NodeIndex) m_weights.size());
+            m_meritMem.resize(m_weights.size());
+            m_meritTmp.resize(m_weights.size());
+        }
+
+        /** 
+         * Returns the layer of \c node.
+         */ 
+        const Layer& layerOf(NodeIndex node) const
+        {
+            auto it = std::upper_bound(m_layers.begin(), m_layers.end(), node, [](NodeIndex n, const Layer& layer) { return n < layer.firstNode; });
+            return *(it - 1);
         }
 
         /** Save the merits of all the nodes corresponding to the \c dimension.
          * @param dimension Dimension of the nodes.
-         */  
+         */ 
         void saveMerits(Dimension dimension)
         {
-            ProjectionNode* it = m_roots[dimension];
-            do
+            const NodeIndex dimensionEnd = firstNode(dimension+1);
+            for(NodeIndex node = firstNode(dimension); node < dimensionEnd; ++node)
             {
-                it->saveMerit();
-                it = it->getNextNode();
+                m_meritMem[node] = m_meritTmp[node];
             }
-            while(it != nullptr);
         }
 
         /** 
@@ -417,9 +768,20 @@ class ProjectionDependentEvaluator : public CBCFigureOfMeritEvaluator
         Dimension m_numCoordinates; 
         Dimension m_maxNumCoordinates;
         unsigned int m_maxCardinal; 
-        std::vector<ProjectionNode*> m_roots; // pointer to the first node of each layer (one by dimension)
+        unsigned int m_nThreads; // number of threads used to evaluate the projections of a net
+
+        std::vector<Layer> m_layers; // layers of all the dimensions, by increasing dimension and cardinal
+        std::vector<size_t> m_firstLayer; // index of the first layer of each dimension, followed by the number of layers
+        std::vector<NodeIndex> m_firstNode; // index of the first node of each dimension, followed by the number of nodes
+        std::vector<Real> m_weights; // weight of each node
+        std::vector<unsigned int> m_coordinates; // coordinates of each node, in increasing order
+        std::vector<NodeIndex> m_mothers; // subprojections whose cardinal is one less of each node, the first one not containing the highest coordinate
+        std::vector<MeritStorage> m_meritMem; // stored merit of each node
+        std::vector<MeritStorage> m_meritTmp; // temporary merit of each node
+        std::vector<MeritStorage> m_meritBatch; // merits of the nodes of the last dimension for each net of the last batch
+        unsigned int m_batchSize; // number of nets in the last batch
 };
 
 }}
 
-#endif
\ No newline at end of file
+#endif
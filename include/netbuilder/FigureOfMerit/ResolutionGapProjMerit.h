@@ -76,11 +76,41 @@ class ResolutionGapProjMerit<EmbeddingType::UNILEVEL>
          * @param projection Projection to use.
          */ 
         Real operator()(const AbstractDigitalNet& net , const LatticeTester::Coordinates& projection) 
+        {
+            // the rank computers are reused between calls, with one per thread since CBC evaluators may run concurrently
+            if (net.hasPackedGeneratingMatrices())
+            {
+                static thread_local PackedRankComputer packedRankComputer;
+                return computeMerit(packedRankComputer, net, projection, [&net](Dimension coord, unsigned int row){ return net.packedGeneratingMatrix(coord)[row]; });
+            }
+            static thread_local RankComputer rankComputer;
+            return computeMerit(rankComputer, net, projection, [&net](Dimension coord, unsigned int row){ return net.generatingMatrix(coord)[row]; });
+        }
+
+        /** 
+         * Returns the projections to include in the figure of merit partial computation for dimension \c dimension.
+         * @param dimension Dimension of the partial computation.
+         */ 
+        CBCCoordinateSet projections(Dimension dimension) const
+        {
+            return CBCCoordinateSet(dimension, m_maxCardinal);
+        }
+
+    private:
+        /** 
+         * Computes the merit using the rank computer \c rankComputer.
+         * @param rankComputer Rank computer to use.
+         * @param net Digital to evaluate.
+         * @param projection Projection to use.
+         * @param getRow Function returning the row of given index of the generating matrix of a given coordinate.
+         */ 
+        template <typename RANK_COMPUTER, typename GET_ROW>
+        static Real computeMerit(RANK_COMPUTER& rankComputer, const AbstractDigitalNet& net , const LatticeTester::Coordinates& projection, GET_ROW getRow)
         {
             Dimension dimension = projection.size();
             unsigned int numCols = net.numColumns();
 
-            m_rankComputer.reset(numCols);
+            rankComputer.reset(numCols);
 
             unsigned int maxResolution = numCols/dimension;
             unsigned int merit = maxResolution; 
@@ -88,9 +118,9 @@ class ResolutionGapProjMerit<EmbeddingType::UNILEVEL>
             {
                 for(auto coord : projection)
                 {
-                    m_rankComputer.addRow(net.generatingMatrix(coord).subMatrix(resolution, 0, 1,numCols));
+                    rankComputer.addRow(getRow(coord, resolution));
                 }
-                if(m_rankComputer.computeRank() == m_rankComputer.numRows())
+                if(rankComputer.computeRank() == rankComputer.numRows())
                 {
                     --merit;
                 }
@@ -102,18 +132,7 @@ class ResolutionGapProjMerit<EmbeddingType::UNILEVEL>
             return  merit;
         }
 
-        /** 
-         * Returns the projections to include in the figure of merit partial computation for dimension \c dimension.
-         * @param dimension Dimension of the partial computation.
-         */ 
-        CBCCoordinateSet projections(Dimension dimension) const
-        {
-            return CBCCoordinateSet(dimension, m_maxCardinal);
-        }
-
-    private:
         unsigned int m_maxCardinal; // maximum order of subprojections to take into account
-        RankComputer m_rankComputer; // use to compute the rank of matrices
 };
 
 /** Template specialization of the projection-dependent merit defined by the resolution-gap of the projection
@@ -160,13 +179,58 @@ class ResolutionGapProjMerit<EmbeddingType::MULTILEVEL>
          * @param projection Projection to use.
          */ 
         Real operator()(const AbstractDigitalNet& net , const LatticeTester::Coordinates& projection) 
+        {
+            // the rank computers are reused between calls, with one per thread since CBC evaluators may run concurrently
+            if (net.hasPackedGeneratingMatrices())
+            {
+                static thread_local PackedRankComputer packedRankComputer;
+                return combine(computeMerits(packedRankComputer, net, projection, [&net](Dimension coord, unsigned int row){ return net.packedGeneratingMatrix(coord)[row]; }));
+            }
+            static thread_local RankComputer rankComputer;
+            return combine(computeMerits(rankComputer, net, projection, [&net](Dimension coord, unsigned int row){ return net.generatingMatrix(coord)[row]; }));
+        }
+
+
+        /** 
+         * Returns the projections to include in the figure of merit partial computation for dimension \c dimension.
+         * @param dimension Dimension of the partial computation.
+         */ 
+        CBCCoordinateSet projections(Dimension dimension) const
+        {
+            return CBCCoordinateSet(dimension, m_maxCardinal);
+        }
+
+        /** 
+         * Combines the vector of multilevel merits into a single value merit.
+         * @param merits Multilevel merits to combine.
+         */ 
+        Real combine(const std::vector<unsigned int>& merits)
+        {
+            RealVector tmp(merits.size());
+            for(unsigned int i = 0; i < merits.size(); ++i)
+            {
+                tmp[i] = merits[i];
+            }
+            return (*m_combiner)(std::move(tmp));
+        }
+
+    private:
+        /** 
+         * Computes the multilevel merits using the rank computer \c rankComputer.
+         * @param rankComputer Rank computer to use.
+         * @param net Digital to evaluate.
+         * @param projection Projection to use.
+         * @param getRow Function returning the row of given index of the generating matrix of a given coordinate.
+         */ 
+        template <typename RANK_COMPUTER, typename GET_ROW>
+        static std::vector<unsigned int> computeMerits(RANK_COMPUTER& rankComputer, const AbstractDigitalNet& net , const LatticeTester::Coordinates& projection, GET_ROW getRow)
         {
             Dimension dimension = projection.size();
 
             unsigned int numRows = net.numRows();
             unsigned int numCols = net.numColumns();
 
-            m_rankComputer.reset(numCols);
+            rankComputer.reset(numCols);
 
             std::vector<unsigned int> merits(numRows);
 
@@ -181,52 +245,26 @@ class ResolutionGapProjMerit<EmbeddingType::MULTILEVEL>
             {
                 for(auto coord : projection)
                 {
-                    m_rankComputer.addRow(net.generatingMatrix(coord).subMatrix(resolution, 0,  1, numCols));
+                    rankComputer.addRow(getRow(coord, resolution));
                 }
-                std::vector<unsigned int> ranks = m_rankComputer.computeRanks(0,numCols);
+                std::vector<unsigned int> ranks = rankComputer.computeRanks(0,numCols);
                 for(unsigned int m = 1; m <= numCols; ++m)
                 {
-                    if (ranks[m-1] == m_rankComputer.numRows())
+                    if (ranks[m-1] == rankComputer.numRows())
                     {
                         --merits[m-1];
                     }
                 }
-                if (ranks[numCols-1] <  m_rankComputer.numRows())
+                if (ranks[numCols-1] <  rankComputer.numRows())
                 {
                     break;
                 }
             }
-            return combine(merits);
-        }
-
-
-        /** 
-         * Returns the projections to include in the figure of merit partial computation for dimension \c dimension.
-         * @param dimension Dimension of the partial computation.
-         */ 
-        CBCCoordinateSet projections(Dimension dimension) const
-        {
-            return CBCCoordinateSet(dimension, m_maxCardinal);
-        }
-
-        /** 
-         * Combines the vector of multilevel merits into a single value merit.
-         * @param merits Multilevel merits to combine.
-         */ 
-        Real combine(const std::vector<unsigned int>& merits)
-        {
-            RealVector tmp(merits.size());
-            for(unsigned int i = 0; i < merits.size(); ++i)
-            {
-                tmp[i] = merits[i];
-            }
-            return (*m_combiner)(std::move(tmp));
+            return merits;
         }
 
-    private:
         unsigned int m_maxCardinal; // maximum order of subprojections to take into account 
         pCombiner m_combiner; 
-        RankComputer m_rankComputer;
 };
 
 }}
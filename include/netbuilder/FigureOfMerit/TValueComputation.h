@@ -23,14 +23,76 @@
 #define NETBUILDER__TVALUE_COMPUTATION_H
 
 #include "netbuilder/GeneratingMatrix.h"
+#include "netbuilder/PackedGeneratingMatrix.h"
+
+#include <vector>
 
 namespace NetBuilder {
 
+    /**
+     * Non-owning view of a sequence of generating matrices, for instance the generating matrices of the coordinates
+     * of a projection of a net. Allows to compute t-values without copying the matrices.
+     * @tparam MATRIX Type of the matrices.
+     */
+    template <typename MATRIX>
+    class MatricesView
+    {
+        public:
+            /**
+             * Constructor.
+             * @param matrices Pointers to the matrices.
+             * @param size Number of matrices.
+             */
+            MatricesView(const MATRIX* const* matrices, size_t size):
+                m_matrices(matrices),
+                m_size(size)
+            {}
+
+            /**
+             * Constructor.
+             * @param matrices Pointers to the matrices. Must outlive the view.
+             */
+            MatricesView(const std::vector<const MATRIX*>& matrices):
+                MatricesView(matrices.data(), matrices.size())
+            {}
+
+            /**
+             * Returns the number of matrices.
+             */
+            size_t size() const { return m_size; }
+
+            /**
+             * Returns the matrix at position \c i.
+             */
+            const MATRIX& operator[](size_t i) const { return *m_matrices[i]; }
+
+        private:
+            const MATRIX* const* m_matrices; // pointers to the matrices
+            size_t m_size; // number of matrices
+    };
+
+    /**
+     * Returns pointers to the matrices of \c matrices, which can be viewed by a MatricesView.
+     * @param matrices Matrices.
+     */
+    template <typename MATRIX>
+    std::vector<const MATRIX*> pointersTo(const std::vector<MATRIX>& matrices)
+    {
+        std::vector<const MATRIX*> res;
+        res.reserve(matrices.size());
+        for (const auto& mat : matrices)
+        {
+            res.push_back(&mat);
+        }
+        return res;
+    }
+
     /**
      * Class to compute the t-value of a projection of a digital net in base 2.
      * This class uses a refined version of the gaussian elimination to compute efficiently the t-value of
      * a projection, knowing the t-value of the smaller projections. 
      * The algorithm is described in \cite rMAR20a.
+     * Matrices with at most 64 columns are handled with the word-packed representation PackedGeneratingMatrix.
      */  
     struct GaussMethod
     {
@@ -65,12 +127,96 @@ namespace NetBuilder {
          * @param verbose Verbosity level.
          */ 
         static std::vector<unsigned int> computeTValue(std::vector<GeneratingMatrix> baseMatrices, unsigned int mMin, const std::vector<unsigned int>& maxTValuesSubProj, int verbose);
+
+        /**
+         * Compute the t-value corresponding to the packed generating matrices \c baseMatrices, using the prior knowledge that the maximum of the
+         * t-values of the subprojections is \c maxTValuesSubProj.
+         * @param baseMatrices Packed generating matrices.
+         * @param maxTValuesSubProj Maximum of the t-value of the subprojections.
+         * @param verbose Verbosity level.
+         */ 
+        static unsigned int computeTValue(std::vector<PackedGeneratingMatrix> baseMatrices, unsigned int maxTValuesSubProj, int verbose);
+
+        /**
+         * Compute the t-value corresponding to the packed generating matrices \c baseMatrices, for each level, using the prior knowledge that the maximum of the
+         * t-values of the subprojections, for each level \c i is \c maxTValuesSubProj[i].
+         * @param baseMatrices Packed generating matrices.
+         * @param maxTValuesSubProj Maximum of the t-value of the subprojections.
+         * @param verbose Verbosity level.
+         */ 
+        static std::vector<unsigned int> computeTValue(std::vector<PackedGeneratingMatrix> baseMatrices, const std::vector<unsigned int>& maxTValuesSubProj, int verbose)
+        {
+            return computeTValue(std::move(baseMatrices), 0, maxTValuesSubProj, verbose);
+        };
+
+        /**
+         * Compute the t-value corresponding to the packed generating matrices \c baseMatrices, for each level greater or equal to \c mMin.
+         * @see computeTValue(std::vector<GeneratingMatrix>, unsigned int, const std::vector<unsigned int>&, int)
+         * @param baseMatrices Packed generating matrices.
+         * @param mMin Minimul level.
+         * @param maxTValuesSubProj Maximum of the t-value of the subprojections.
+         * @param verbose Verbosity level.
+         */ 
+        static std::vector<unsigned int> computeTValue(std::vector<PackedGeneratingMatrix> baseMatrices, unsigned int mMin, const std::vector<unsigned int>& maxTValuesSubProj, int verbose);
+
+        /**
+         * Compute the t-value corresponding to the generating matrices viewed by \c baseMatrices, without copying them.
+         * @see computeTValue(std::vector<GeneratingMatrix>, unsigned int, int)
+         * @param baseMatrices Generating matrices.
+         * @param maxTValuesSubProj Maximum of the t-value of the subprojections.
+         * @param verbose Verbosity level.
+         */ 
+        static unsigned int computeTValue(const MatricesView<GeneratingMatrix>& baseMatrices, unsigned int maxTValuesSubProj, int verbose);
+
+        /**
+         * Compute the t-value corresponding to the generating matrices viewed by \c baseMatrices, for each level, without copying them.
+         * @see computeTValue(std::vector<GeneratingMatrix>, const std::vector<unsigned int>&, int)
+         * @param baseMatrices Generating matrices.
+         * @param maxTValuesSubProj Maximum of the t-value of the subprojections.
+         * @param verbose Verbosity level.
+         */ 
+        static std::vector<unsigned int> computeTValue(const MatricesView<GeneratingMatrix>& baseMatrices, const std::vector<unsigned int>& maxTValuesSubProj, int verbose);
+
+        /**
+         * Compute the t-value corresponding to the packed generating matrices viewed by \c baseMatrices, without copying them.
+         * @see computeTValue(std::vector<PackedGeneratingMatrix>, unsigned int, int)
+         * @param baseMatrices Packed generating matrices.
+         * @param maxTValuesSubProj Maximum of the t-value of the subprojections.
+         * @param verbose Verbosity level.
+         */ 
+        static unsigned int computeTValue(const MatricesView<PackedGeneratingMatrix>& baseMatrices, unsigned int maxTValuesSubProj, int verbose);
+
+        /**
+         * Compute the t-value corresponding to the packed generating matrices viewed by \c baseMatrices, for each level, without copying them.
+         * @see computeTValue(std::vector<PackedGeneratingMatrix>, const std::vector<unsigned int>&, int)
+         * @param baseMatrices Packed generating matrices.
+         * @param maxTValuesSubProj Maximum of the t-value of the subprojections.
+         * @param verbose Verbosity level.
+         */ 
+        static std::vector<unsigned int> computeTValue(const MatricesView<PackedGeneratingMatrix>& baseMatrices, const std::vector<unsigned int>& maxTValuesSubProj, int verbose);
+
+        /// Maximal number of projections handled at once by computeTValues().
+        static constexpr unsigned int batchSize = 64;
+
+        /**
+         * Computes at once the t-values of at most batchSize projections whose generating matrices are the same,
+         * except the matrix of the last coordinate.
+         * The rows of the last matrices are bit-sliced (each word contains one element for each projection), so that
+         * the reduction of the rows of the common matrices is shared by all the projections.
+         * The results are the same as the ones of computeTValue(std::vector<PackedGeneratingMatrix>, unsigned int, int).
+         * All the matrices must be square.
+         * @param commonMatrices Generating matrices of the coordinates common to all the projections.
+         * @param lastMatrices Generating matrix of the last coordinate of each projection.
+         * @param maxTValuesSubProj Maximum of the t-value of the subprojections of each projection.
+         */ 
+        static std::vector<unsigned int> computeTValues(const MatricesView<PackedGeneratingMatrix>& commonMatrices, const MatricesView<PackedGeneratingMatrix>& lastMatrices, const std::vector<unsigned int>& maxTValuesSubProj);
     };
 
     /**
      * Class to compute the t-value of a projection of a digital net in base 2.
      * This class uses the algorithm described in \cite rSCH99a, which consists, for each compositions of matrices, in enumerating all the combinations of the rows of the rows in the
      * Gray code order, looking for a linear dependence between the columns.
+     * Matrices with at most 64 columns are handled with the word-packed representation PackedGeneratingMatrix.
      */  
     struct SchmidMethod
     {
@@ -91,6 +237,60 @@ namespace NetBuilder {
          * @param verbose Verbosity level.
          */ 
         static std::vector<unsigned int> computeTValue(std::vector<GeneratingMatrix> baseMatrices, const std::vector<unsigned int>& maxTValuesSubProj, int verbose);
+
+        /**
+         * Compute the t-value corresponding to the packed generating matrices \c baseMatrices, using the prior knowledge that the maximum of the
+         * t-values of the subprojections is \c maxTValuesSubProj.
+         * @param baseMatrices Packed generating matrices.
+         * @param maxTValuesSubProj Maximum of the t-value of the subprojections.
+         * @param verbose Verbosity level.
+         */ 
+        static unsigned int computeTValue(std::vector<PackedGeneratingMatrix> baseMatrices, unsigned int maxTValuesSubProj, int verbose);
+
+        /**
+         * Compute the t-value corresponding to the packed generating matrices \c baseMatrices, for each level, using the prior knowledge that the maximum of the
+         * t-values of the subprojections, for each level \c i is \c maxTValuesSubProj[i].
+         * @param baseMatrices Packed generating matrices.
+         * @param maxTValuesSubProj Maximum of the t-value of the subprojections.
+         * @param verbose Verbosity level.
+         */ 
+        static std::vector<unsigned int> computeTValue(std::vector<PackedGeneratingMatrix> baseMatrices, const std::vector<unsigned int>& maxTValuesSubProj, int verbose);
+
+        /**
+         * Compute the t-value corresponding to the generating matrices viewed by \c baseMatrices, without copying them.
+         * @see computeTValue(std::vector<GeneratingMatrix>, unsigned int, int)
+         * @param baseMatrices Generating matrices.
+         * @param maxTValuesSubProj Maximum of the t-value of the subprojections.
+         * @param verbose Verbosity level.
+         */ 
+        static unsigned int computeTValue(const MatricesView<GeneratingMatrix>& baseMatrices, unsigned int maxTValuesSubProj, int verbose);
+
+        /**
+         * Compute the t-value corresponding to the generating matrices viewed by \c baseMatrices, for each level, without copying them.
+         * @see computeTValue(std::vector<GeneratingMatrix>, const std::vector<unsigned int>&, int)
+         * @param baseMatrices Generating matrices.
+         * @param maxTValuesSubProj Maximum of the t-value of the subprojections.
+         * @param verbose Verbosity level.
+         */ 
+        static std::vector<unsigned int> computeTValue(const MatricesView<GeneratingMatrix>& baseMatrices, const std::vector<unsigned int>& maxTValuesSubProj, int verbose);
+
+        /**
+         * Compute the t-value corresponding to the packed generating matrices viewed by \c baseMatrices, without copying them.
+         * @see computeTValue(std::vector<PackedGeneratingMatrix>, unsigned int, int)
+         * @param baseMatrices Packed generating matrices.
+         * @param maxTValuesSubProj Maximum of the t-value of the subprojections.
+         * @param verbose Verbosity level.
+         */ 
+        static unsigned int computeTValue(const MatricesView<PackedGeneratingMatrix>& baseMatrices, unsigned int maxTValuesSubProj, int verbose);
+
+        /**
+         * Compute the t-value corresponding to the packed generating matrices viewed by \c baseMatrices, for each level, without copying them.
+         * @see computeTValue(std::vector<PackedGeneratingMatrix>, const std::vector<unsigned int>&, int)
+         * @param baseMatrices Packed generating matrices.
+         * @param maxTValuesSubProj Maximum of the t-value of the subprojections.
+         * @param verbose Verbosity level.
+         */ 
+        static std::vector<unsigned int> computeTValue(const MatricesView<PackedGeneratingMatrix>& baseMatrices, const std::vector<unsigned int>& maxTValuesSubProj, int verbose);
     };
 
 }
@@ -23,12 +23,49 @@
 #include "netbuilder/FigureOfMerit/LevelCombiner.h"
 
 #include <functional>
+#include <iterator>
 #include <stdexcept>
 
 namespace NetBuilder { namespace FigureOfMerit {
 
 using LatticeTester::Coordinates;
 
+/**
+ * Returns a view of the generating matrices of \c net for the coordinates of \c projection, without copying them.
+ * The view is valid until the next call from the same thread.
+ * @param net Digital net.
+ * @param projection Projection, given by a LatticeTester::Coordinates or a ProjectionView.
+ */
+template <typename PROJECTION>
+MatricesView<GeneratingMatrix> generatingMatricesOf(const AbstractDigitalNet& net, const PROJECTION& projection)
+{
+    thread_local std::vector<const GeneratingMatrix*> mats;
+    mats.clear();
+    for(auto dim : projection)
+    {
+        mats.push_back(&net.generatingMatrix(dim));
+    }
+    return MatricesView<GeneratingMatrix>(mats);
+}
+
+/**
+ * Returns a view of the packed generating matrices of \c net for the coordinates of \c projection, without copying them.
+ * The view is valid until the next call from the same thread.
+ * @param net Digital net.
+ * @param projection Projection, given by a LatticeTester::Coordinates or a ProjectionView.
+ */
+template <typename PROJECTION>
+MatricesView<PackedGeneratingMatrix> packedGeneratingMatricesOf(const AbstractDigitalNet& net, const PROJECTION& projection)
+{
+    thread_local std::vector<const PackedGeneratingMatrix*> mats;
+    mats.clear();
+    for(auto dim : projection)
+    {
+        mats.push_back(&net.packedGeneratingMatrix(dim));
+    }
+    return MatricesView<PackedGeneratingMatrix>(mats);
+}
+
 /** Template class representing a projection-dependent merit defined by the t-value of the projection.
  *  @tparam ET Embedding type : UNILEVEL or MULTILEVEL.
  *  @tparam METHOD Computation method of the t-value. 
@@ -82,21 +119,74 @@ class TValueProjMerit<EmbeddingType::UNILEVEL, METHOD>
 
         /** 
          * Computes the projection-dependent merit of the net \c net for the given projection.
+         * The generating matrices of the net are not copied.
          * @param net Digital net to evaluate.
-         * @param projection Projection to use.
+         * @param projection Projection to use, given by a LatticeTester::Coordinates or a ProjectionView.
          * @param maxMeritsSubProj Maximum of the t-value of the subprojections. 
          */ 
-        Real operator()(const AbstractDigitalNet& net , const LatticeTester::Coordinates& projection, SubProjCombination maxMeritsSubProj) const 
+        template <typename PROJECTION>
+        Real operator()(const AbstractDigitalNet& net , const PROJECTION& projection, SubProjCombination maxMeritsSubProj) const 
+        {
+            if (net.hasPackedGeneratingMatrices())
+            {
+                return METHOD::computeTValue(packedGeneratingMatricesOf(net, projection), maxMeritsSubProj, false);
+            }
+            return METHOD::computeTValue(generatingMatricesOf(net, projection), maxMeritsSubProj, false);
+        }
+
+        /** 
+         * Computes the projection-dependent merits of several nets for the given projection. The nets must only differ
+         * by the last coordinate of the projection. When the generating matrices are square and packed, the t-values are
+         * computed by batches of METHOD::batchSize nets using METHOD::computeTValues. Otherwise, the nets are evaluated one by one.
+         * @param nets Digital nets to evaluate.
+         * @param projection Projection to use, given by a LatticeTester::Coordinates or a ProjectionView.
+         * @param maxMeritsSubProj Maximum of the t-value of the subprojections for each net. 
+         */ 
+        template <typename PROJECTION>
+        std::vector<Merit> operator()(const std::vector<const AbstractDigitalNet*>& nets, const PROJECTION& projection, const std::vector<SubProjCombination>& maxMeritsSubProj) const 
         {
-            std::vector<GeneratingMatrix> mats;
+            std::vector<Merit> res;
+            res.reserve(nets.size());
+            const AbstractDigitalNet& first = *nets[0];
+            if (projection.size() == 1 || !first.hasPackedGeneratingMatrices() || first.numRows() != first.numColumns())
+            {
+                for(unsigned int i = 0; i < nets.size(); ++i)
+                {
+                    res.push_back((Merit) operator()(*nets[i], projection, maxMeritsSubProj[i]));
+                }
+                return res;
+            }
+
+            const Dimension lastDim = *std::prev(projection.end());
+            std::vector<const PackedGeneratingMatrix*> commonMats;
+            commonMats.reserve(projection.size() - 1);
             for(auto dim : projection)
             {
-                mats.push_back(net.generatingMatrix(dim));
+                if (dim != lastDim)
+                {
+                    commonMats.push_back(&first.packedGeneratingMatrix(dim));
+                }
             }
-            return METHOD::computeTValue(std::move(mats),maxMeritsSubProj, false);
+
+            std::vector<const PackedGeneratingMatrix*> lastMats;
+            std::vector<unsigned int> maxSubProj;
+            for(unsigned int start = 0; start < nets.size(); start += METHOD::batchSize)
+            {
+                const unsigned int end = std::min((unsigned int) nets.size(), start + METHOD::batchSize);
+                lastMats.clear();
+                maxSubProj.clear();
+                for(unsigned int i = start; i < end; ++i)
+                {
+                    lastMats.push_back(&nets[i]->packedGeneratingMatrix(lastDim));
+                    maxSubProj.push_back(maxMeritsSubProj[i]);
+                }
+                auto tValues = METHOD::computeTValues(commonMats, lastMats, maxSubProj);
+                res.insert(res.end(), tValues.begin(), tValues.end());
+            }
+            return res;
         }
 
-        virtual Real combine(Merit merit, const AbstractDigitalNet& net, const LatticeTester::Coordinates& projection)
+        virtual Real combine(Merit merit, const AbstractDigitalNet& net, const ProjectionView& projection)
         {
             return (Real) merit;
         }
@@ -194,18 +284,19 @@ class TValueProjMerit<EmbeddingType::MULTILEVEL, METHOD>
 
         /** 
          * Computes the projection-dependent multilevel merits of the net for the given projection.
+         * The generating matrices of the net are not copied.
          * @param net is the digital net for which we want to compute the merit
-         * @param projection is the projection to consider
+         * @param projection is the projection to consider, given by a LatticeTester::Coordinates or a ProjectionView
          * @param maxMeritsSubProj is the maximal merit of the subprojections
          */ 
-        std::vector<unsigned int> operator()(const AbstractDigitalNet& net, const LatticeTester::Coordinates& projection, const std::vector<unsigned int>& maxMeritsSubProj) const 
+        template <typename PROJECTION>
+        std::vector<unsigned int> operator()(const AbstractDigitalNet& net, const PROJECTION& projection, const std::vector<unsigned int>& maxMeritsSubProj) const 
         {
-            std::vector<GeneratingMatrix> mats;
-            for(auto dim : projection)
+            if (net.hasPackedGeneratingMatrices())
             {
-                mats.push_back(net.generatingMatrix(dim));
+                return METHOD::computeTValue(packedGeneratingMatricesOf(net, projection), maxMeritsSubProj, 0);
             }
-            return METHOD::computeTValue(std::move(mats), maxMeritsSubProj, 0);
+            return METHOD::computeTValue(generatingMatricesOf(net, projection), maxMeritsSubProj, 0);
         }
 
         /** 
@@ -214,7 +305,7 @@ class TValueProjMerit<EmbeddingType::MULTILEVEL, METHOD>
          * @param net Digital net.
          * @param projection Projection.
          */ 
-        virtual Real combine(const Merit& merits, const AbstractDigitalNet& net, const LatticeTester::Coordinates& projection) {
+        virtual Real combine(const Merit& merits, const AbstractDigitalNet& net, const ProjectionView& projection) {
             RealVector tmp(merits.size());
             for (unsigned int i=0; i<merits.size(); i++){
                 tmp[i] = (Real) merits[i];
@@ -287,6 +378,18 @@ class WeightedFigureOfMerit<TValueProjMerit<EmbeddingType::UNILEVEL, GaussMethod
         WeightedFigureOfMeritEvaluator(WeightedFigureOfMerit<TValueProjMerit<EmbeddingType::UNILEVEL, GaussMethod>>* figure):
             ProjectionDependentEvaluator(figure)
         {}
+
+        virtual unsigned int batchSize() const override { return GaussMethod::batchSize; }
+
+        virtual std::vector<MeritValue> evaluateBatch(const std::vector<const AbstractDigitalNet*>& nets, Dimension dimension, MeritValue initialValue, int verbose = 0) override
+        {
+            return evaluateBatchImpl(nets, dimension, initialValue);
+        }
+
+        virtual void batchNetWasBest(unsigned int index) override
+        {
+            saveBatchMerits(index);
+        }
 };
 
 /**
@@ -93,7 +93,7 @@ class TValueTransformedProjMerit<EmbeddingType::UNILEVEL, METHOD>: public TValue
             this->cost_function = cost_function;
         }
 
-        virtual Real combine(Merit merit, const AbstractDigitalNet& net, const LatticeTester::Coordinates& projection)
+        virtual Real combine(Merit merit, const AbstractDigitalNet& net, const ProjectionView& projection)
         {
             return h(merit, net.numColumns(), projection.size(), cost_function);
         }
@@ -137,7 +137,7 @@ class TValueTransformedProjMerit<EmbeddingType::MULTILEVEL, METHOD>: public TVal
             this->cost_function = cost_function;
         }
 
-        virtual Real combine(const Merit& merits, const AbstractDigitalNet& net, const LatticeTester::Coordinates& projection) {
+        virtual Real combine(const Merit& merits, const AbstractDigitalNet& net, const ProjectionView& projection) {
             RealVector tmp(merits.size());
             for (unsigned int i=0; i<merits.size(); i++){
                 tmp[i] = h(merits[i], net.numColumns(), projection.size(), cost_function);
@@ -173,6 +173,18 @@ class WeightedFigureOfMerit<TValueTransformedProjMerit<EmbeddingType::UNILEVEL,
         WeightedFigureOfMeritEvaluator(WeightedFigureOfMerit<TValueTransformedProjMerit<EmbeddingType::UNILEVEL, GaussMethod>>* figure):
             ProjectionDependentEvaluator(figure)
         {}
+
+        virtual unsigned int batchSize() const override { return GaussMethod::batchSize; }
+
+        virtual std::vector<MeritValue> evaluateBatch(const std::vector<const AbstractDigitalNet*>& nets, Dimension dimension, MeritValue initialValue, int verbose = 0) override
+        {
+            return evaluateBatchImpl(nets, dimension, initialValue);
+        }
+
+        virtual void batchNetWasBest(unsigned int index) override
+        {
+            saveBatchMerits(index);
+        }
 };
 
 /**
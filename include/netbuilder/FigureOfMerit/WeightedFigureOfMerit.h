@@ -176,6 +176,11 @@ class WeightedFigureOfMerit : public CBCFigureOfMerit
                  */
                 virtual void lastNetWasBest() override {};
 
+                /**
+                 * Tells the evaluator that the best net so far is the one of another evaluator
+                 */
+                virtual void copyBestNet(const CBCFigureOfMeritEvaluator&) override {};
+
             private:
 
                 WeightedFigureOfMerit* m_figure;
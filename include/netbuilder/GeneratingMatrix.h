@@ -41,8 +41,8 @@ namespace NetBuilder {
  * comes from the rank computation algorithm, which is the most complicated algorithm handling matrices in the software.
  * For this algorithm, it is more convenient to handle matrices by rows.
  * 
- * For now, we did not implement an algorithm to compute directly the points generated by a given matrix.
- * However, the Stride associated with a matrix, i.e. the permutation of \f${i/n, 0 <= i <= n}\f$, is computed in latbuilder/Storage-SIMPLE-DIGITAL.h.
+ * The points generated by the matrices of a digital net are computed by PointGenerator (see netbuilder/PointGenerator.h).
+ * The Stride associated with a matrix, i.e. the permutation of \f${i/n, 0 <= i <= n}\f$, is computed in latbuilder/Storage-SIMPLE-DIGITAL.h.
  * For more information, see Section 4.3.2 of Maxime’s report (https://github.com/umontreal-simul/latnetbuilder/blob/dev/reports/report_godin.pdf),
  * and the documentation of netbuilder/DigitalNet.n. 
  */ 
@@ -116,6 +116,11 @@ class GeneratingMatrix {
          */ 
         Row& operator[](unsigned int i);
 
+        /** Sets all the elements of the row at position \c i to zero.
+         * @param i Position of the row.
+         */
+        void resetRow(unsigned int i);
+
         /** Returns the upper-left submatrix with \c nRows rows and \c nCols columns.
          * @param nRows Number of rows.
          * @param nCols Number of columns.
@@ -135,10 +140,16 @@ class GeneratingMatrix {
 
         /**
          * Computes the product of the matrix by matrix \c m.
+         * If both matrices have at most 64 columns, the product is computed in the word-packed representation (see PackedGeneratingMatrix::operator*).
          * @param m Right multiplier.
          */ 
         GeneratingMatrix operator*(const GeneratingMatrix& m) const;
 
+        /**
+         * Returns the transpose of the matrix.
+         */ 
+        GeneratingMatrix transpose() const;
+
         /** Swap the rows at position i1 and i2 of the matrix.
          * @param i1 Position of the first row.
          * @param i2 Position of the second row.
@@ -185,7 +196,7 @@ class GeneratingMatrix {
         template<typename RAND>
         static GeneratingMatrix createRandomLowerTriangularMatrix(unsigned int nRows, unsigned int nCols, RAND& randomGen) {
             std::vector<GeneratingMatrix::uInteger> res(nRows, 0);
-            unsigned long diagonalCoeff = 1 << (nCols);
+            unsigned long diagonalCoeff = 1UL << (nCols);
             LatBuilder::UniformUIntDistribution<unsigned long, LatBuilder::LFSR258> m_unif(0, diagonalCoeff - 1);
             for(unsigned int i = 0; i < std::min(nCols, nRows); ++i)
             {
@@ -0,0 +1,228 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file
+ * This file contains the definition of the persistent list of coordinates shared by digital nets.
+ */
+
+#ifndef NETBUILDER__COORDINATE_LIST_H
+#define NETBUILDER__COORDINATE_LIST_H
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+namespace NetBuilder {
+
+/**
+ * Persistent list of shared pointers to the coordinates of a digital net.
+ *
+ * Appending an element returns a new list and leaves the original list unchanged. The lists obtained by appending
+ * elements to a list share the storage of its elements, so that appending is done in constant time, whatever the
+ * length of the list, and without allocating memory except when the storage needs a new chunk.
+ *
+ * The storage is an append-only sequence of slots, split in chunks of geometrically increasing sizes which are never moved.
+ * A list of size \f$s\f$ refers to the first \f$s-1\f$ slots of its storage and holds its last element by itself.
+ * The last element is committed to the next slot of the storage only when an element is appended after it. Hence all the
+ * lists obtained by appending different elements to the same list (e.g., the candidate nets of a CBC search) share the
+ * storage, and appending to one of them later commits its last element. If the slot is already taken by another element,
+ * the prefix is copied into a new storage (copy-on-write); this does not happen when lists are extended one coordinate
+ * at a time as in CBC searches.
+ *
+ * Appending to lists sharing the same storage from several threads is safe. Elements are read without synchronization.
+ *
+ * @tparam T Type of the elements.
+ */
+template <typename T>
+class CoordinateList
+{
+    public:
+
+        /** Constructs an empty list. */
+        CoordinateList():
+            m_size(0)
+        {}
+
+        /** Returns the number of elements. */
+        std::size_t size() const { return m_size; }
+
+        /** Returns the element at index \c i.
+         * @param i Index between 0 and size() - 1.
+         */
+        const T& operator[](std::size_t i) const
+        {
+            return *pointer(i);
+        }
+
+        /** Returns the shared pointer to the element at index \c i.
+         * @param i Index between 0 and size() - 1.
+         */
+        const std::shared_ptr<T>& pointer(std::size_t i) const
+        {
+            assert(i < m_size);
+            return (i + 1 == m_size) ? m_last : m_storage->slot(i);
+        }
+
+        /** Returns the list obtained by appending an element to this list.
+         * @param element Shared pointer to the element.
+         */
+        CoordinateList append(std::shared_ptr<T> element) const
+        {
+            return CoordinateList(commitLast(), m_size + 1, std::move(element));
+        }
+
+        /** Appends an element to this list.
+         * @param element Shared pointer to the element.
+         */
+        void push_back(std::shared_ptr<T> element)
+        {
+            m_storage = commitLast();
+            m_last = std::move(element);
+            ++m_size;
+        }
+
+    private:
+
+        class Storage
+        {
+            public:
+
+                Storage():
+                    m_size(0)
+                {
+                    for (auto& chunk : m_chunks)
+                    {
+                        chunk = nullptr;
+                    }
+                }
+
+                ~Storage()
+                {
+                    const std::size_t size = m_size.load(std::memory_order_relaxed);
+                    for (unsigned int k = 0; k < s_maxChunks && chunkBegin(k) < size; ++k)
+                    {
+                        delete[] m_chunks[k];
+                    }
+                }
+
+                Storage(const Storage&) = delete;
+                Storage& operator=(const Storage&) = delete;
+
+                /** Returns the number of committed slots, read with acquire semantics. */
+                std::size_t size() const { return m_size.load(std::memory_order_acquire); }
+
+                /** Returns the slot at index \c i, which must have been committed. */
+                const std::shared_ptr<T>& slot(std::size_t i) const
+                {
+                    const unsigned int k = chunkIndex(i);
+                    return m_chunks[k][i - chunkBegin(k)];
+                }
+
+                /** Commits \c element to the slot at index \c i if it is the next free slot, or if the slot already holds \c element.
+                 * Returns whether the slot holds \c element after the call.
+                 */
+                bool commit(std::size_t i, const std::shared_ptr<T>& element)
+                {
+                    if (i < size())
+                    {
+                        return slot(i) == element;
+                    }
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    const std::size_t size = m_size.load(std::memory_order_relaxed);
+                    if (i < size)
+                    {
+                        return slot(i) == element;
+                    }
+                    if (i > size)
+                    {
+                        return false;
+                    }
+                    const unsigned int k = chunkIndex(i);
+                    if (i == chunkBegin(k))
+                    {
+                        m_chunks[k] = new std::shared_ptr<T>[chunkBegin(k + 1) - chunkBegin(k)];
+                    }
+                    m_chunks[k][i - chunkBegin(k)] = element;
+                    m_size.store(size + 1, std::memory_order_release);
+                    return true;
+                }
+
+            private:
+
+                static constexpr unsigned int s_log2FirstChunk = 4; // the first chunk holds 16 slots and each chunk doubles the capacity
+                static constexpr unsigned int s_maxChunks = 8 * sizeof(std::size_t) - s_log2FirstChunk;
+
+                /** Returns the index of the first slot of chunk \c k. */
+                static std::size_t chunkBegin(unsigned int k)
+                {
+                    return ((std::size_t(1) << k) - 1) << s_log2FirstChunk;
+                }
+
+                /** Returns the index of the chunk holding slot \c i. */
+                static unsigned int chunkIndex(std::size_t i)
+                {
+                    std::size_t j = (i >> s_log2FirstChunk) + 1;
+                    unsigned int k = 0;
+                    while (j >>= 1)
+                    {
+                        ++k;
+                    }
+                    return k;
+                }
+
+                std::array<std::shared_ptr<T>*, s_maxChunks> m_chunks; // chunks of slots, allocated when the first slot is committed
+                std::atomic<std::size_t> m_size; // number of committed slots
+                std::mutex m_mutex; // serializes the commits
+        };
+
+        CoordinateList(std::shared_ptr<Storage> storage, std::size_t size, std::shared_ptr<T> last):
+            m_storage(std::move(storage)),
+            m_size(size),
+            m_last(std::move(last))
+        {}
+
+        /** Returns a storage holding the elements of this list, committing the last one if needed. */
+        std::shared_ptr<Storage> commitLast() const
+        {
+            if (m_size == 0)
+            {
+                return m_storage ? m_storage : std::make_shared<Storage>();
+            }
+            if (m_storage->commit(m_size - 1, m_last))
+            {
+                return m_storage;
+            }
+            // the slot is taken by another element: copy the elements in a new storage
+            auto storage = std::make_shared<Storage>();
+            for (std::size_t i = 0; i < m_size; ++i)
+            {
+                storage->commit(i, pointer(i));
+            }
+            return storage;
+        }
+
+        std::shared_ptr<Storage> m_storage; // storage of the elements but the last one, shared with other lists
+        std::size_t m_size; // number of elements
+        std::shared_ptr<T> m_last; // last element
+};
+
+}
+
+#endif
@@ -0,0 +1,133 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file
+ * This file contains the definition of a class which enumerates all the tuples of generating matrices of a given size
+ * in a Gray-code order.
+ */
+
+#ifndef NETBUILDER__GRAY_CODE_MATRIX_ENUMERATOR_H
+#define NETBUILDER__GRAY_CODE_MATRIX_ENUMERATOR_H
+
+#include "netbuilder/Types.h"
+#include "netbuilder/GeneratingMatrix.h"
+#include "netbuilder/PackedGeneratingMatrix.h"
+#include "netbuilder/Helpers/RankComputer.h"
+
+#include <vector>
+
+namespace NetBuilder {
+
+/**
+ * Generator of all the tuples of \f$s\f$ matrices of size \f$k \times m\f$ over \f$\mathbb{F}_2\f$.
+ *
+ * The \f$s k m\f$ elements of the matrices are seen as the bits of an integer which is enumerated in the reflected Gray-code order,
+ * so that two consecutive tuples only differ by one element of one matrix. The rank of each matrix is maintained
+ * by a rank computer updated with BasicRankComputer::flip(), which allows to skip the tuples with a matrix which is not of full rank
+ * at the cost of a few row operations per tuple. Only the enumeration and the ranks are incremental: the nets built from the tuples
+ * are evaluated from scratch. The Gray code is stored in a single 64-bit word, hence the matrices have at most maxNumElements
+ * elements in total.
+ */
+class GrayCodeMatrixEnumerator
+{
+    public:
+
+        /// Maximal total number of elements of the matrices.
+        static constexpr unsigned int maxNumElements = 63;
+
+        /**
+         * Throws a std::logic_error if the tuples of \c nMatrices matrices with \c nRows rows and \c nCols columns have more than
+         * maxNumElements elements in total.
+         * @param nMatrices Number of matrices in each tuple.
+         * @param nRows Number of rows of the matrices.
+         * @param nCols Number of columns of the matrices.
+         */
+        static void checkNumElements(unsigned int nMatrices, unsigned int nRows, unsigned int nCols);
+
+        /**
+         * Constructs a generator of all the tuples of \c nMatrices matrices with \c nRows rows and \c nCols columns.
+         * Throws a std::logic_error if the matrices have more than maxNumElements elements in total.
+         * @param nMatrices Number of matrices in each tuple.
+         * @param nRows Number of rows of the matrices.
+         * @param nCols Number of columns of the matrices.
+         * @param fullRankOnly If true, only the tuples whose matrices are all of full rank are generated.
+         */
+        GrayCodeMatrixEnumerator(unsigned int nMatrices, unsigned int nRows, unsigned int nCols, bool fullRankOnly = false);
+
+        /**
+         * Returns the number of tuples generated.
+         */
+        uInteger size() const { return m_size; }
+
+        /**
+         * Returns the number of tuples generated so far.
+         */
+        uInteger count() const { return m_count; }
+
+        /**
+         * Changes the current tuple to the next tuple. The first call sets the current tuple to the first one.
+         * Returns false when the generator is depleted and true otherwise.
+         */
+        bool goToNextMatrices();
+
+        /**
+         * Restarts the generator from the beginning.
+         */
+        void reset();
+
+        /**
+         * Returns the matrix \c k of the current tuple.
+         * @param k Index of the matrix.
+         */
+        GeneratingMatrix matrix(unsigned int k) const { return m_matrices[k].toGeneratingMatrix(); }
+
+        /**
+         * Returns the matrix \c k of the current tuple in the word-packed representation.
+         * @param k Index of the matrix.
+         */
+        const PackedGeneratingMatrix& packedMatrix(unsigned int k) const { return m_matrices[k]; }
+
+        /**
+         * Returns whether the matrix \c k changed since the previous tuple.
+         * @param k Index of the matrix.
+         */
+        bool isModified(unsigned int k) const { return m_modified[k]; }
+
+    private:
+        unsigned int m_nRows; // number of rows of the matrices
+        unsigned int m_nCols; // number of columns of the matrices
+        bool m_fullRankOnly; // whether the tuples with a matrix which is not of full rank are skipped
+        unsigned int m_fullRank; // rank of the matrices of full rank
+        uInteger m_nGrayCodes; // number of Gray codes, that is 2 to the total number of elements
+        uInteger m_size; // number of tuples generated
+        uInteger m_grayIndex; // index of the current tuple in the Gray-code order
+        uInteger m_count; // number of tuples generated so far
+        bool m_started; // whether the first tuple has been visited
+        std::vector<PackedGeneratingMatrix> m_matrices; // matrices of the current tuple
+        std::vector<PackedRankComputer> m_rankComputers; // reductions of the matrices of the current tuple
+        unsigned int m_nRankDeficient; // number of matrices of the current tuple which are not of full rank
+        std::vector<bool> m_modified; // whether each matrix changed since the previous tuple
+
+        /**
+         * Flips the element of the matrices corresponding to bit \c bit of the Gray code.
+         */
+        void flipBit(unsigned int bit);
+};
+
+}
+
+#endif
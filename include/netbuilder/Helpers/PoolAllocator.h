@@ -0,0 +1,168 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file
+ * This file contains the definition of an allocator recycling the memory blocks of objects of the same size.
+ */
+
+#ifndef NETBUILDER__POOL_ALLOCATOR_H
+#define NETBUILDER__POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+namespace NetBuilder {
+
+/**
+ * Per-thread list of free memory blocks of \c BlockSize bytes.
+ * Blocks released by a thread are kept in the list of this thread, up to maxBlocks blocks, and handed out again
+ * by the next allocations of the same thread instead of going through the global allocator. The blocks in the
+ * list are released when the thread exits.
+ */
+template <std::size_t BlockSize>
+class BlockPool
+{
+    public:
+
+        /// Maximal number of free blocks kept by each thread.
+        static constexpr std::size_t maxBlocks = 1024;
+
+        /** Returns a block of \c BlockSize bytes. */
+        static void* allocate()
+        {
+            FreeList& list = freeList();
+            if (list.head)
+            {
+                Node* node = list.head;
+                list.head = node->next;
+                --list.size;
+                return node;
+            }
+            return ::operator new(BlockSize);
+        }
+
+        /** Releases a block returned by allocate(), possibly by another thread.
+         * @param block Block to release.
+         */
+        static void deallocate(void* block) noexcept
+        {
+            FreeList& list = freeList();
+            if (list.size == maxBlocks)
+            {
+                ::operator delete(block);
+                return;
+            }
+            Node* node = static_cast<Node*>(block);
+            node->next = list.head;
+            list.head = node;
+            ++list.size;
+        }
+
+    private:
+
+        struct Node
+        {
+            Node* next;
+        };
+
+        static_assert(BlockSize >= sizeof(Node), "blocks must be large enough to hold a pointer");
+
+        struct FreeList
+        {
+            Node* head = nullptr; // first free block
+            std::size_t size = 0; // number of free blocks
+
+            ~FreeList()
+            {
+                while (head)
+                {
+                    Node* next = head->next;
+                    ::operator delete(head);
+                    head = next;
+                }
+            }
+        };
+
+        static FreeList& freeList()
+        {
+            static thread_local FreeList list;
+            return list;
+        }
+};
+
+/**
+ * Allocator of single objects drawing its memory from a BlockPool.
+ * Allocations of arrays go through the global allocator. This allocator is meant to be used with <code>std::allocate_shared</code>
+ * for objects which are created and destroyed at a high rate, such as the coordinates of the candidate nets of a search.
+ * @tparam T Type of the allocated objects.
+ */
+template <typename T>
+class PoolAllocator
+{
+    public:
+
+        typedef T value_type;
+
+        PoolAllocator() = default;
+
+        template <typename U>
+        PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+        /** Allocates memory for \c n objects of type \c T.
+         * @param n Number of objects.
+         */
+        T* allocate(std::size_t n)
+        {
+            static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+            if (n == 1)
+            {
+                return static_cast<T*>(BlockPool<blockSize>::allocate());
+            }
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+
+        /** Releases memory returned by allocate().
+         * @param p Pointer to the memory.
+         * @param n Number of objects.
+         */
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            if (n == 1)
+            {
+                BlockPool<blockSize>::deallocate(p);
+            }
+            else
+            {
+                ::operator delete(p);
+            }
+        }
+
+    private:
+
+        // size rounded up to a multiple of the pointer size, so that types of close sizes share their pool
+        static constexpr std::size_t blockSize = (sizeof(T) + sizeof(void*) - 1) / sizeof(void*) * sizeof(void*);
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept { return true; }
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept { return false; }
+
+}
+
+#endif
@@ -23,10 +23,11 @@
 #define NETBUILDER__RANK_COMPUTER_H
 
 #include "netbuilder/GeneratingMatrix.h"
+#include "netbuilder/PackedGeneratingMatrix.h"
 
 #include <map>
-#include <set>
-#include <list>
+#include <vector>
+#include <utility>
 
 // #define DEBUG_ROW_REDUCER
 
@@ -34,14 +35,25 @@ namespace NetBuilder {
 
 /**
  * Class used to perform row reduction operations on a matrix.
+ * @tparam MATRIX Representation of the matrices: GeneratingMatrix or PackedGeneratingMatrix.
+ * With PackedGeneratingMatrix, both the number of columns and the number of rows of the rank computer must be at most 64
+ * (the row operations matrix is square).
+ *
+ * The positions of the pivots are stored in flat arrays indexed by rows and columns, and the columns without a pivot
+ * in a bitmask of the same type as the rows, so that the next pivot of a row is found by a find-first-set operation.
  */ 
-class RankComputer
+template <typename MATRIX>
+class BasicRankComputer
 {
     public:
+
+        /// Type of the rows of the matrices.
+        typedef typename MATRIX::Row Row;
+
         /** Constructor.
          * @param nCols number of columns of the rank computer.
          */ 
-        RankComputer(unsigned int nCols = 0);
+        BasicRankComputer(unsigned int nCols = 0);
 
         /**
          * Clears the rank computer and set the number of columns to \c nCols.
@@ -53,13 +65,27 @@ class RankComputer
          * Adds a row below the current matrix and updates the reduction subsequently.
          * @param newRow The one-row matrix to stack below.
          */ 
-        void addRow(GeneratingMatrix newRow);
+        void addRow(MATRIX newRow);
+
+        /**
+         * Adds the row \c newRow below the current matrix and updates the reduction subsequently.
+         * Contrary to the overload taking a one-row matrix, no intermediate matrix is created.
+         * @param newRow The row to stack below. Should have numCols() elements.
+         */ 
+        void addRow(const Row& newRow);
+
+        /**
+         * Adds the rows of \c block below the current matrix and updates the reduction subsequently.
+         * The resulting reduction is the same as the one obtained by adding the rows one by one.
+         * @param block The matrix to stack below.
+         */ 
+        void addRows(const MATRIX& block);
 
         /**
          * Adds a column on the right to the current matrix and updates the reduction subsequently.
          * @param newCol The one-column matrix to stack on the right.
          */ 
-        void addColumn(GeneratingMatrix newCol);
+        void addColumn(MATRIX newCol);
 
         /**
          * Replaces the row in position \c rowIndex by \c newRow.
@@ -67,7 +93,25 @@ class RankComputer
          * @param newRow Replacement row.
          * @param verbose Verbosity level.
          */ 
-        void replaceRow(unsigned int rowIndex, GeneratingMatrix&& newRow, int verbose = 0);
+        void replaceRow(unsigned int rowIndex, MATRIX&& newRow, int verbose = 0);
+
+        /**
+         * Replaces the row in position \c rowIndex by \c newRow.
+         * @param rowIndex Index of the row to discard.
+         * @param newRow Replacement row. Should have numCols() elements.
+         */ 
+        void replaceRow(unsigned int rowIndex, const Row& newRow);
+
+        /**
+         * Flips the element at position (\c rowIndex, \c colIndex) of the current matrix and updates the reduction subsequently.
+         * The flip adds the column \c rowIndex of the row operations matrix to the column \c colIndex of the reduced matrix.
+         * Only one of the rows it affects is reduced again, the other ones are restored by one row operation each, so that
+         * the update costs about as much as the addition of a row instead of a full re-elimination.
+         * The rank, the ranks of the submatrices and the smallest full rank remain exact.
+         * @param rowIndex Row of the element to flip.
+         * @param colIndex Column of the element to flip.
+         */ 
+        void flip(unsigned int rowIndex, unsigned int colIndex);
 
         /** 
          * Computes the rank of the matrix.
@@ -90,12 +134,12 @@ class RankComputer
         /**
          * Returns a const reference to the row-reduced matrix.
          */ 
-        const GeneratingMatrix& reducedMatrix() const {return m_redMat;}
+        const MATRIX& reducedMatrix() const {return m_redMat;}
 
         /**
          * Returns a const reference to the row operations matrix.
          */ 
-        const GeneratingMatrix& rowOperations() const {return m_rowOperations; }
+        const MATRIX& rowOperations() const {return m_rowOperations; }
 
         /**
          * Returns the number of rows in the rank computer.
@@ -110,17 +154,17 @@ class RankComputer
         /**
          * Returns a map of pivot positions (key: row index, value: column index).
          */ 
-        std::map<unsigned int, unsigned int> getPivots() const {return m_pivotsRowColPositions; }
+        std::map<unsigned int, unsigned int> getPivots() const;
 
         /**
          * Check if a matrix is invertible. Returns false if the matrix is not-square or singular, 
          * and true otherwise.
          */ 
-        static bool checkIfInvertible(GeneratingMatrix matrix) ;
+        static bool checkIfInvertible(MATRIX matrix) ;
         
         #ifdef DEBUG_ROW_REDUCER
         void check();
-        const GeneratingMatrix& baseMatrix() const {return m_baseMatrix;}
+        const MATRIX& baseMatrix() const {return m_baseMatrix;}
         #endif
 
 
@@ -129,16 +173,24 @@ class RankComputer
         unsigned int m_nRows = 0; // number of rows in the rank computer
         unsigned int m_nCols; // number of columns of the rank computer
         unsigned int m_smallestFullRank; // minimal number of columns necessary for the system spanned by the rows to be full-rank.
-        GeneratingMatrix m_redMat; // row-reduced matrix
-        GeneratingMatrix m_rowOperations; // row operations matrix
-        std::map<unsigned int, unsigned int> m_pivotsColRowPositions; // columns index are the keys and rows indexes are the values
-        std::map<unsigned int, unsigned int> m_pivotsRowColPositions; // columns index are the keys and rows indexes are the values
-        std::set<unsigned int> m_columnsWithoutPivot; // ordered set for columns without a pivot
-        std::list<unsigned int> m_rowsWithoutPivot; // list of rows without a pivot 
+        MATRIX m_redMat; // row-reduced matrix
+        MATRIX m_rowOperations; // row operations matrix
+        static constexpr unsigned int noPivot = (unsigned int) -1; // position of a missing pivot
+        unsigned int m_rank = 0; // number of pivots
+        std::vector<unsigned int> m_pivotRowOfColumn; // row of the pivot of each column (noPivot if the column has no pivot)
+        std::vector<unsigned int> m_pivotColumnOfRow; // column of the pivot of each row (noPivot if the row has no pivot)
+        Row m_columnsWithoutPivot; // bitmask of the columns without a pivot
         #ifdef DEBUG_ROW_REDUCER
-        GeneratingMatrix m_baseMatrix;
+        MATRIX m_baseMatrix;
         #endif
 
+        /**
+         * Looks for a pivot on the row at position \c rowIndex among the columns without pivot and records it.
+         * Returns the column of the new pivot or numCols() if there is none.
+         * @param rowIndex Index of the row.
+         */ 
+        unsigned int findNewPivot(unsigned int rowIndex);
+
         /**
          * Uses existing pivots to pivot the row at position \c rowIndex and look for
          * a new pivot on this row. If such a pivot exists, uses it to pivot the other rows.
@@ -146,8 +198,22 @@ class RankComputer
          */ 
         unsigned int pivotRowAndFindNewPivot(unsigned int rowIndex);
 
+        /**
+         * Updates the smallest number of columns for which the system is full rank after a row was added.
+         */ 
+        void updateSmallestFullRankAfterAddition();
+
 };
 
+/// Rank computer working on general generating matrices.
+typedef BasicRankComputer<GeneratingMatrix> RankComputer;
+
+/// Rank computer working on word-packed generating matrices (at most 64 rows and 64 columns).
+typedef BasicRankComputer<PackedGeneratingMatrix> PackedRankComputer;
+
+extern template class BasicRankComputer<GeneratingMatrix>;
+extern template class BasicRankComputer<PackedGeneratingMatrix>;
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,156 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file
+ * This file contains the definition of a bounded blocking queue used to pass work between threads.
+ */
+
+#ifndef NETBUILDER__RING_BUFFER_H
+#define NETBUILDER__RING_BUFFER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+namespace NetBuilder {
+
+/**
+ * Bounded blocking queue with several producers and several consumers.
+ *
+ * The elements are stored in a ring of cells whose number is a power of two. push() waits while the queue is full,
+ * which lets the producers wait for the consumers and bounds the memory used, and pop() waits while the queue is empty.
+ * Once the queue is closed, the waiting threads are woken up, push() fails and pop() fails as soon as the queue is empty.
+ * @tparam T Type of the elements. Must be default constructible and movable.
+ */
+template <typename T>
+class RingBuffer
+{
+    public:
+
+        /**
+         * Constructor.
+         * @param capacity Minimal number of elements the queue can hold. It is rounded up to a power of two.
+         */
+        explicit RingBuffer(std::size_t capacity):
+            m_mask(roundUpToPowerOfTwo(capacity) - 1),
+            m_cells(new T[m_mask + 1]),
+            m_pushPosition(0),
+            m_popPosition(0),
+            m_closed(false)
+        {}
+
+        RingBuffer(const RingBuffer&) = delete;
+        RingBuffer& operator=(const RingBuffer&) = delete;
+
+        /** Returns the number of elements the queue can hold. */
+        std::size_t capacity() const { return m_mask + 1; }
+
+        /**
+         * Appends an element at the end of the queue, waiting while the queue is full.
+         * @param value Element to append.
+         * @return Whether the element was appended, that is whether the queue was not closed.
+         */
+        bool push(T value)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_notFull.wait(lock, [this] { return m_closed || m_pushPosition - m_popPosition <= m_mask; });
+            if (m_closed)
+            {
+                return false;
+            }
+            m_cells[m_pushPosition & m_mask] = std::move(value);
+            ++m_pushPosition;
+            lock.unlock();
+            m_notEmpty.notify_one();
+            return true;
+        }
+
+        /**
+         * Removes the element at the beginning of the queue, waiting while the queue is empty and not closed.
+         * @param value Reference where the element is moved.
+         * @return Whether an element was removed, that is whether the queue was not closed and empty.
+         */
+        bool pop(T& value)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_notEmpty.wait(lock, [this] { return m_closed || m_pushPosition != m_popPosition; });
+            return popLocked(value, lock);
+        }
+
+        /**
+         * Removes the element at the beginning of the queue if it is not empty.
+         * @param value Reference where the element is moved.
+         * @return Whether an element was removed.
+         */
+        bool tryPop(T& value)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            return popLocked(value, lock);
+        }
+
+        /**
+         * Closes the queue and wakes up the waiting threads. The elements in the queue can still be removed.
+         */
+        void close()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_closed = true;
+            }
+            m_notFull.notify_all();
+            m_notEmpty.notify_all();
+        }
+
+    private:
+
+        bool popLocked(T& value, std::unique_lock<std::mutex>& lock)
+        {
+            if (m_pushPosition == m_popPosition)
+            {
+                return false;
+            }
+            value = std::move(m_cells[m_popPosition & m_mask]);
+            ++m_popPosition;
+            lock.unlock();
+            m_notFull.notify_one();
+            return true;
+        }
+
+        static std::size_t roundUpToPowerOfTwo(std::size_t n)
+        {
+            std::size_t res = 1;
+            while (res < n)
+            {
+                res <<= 1;
+            }
+            return res;
+        }
+
+        const std::size_t m_mask; // number of cells minus one
+        std::unique_ptr<T[]> m_cells; // ring of cells
+        std::size_t m_pushPosition; // position of the next push
+        std::size_t m_popPosition; // position of the next pop
+        bool m_closed; // whether the queue is closed
+        std::mutex m_mutex; // protects the positions, the cells and the closed flag
+        std::condition_variable m_notFull; // signaled when an element is removed or the queue is closed
+        std::condition_variable m_notEmpty; // signaled when an element is appended or the queue is closed
+};
+
+}
+
+#endif
@@ -62,6 +62,8 @@ namespace NetBuilder {
  *  - <CODE>static GeneratingMatrix* createGeneratingMatrix(const GenValue& genValue, const SizeParameter& sizeParameter, const Dimension& dimension_j, const unsigned int nRows)</CODE>: 
  * create a generating matrix using the generating value and the size parameter. 
  * In some cases the generating matrix may also depend on the coordinate and on the number of rows of the generating matrix.
+ *  - <CODE>static void fillGeneratingMatrix(GeneratingMatrix& genMat, const GenValue& genValue, const SizeParameter& sizeParameter, const Dimension& dimension_j, const unsigned int nRows)</CODE>: 
+ * same as createGeneratingMatrix, but overwrites the existing matrix \c genMat, whose storage is reused when it is large enough.
  *  - <CODE>static GenValueSpaceCoordSeq genValueSpaceCoord(Dimension coord, const SizeParameter& sizeParameter)</CODE>: returns the sequence of all the possible generating values
  *  for coordinate \c coord.
  *  - <CODE> static GenValueSpaceSeq genValueSpace(Dimension dimension , const SizeParameter& sizeParameter) </CODE>: returns the sequence of all the possible combinations
@@ -97,6 +99,8 @@ struct NetConstructionTraits<NetConstruction::SOBOL>
 
     static GeneratingMatrix* createGeneratingMatrix(const GenValue& genValue, const SizeParameter& sizeParam, const Dimension& dimension_j = 1, const unsigned int nRows = 0);
 
+    static void fillGeneratingMatrix(GeneratingMatrix& genMat, const GenValue& genValue, const SizeParameter& sizeParam, const Dimension& dimension_j = 1, const unsigned int nRows = 0);
+
     class GenValueSpaceCoordSeq
     {
         public:
@@ -230,6 +234,8 @@ struct NetConstructionTraits<NetConstruction::POLYNOMIAL>
 
     static GeneratingMatrix* createGeneratingMatrix(const GenValue& genValue, const SizeParameter& sizeParam, const Dimension& dimension_j = 1, const unsigned int nRows = 0);
 
+    static void fillGeneratingMatrix(GeneratingMatrix& genMat, const GenValue& genValue, const SizeParameter& sizeParam, const Dimension& dimension_j = 1, const unsigned int nRows = 0);
+
     static GenValueSpaceCoordSeq genValueSpaceCoord(Dimension coord, const SizeParameter& sizeParameter);
 
     static GenValueSpaceSeq genValueSpace(Dimension dimension , const SizeParameter& sizeParameter);
@@ -289,6 +295,8 @@ struct NetConstructionTraits<NetConstruction::EXPLICIT>
 
     static GeneratingMatrix* createGeneratingMatrix(const GenValue& genValue, const SizeParameter& sizeParam, const Dimension& dimension_j = 1, const unsigned int nRows = 0);
 
+    static void fillGeneratingMatrix(GeneratingMatrix& genMat, const GenValue& genValue, const SizeParameter& sizeParam, const Dimension& dimension_j = 1, const unsigned int nRows = 0);
+
     static GenValueSpaceCoordSeq genValueSpaceCoord(Dimension coord, const SizeParameter& sizeParameter);
 
     static std::vector<GenValueSpaceCoordSeq> genValueSpace(Dimension dimension , const SizeParameter& sizeParameter);
@@ -389,6 +397,8 @@ struct NetConstructionTraits<NetConstruction::LMS>
 
     static GeneratingMatrix* createGeneratingMatrix(const GenValue& genValue, const SizeParameter& sizeParam, const Dimension& dimension_j = 1, const unsigned int nRows = 0);
 
+    static void fillGeneratingMatrix(GeneratingMatrix& genMat, const GenValue& genValue, const SizeParameter& sizeParam, const Dimension& dimension_j = 1, const unsigned int nRows = 0);
+
     static GenValueSpaceCoordSeq genValueSpaceCoord(Dimension coord, const SizeParameter& sizeParameter);
 
     static std::vector<GenValueSpaceCoordSeq> genValueSpace(Dimension dimension , const SizeParameter& sizeParameter);
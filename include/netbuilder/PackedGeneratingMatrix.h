@@ -0,0 +1,277 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file
+ * This file contains the definition of word-packed generating matrices in base 2 with at most 64 columns
+ */
+
+#ifndef NETBUILDER__PACKED_GENERATING_MATRIX_H
+#define NETBUILDER__PACKED_GENERATING_MATRIX_H
+
+#include "netbuilder/GeneratingMatrix.h"
+
+#include <cstdint>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace NetBuilder {
+
+/** This class implements a generating matrix of a digital net in base 2 whose number of columns
+ * is at most 64.
+ *
+ * Each row is packed in a single <code>uint64_t</code> word, the element in column \c j being the bit of weight \f$2^j\f$
+ * (this is the same convention as the one used by GeneratingMatrix for its rows and for its integer constructor).
+ * The rows are stored contiguously, so that extracting, combining and comparing rows does not allocate memory.
+ *
+ * The interface mirrors the one of GeneratingMatrix so that algorithms written for one representation
+ * (for instance BasicRankComputer or the t-value computation methods) can be instantiated for the other.
+ * Bits above the number of columns are always kept to zero.
+ */
+class PackedGeneratingMatrix {
+
+    public:
+
+        /// Type for the rows of the matrices.
+        typedef uint64_t Row;
+
+        /// Type for unsigned long.
+        typedef unsigned long uInteger;
+
+        /// Maximal number of columns of a packed matrix.
+        static constexpr unsigned int maxNumCols = 64;
+
+        /** Returns whether a matrix with \c nCols columns fits in the packed representation.
+         * @param nCols Number of columns.
+         */
+        static bool fits(unsigned int nCols) { return nCols <= maxNumCols; }
+
+        /** Returns the word whose \c nCols lowest bits are set.
+         * @param nCols Number of columns.
+         */
+        static Row mask(unsigned int nCols) { return (nCols >= maxNumCols) ? ~Row(0) : ((Row(1) << nCols) - 1); }
+
+        /** Returns the index of the lowest set bit of a non-zero row.
+         * @param row Non-zero row.
+         */
+        static unsigned int lowestBit(Row row)
+        {
+            assert(row != 0);
+            #if defined(__GNUC__) || defined(__clang__)
+            return (unsigned int) __builtin_ctzll(row);
+            #else
+            unsigned int res = 0;
+            while (!(row & 1))
+            {
+                row >>= 1;
+                ++res;
+            }
+            return res;
+            #endif
+        }
+
+        /** Returns the parity of the number of set bits of a row.
+         * @param row Row.
+         */
+        static unsigned int parity(Row row)
+        {
+            #if defined(__GNUC__) || defined(__clang__)
+            return (unsigned int) __builtin_parityll(row);
+            #else
+            for (unsigned int shift = 32; shift != 0; shift >>= 1)
+            {
+                row ^= row >> shift;
+            }
+            return (unsigned int) (row & 1);
+            #endif
+        }
+
+        /** Transposes in place the \f$64 \times 64\f$ matrix whose rows are the words of \c a, in \f$6 \times 32\f$ word operations
+         * by exchanging blocks of halving sizes.
+         * @param a Array of 64 rows.
+         */
+        static void transpose64(Row* a);
+
+        /** Proxy class used to reference an element of a packed matrix. */
+        class reference {
+            public:
+                reference(Row& row, unsigned int j): m_row(row), m_mask(Row(1) << j) {}
+
+                reference& operator=(bool x)
+                {
+                    if (x) { m_row |= m_mask; } else { m_row &= ~m_mask; }
+                    return *this;
+                }
+
+                reference& operator=(const reference& x) { return *this = bool(x); }
+
+                reference& operator^=(bool x)
+                {
+                    if (x) { m_row ^= m_mask; }
+                    return *this;
+                }
+
+                operator bool() const { return (m_row & m_mask) != 0; }
+
+                reference& flip()
+                {
+                    m_row ^= m_mask;
+                    return *this;
+                }
+
+            private:
+                Row& m_row;
+                Row m_mask;
+        };
+
+        /** Constructs a generating matrix with all entries set to zero.
+         * @param nRows Number of rows.
+         * @param nCols Number of columns (at most 64).
+         */
+        PackedGeneratingMatrix(unsigned int nRows = 0, unsigned int nCols = 0);
+
+        /** Constructs a generating matrix with rows initialized
+         * using the given integers. The elements of a row
+         * are the binary digits of the corresponding integer,
+         * with the least significant bit on the left.
+         * @param nRows Number of rows.
+         * @param nCols Number of columns (at most 64).
+         * @param init  Vector of uInteger of length nRows
+         */
+        PackedGeneratingMatrix(unsigned int nRows, unsigned int nCols, std::vector<uInteger> init);
+
+        /** Constructs the packed representation of \c mat.
+         * @param mat Generating matrix with at most 64 columns.
+         */
+        explicit PackedGeneratingMatrix(const GeneratingMatrix& mat);
+
+        /** Replaces the matrix by the packed representation of \c mat, reusing the storage of the rows.
+         * @param mat Generating matrix with at most 64 columns.
+         */
+        void assign(const GeneratingMatrix& mat);
+
+        /** Returns the matrix in the general GeneratingMatrix representation. */
+        GeneratingMatrix toGeneratingMatrix() const;
+
+        /** Returns the number of columns of the matrix. */
+        unsigned int nCols() const { return m_nCols; }
+
+        /** Returns the number of rows of the matrix. */
+        unsigned int nRows() const { return m_nRows; }
+
+        /** Resizes the matrix to the given shape. Potential new elements are set to zero.
+         * @param nRows is the new number of rows of the matrix
+         * @param nCols is the new number of columns of the matrix (at most 64)
+         */
+        void resize(unsigned int nRows, unsigned int nCols);
+
+        /** Returns the element at position \c i, \c j of the matrix.
+         * @param i Row index.
+         * @param j Column index.
+         */
+        bool operator()(unsigned int i, unsigned int j) const { return (m_data[i] >> j) & 1; }
+
+        /** Returns a reference to the element at position \c i, \c j of the matrix.
+         * @param i Row index.
+         * @param j Column index.
+         */
+        reference operator()(unsigned int i, unsigned int j) { return reference(m_data[i], j); }
+
+        /** Flip the element at at position \c i, \c j of the matrix.
+         * @param i Row index.
+         * @param j Column index.
+         */
+        void flip(unsigned int i, unsigned int j) { m_data[i] ^= (Row(1) << j); }
+
+        /** Returns the row at position \c i of the matrix.
+         * @param i Position of the row.
+         */
+        Row operator[](unsigned int i) const { return m_data[i]; }
+
+        /** Returns a reference to the row at position \c i of the matrix.
+         * @param i Position of the row.
+         */
+        Row& operator[](unsigned int i) { return m_data[i]; }
+
+        /** Sets all the elements of the row at position \c i to zero.
+         * @param i Position of the row.
+         */
+        void resetRow(unsigned int i) { m_data[i] = 0; }
+
+        /** Returns a pointer to the contiguous storage of the rows. */
+        const Row* data() const { return m_data.data(); }
+
+        /** Returns the upper-left submatrix with \c nRows rows and \c nCols columns.
+         * @param nRows Number of rows.
+         * @param nCols Number of columns.
+         * @return A copy of the submatrix.
+         */
+        PackedGeneratingMatrix upperLeftSubMatrix(unsigned int nRows, unsigned int nCols) const;
+
+        /** Returns the submatrix with upper-left corner at position \c startingRow, \c startingCol
+         * with \c nRows rows and \c nCols columns.
+         * @param startingRow Row position of the upper-left corner.
+         * @param startingCol Column position of the upper-left corner.
+         * @param nRows Number of rows.
+         * @param nCols Number of columns.
+         * @return A copy of the submatrix.
+         */
+        PackedGeneratingMatrix subMatrix(unsigned int startingRow, unsigned int startingCol, unsigned int nRows, unsigned int nCols) const;
+
+        /**
+         * Computes the product of the matrix by matrix \c m.
+         * The rows of the product are combinations of the rows of \c m, computed with the Method of Four Russians: the rows of \c m
+         * are split in groups of a few rows and all the combinations of the rows of each group are tabulated, so that each row of the
+         * product is obtained with one table lookup per group. If \c m has only a few columns (e.g. it is a column vector), each element
+         * of the product is instead computed as the parity of a row of the matrix and a column of \c m.
+         * @param m Right multiplier.
+         */
+        PackedGeneratingMatrix operator*(const PackedGeneratingMatrix& m) const;
+
+        /** Returns the transpose of the matrix. The matrix should have at most 64 rows. */
+        PackedGeneratingMatrix transpose() const;
+
+        /** Swap the rows at position i1 and i2 of the matrix.
+         * @param i1 Position of the first row.
+         * @param i2 Position of the second row.
+         */
+        void swapRows(unsigned int i1, unsigned int i2) { std::swap(m_data[i1], m_data[i2]); }
+
+        /**
+         * Extends the matrix by stacking on the right the matrix \c block.
+         * @param block The matrix to stack. Should have the same number of rows as the base matrix.
+         */
+        void stackRight(const PackedGeneratingMatrix& block);
+
+        /**
+         * Extends the matrix by stacking below the matrix \c block.
+         * @param block The matrix to stack. Should have the same number of columns as the base matrix.
+         */
+        void stackBelow(const PackedGeneratingMatrix& block);
+
+        /** Overloads of << operator to print matrices. */
+        friend std::ostream& operator<<(std::ostream& os, const PackedGeneratingMatrix& mat);
+
+    private:
+        std::vector<Row> m_data; // data internal representation: one word per row
+        unsigned int m_nRows; // number of rows of the matrix
+        unsigned int m_nCols; // number of columns of the matrix
+};
+
+}
+#endif
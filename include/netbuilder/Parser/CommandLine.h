@@ -57,6 +57,8 @@ struct CommandLine {
    std::unique_ptr<FigureOfMerit::FigureOfMerit> m_figure;
    int m_verbose;
    unsigned int m_interlacingFactor;
+   unsigned int m_nThreads = 1;
+   unsigned int m_nProducerThreads = 0;
 
    std::unique_ptr<Task::Task> parse();
 };
@@ -108,13 +108,28 @@ struct ExplorationMethodParser
 
             auto genValues = NetDescriptionParser<NC,ET>::parse(commandLine, netDescritionString);
             auto net = std::make_unique<DigitalNet<NC>>(commandLine.m_dimension, commandLine.m_sizeParameter, std::move(genValues));
-            return std::make_unique<Task::Eval>(std::move(net), std::move(commandLine.m_figure), commandLine.m_verbose);
+            return std::make_unique<Task::Eval>(std::move(net), std::move(commandLine.m_figure), commandLine.m_verbose, commandLine.m_nThreads);
         }
         else if (name == "exhaustive"){
+            bool fullRankOnly = false;
+            if (explorationDescriptionStrings.size() == 2 && explorationDescriptionStrings[1] == "full-rank")
+            {
+                if (NC != NetConstruction::EXPLICIT)
+                {
+                    throw BadExplorationMethod("full-rank exhaustive exploration is only available for explicit nets");
+                }
+                fullRankOnly = true;
+            }
+            else if (explorationDescriptionStrings.size() > 1)
+            {
+                throw BadExplorationMethod("invalid option for the exhaustive exploration; see --help");
+            }
             return std::make_unique<Task::ExhaustiveSearch<NC, ET>>(commandLine.m_dimension,
                                                         commandLine.m_sizeParameter,
                                                         std::move(commandLine.m_figure),
-                                                        commandLine.m_verbose);
+                                                        commandLine.m_verbose,
+                                                        false,
+                                                        fullRankOnly);
         }
         else if (name == "random" || name == "random-CBC" || name == "mixed-CBC"){
             if (explorationDescriptionStrings.size() < 2){
@@ -150,7 +165,9 @@ struct ExplorationMethodParser
                                                             std::move(figure),
                                                             std::make_unique<Task::RandomCBCExplorer<NC, ET>>(commandLine.m_dimension, commandLine.m_sizeParameter, r),
                                                             commandLine.m_verbose,
-                                                            true);
+                                                            true,
+                                                            commandLine.m_nThreads,
+                                                            commandLine.m_nProducerThreads);
         }
 
         if (name == "mixed-CBC"){
@@ -164,7 +181,9 @@ struct ExplorationMethodParser
                                                             std::move(figure),
                                                             std::make_unique<Task::MixedCBCExplorer<NC, ET>>(commandLine.m_dimension, commandLine.m_sizeParameter, nbFullCoordinates, r), 
                                                             commandLine.m_verbose,
-                                                            true);
+                                                            true,
+                                                            commandLine.m_nThreads,
+                                                            commandLine.m_nProducerThreads);
         }
         else if (name == "full-CBC"){
             return std::make_unique<Task::CBCSearch<NC, ET,  Task::FullCBCExplorer>>(commandLine.m_dimension, 
@@ -172,7 +191,9 @@ struct ExplorationMethodParser
                                                                 std::move(figure),
                                                                 std::make_unique<Task::FullCBCExplorer<NC, ET>>(commandLine.m_dimension, commandLine.m_sizeParameter),
                                                                 commandLine.m_verbose,
-                                                                true);
+                                                                true,
+                                                                commandLine.m_nThreads,
+                                                                commandLine.m_nProducerThreads);
         }
         else{
             throw BadExplorationMethod(name + " is not a valid exploration method; see --help");
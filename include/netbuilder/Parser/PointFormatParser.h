@@ -0,0 +1,57 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NETBUILDER__PARSER__POINT_FORMAT_PARSER_H
+#define NETBUILDER__PARSER__POINT_FORMAT_PARSER_H
+
+#include "latbuilder/Parser/Common.h"
+#include "netbuilder/PointFile.h"
+
+namespace NetBuilder { namespace Parser {
+namespace lbp = LatBuilder::Parser;
+/**
+ * Exception thrown when trying to parse an invalid point format.
+ */
+class BadPointFormat : public lbp::ParserError {
+public:
+   BadPointFormat(const std::string& message):
+      lbp::ParserError("cannot parse point format string: " + message)
+   {}
+};
+
+/**
+ * Parser for the formats of point files.
+ */
+struct PointFormatParser {
+   typedef NetBuilder::PointFormat result_type;
+
+   static result_type parse(const std::string& str)
+   {
+      if (str == "float64")
+         return NetBuilder::PointFormat::FLOAT64;
+      else if (str == "float32")
+         return NetBuilder::PointFormat::FLOAT32;
+      else if (str == "uint32")
+         return NetBuilder::PointFormat::UINT32;
+      else if (str == "uint64")
+         return NetBuilder::PointFormat::UINT64;
+      throw BadPointFormat(str);
+   }
+};
+
+}}
+
+#endif
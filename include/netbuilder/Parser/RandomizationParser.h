@@ -0,0 +1,61 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NETBUILDER__PARSER__RANDOMIZATION_PARSER_H
+#define NETBUILDER__PARSER__RANDOMIZATION_PARSER_H
+
+#include "latbuilder/Parser/Common.h"
+#include "netbuilder/Types.h"
+
+namespace NetBuilder { namespace Parser {
+namespace lbp = LatBuilder::Parser;
+/**
+ * Exception thrown when trying to parse an invalid randomization.
+ */
+class BadRandomization : public lbp::ParserError {
+public:
+   BadRandomization(const std::string& message):
+      lbp::ParserError("cannot parse randomization string: " + message)
+   {}
+};
+
+/**
+ * Parser for the randomizations of digital nets.
+ */
+struct RandomizationParser {
+   typedef NetBuilder::Randomization result_type;
+
+   static result_type parse(const std::string& str)
+   {
+      if (str == "none")
+         return NetBuilder::Randomization::NONE;
+      else if (str == "random-shift")
+         return NetBuilder::Randomization::RANDOM_SHIFT;
+      else if (str == "digital-shift")
+         return NetBuilder::Randomization::DIGITAL_SHIFT;
+      else if (str == "lms")
+         return NetBuilder::Randomization::LMS;
+      else if (str == "lms-digital-shift")
+         return NetBuilder::Randomization::LMS_DIGITAL_SHIFT;
+      else if (str == "nested-uniform")
+         return NetBuilder::Randomization::NESTED_UNIFORM_SCRAMBLING;
+      throw BadRandomization(str);
+   }
+};
+
+}}
+
+#endif
@@ -0,0 +1,158 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file
+ * This file contains the binary file format used to export the points of lattices and digital nets.
+ */
+
+#ifndef NETBUILDER__POINT_FILE_H
+#define NETBUILDER__POINT_FILE_H
+
+#include "netbuilder/Types.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace NetBuilder {
+
+/**
+ * Format of the values of the points written in a point file.
+ * The real formats store the coordinates in \f$[0,1)\f$. The integer formats store the numerators of the coordinates,
+ * see PointFileHeader::modulus.
+ */
+enum class PointFormat {FLOAT64, FLOAT32, UINT32, UINT64};
+
+/**
+ * Order of the points in a point file.
+ * In the natural order, point \f$i\f$ is the point of index \f$i\f$ of the point set.
+ * In the Gray-code order, point \f$i\f$ is the point of index \f$i \oplus \lfloor i/2 \rfloor\f$ (see PointGenerator).
+ * In the radical-inverse order, used for embedded lattices with \f$b^m\f$ points, point \f$i\f$ is the point of index
+ * \f$b^m \phi_b(i)\f$, where \f$\phi_b\f$ is the radical inverse in base \f$b\f$, so that the first \f$b^k\f$ points
+ * form the lattice of level \f$k\f$ (see LatBuilder::LatticePointGenerator).
+ */
+enum class PointOrder {NATURAL, GRAY_CODE, RADICAL_INVERSE};
+
+/**
+ * Header of a point file. All the fields are written in the native byte order.
+ * The header is followed by <code>numReplicates * numPoints * dimension</code> values of the format given by \c format,
+ * point after point and replicate after replicate.
+ */
+struct PointFileHeader
+{
+    char magic[8]; // file signature, always "LATNETPT"
+    uint32_t version; // version of the file format
+    uint32_t headerSize; // size of the header in bytes, i.e. offset of the first point
+    uint32_t format; // format of the values (PointFormat)
+    uint32_t order; // order of the points (PointOrder)
+    uint64_t numPoints; // number of points
+    uint64_t dimension; // dimension of the points
+    uint64_t modulus; // for integer formats, coordinate = value / modulus, where 0 stands for 2 to the number of bits of the values
+    uint64_t numReplicates; // number of randomizations of the point set written one after the other, 1 if the points are not randomized
+    uint64_t reserved; // reserved for future use, set to zero
+};
+
+/**
+ * Options of the export of the points of a point set, as given on the command line.
+ */
+struct PointFileOptions
+{
+    std::string filename; // name of the file, empty if the points are not exported
+    PointFormat format = PointFormat::FLOAT64; // format of the values
+    bool useMemoryMap = false; // whether to write the file through a memory mapping
+    Randomization randomization = Randomization::NONE; // randomization of the points
+    bool bakerTransform = false; // whether to apply the baker's transformation to the points of ordinary lattices
+    unsigned int numReplicates = 1; // number of independent randomizations written
+    uint64_t seed = 0; // seed of the randomizations, 0 for the default seed
+};
+
+/**
+ * Writes a point file block after block, so that the memory used does not depend on the number of points.
+ * The blocks are either written through a stream or filled in place through a memory mapping of the file
+ * (on POSIX systems only; otherwise, the stream is used).
+ */
+class PointFileWriter
+{
+    public:
+
+        /**
+         * Function filling a block of points: it must write the points \c first to <code>first + count - 1</code>
+         * in the buffer \c points, in the format of the file. With several replicates, point \f$i\f$ of replicate \f$r\f$
+         * is the point \f$r n + i\f$, where \f$n\f$ is the number of points of a replicate.
+         */
+        typedef std::function<void (void* points, uInteger first, uInteger count)> BlockGenerator;
+
+        /// Default size of the blocks, in bytes.
+        static constexpr size_t defaultBlockBytes = size_t(1) << 24;
+
+        /**
+         * Constructor.
+         * @param filename Name of the file. The file is overwritten.
+         * @param format Format of the values.
+         * @param order Order of the points.
+         * @param numPoints Number of points of each replicate.
+         * @param dimension Dimension of the points.
+         * @param modulus Denominator of the values of integer formats (0 stands for 2 to the number of bits of the values).
+         * @param useMemoryMap Whether to write the file through a memory mapping.
+         * @param numReplicates Number of replicates of the point set.
+         * @param blockBytes Approximate size of the blocks, in bytes.
+         */
+        PointFileWriter(std::string filename, PointFormat format, PointOrder order, uInteger numPoints, Dimension dimension,
+                        uint64_t modulus = 0, bool useMemoryMap = false, uInteger numReplicates = 1, size_t blockBytes = defaultBlockBytes);
+
+        /**
+         * Returns the number of bytes of a value of format \c format.
+         * @param format Format of the values.
+         */
+        static size_t valueSize(PointFormat format);
+
+        /**
+         * Returns the header of the file.
+         */
+        PointFileHeader header() const;
+
+        /**
+         * Returns the number of points of the blocks.
+         */
+        uInteger blockSize() const { return m_blockSize; }
+
+        /**
+         * Writes the file.
+         * @param generateBlock Function filling the blocks of points, called with consecutive blocks in increasing order.
+         */
+        void write(const BlockGenerator& generateBlock) const;
+
+    private:
+
+        void writeStream(const BlockGenerator& generateBlock) const;
+
+        void writeMemoryMap(const BlockGenerator& generateBlock) const;
+
+        std::string m_filename; // name of the file
+        PointFormat m_format; // format of the values
+        PointOrder m_order; // order of the points
+        uInteger m_numPoints; // number of points of each replicate
+        Dimension m_dimension; // dimension of the points
+        uint64_t m_modulus; // denominator of the values of integer formats
+        bool m_useMemoryMap; // whether to write through a memory mapping
+        uInteger m_numReplicates; // number of replicates
+        uInteger m_blockSize; // number of points of the blocks
+};
+
+}
+
+#endif
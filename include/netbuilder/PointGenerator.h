@@ -0,0 +1,183 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file
+ * This file contains the generator of the points of a digital net in base 2.
+ */
+
+#ifndef NETBUILDER__POINT_GENERATOR_H
+#define NETBUILDER__POINT_GENERATOR_H
+
+#include "netbuilder/Types.h"
+#include "netbuilder/DigitalNet.h"
+#include "netbuilder/PointFile.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace NetBuilder {
+
+/** This class generates the points of a digital net in base 2 from the columns of its generating matrices.
+ *
+ * The points are enumerated in Gray-code order: the point at position \f$i\f$ is the point whose digit vector is the
+ * Gray code \f$i \oplus \lfloor i/2 \rfloor\f$ of \f$i\f$. Two consecutive points then only differ by one column of the
+ * generating matrices, so that each coordinate of a point is obtained from the previous point with a single XOR.
+ * The output is the same set of points as in the natural order, which is the one used by the Python interface.
+ *
+ * Each coordinate is computed as a 64-bit word whose most significant bit is the first digit of the coordinate.
+ * With an interlacing factor \f$d\f$, the components \f$jd, \dots, jd+d-1\f$ of the net form coordinate \f$j\f$ of the points
+ * and digit \f$i\f$ of component \f$jd+k\f$ is digit \f$id+k\f$ of the coordinate. Digits beyond the 64th are dropped and
+ * the real coordinates keep the first 53 digits, so that they always lie in \f$[0,1)\f$.
+ *
+ * The points are written in row-major order, one point after the other, either in a buffer provided by the caller or in a point
+ * file (see PointFileWriter). The enumeration can be split in blocks of consecutive positions which are generated by several threads.
+ */
+class PointGenerator {
+
+    public:
+
+        /// Type of the digits of a coordinate.
+        typedef uint64_t Digits;
+
+        /** Constructs the generator of the points of a digital net.
+         * @param net Digital net.
+         * @param interlacingFactor Interlacing factor of the net.
+         * @param nRows Number of rows of the generating matrices used to compute the points, i.e. their precision (at most 64).
+         * If zero, the generating matrices of the net are used as they are.
+         */
+        PointGenerator(const AbstractDigitalNet& net, unsigned int interlacingFactor = 1, unsigned int nRows = 0);
+
+        /** Constructs the generator of the points of a digital net given by the columns of its generating matrices.
+         * A column is read as a bit string with the first row in the most significant position, as returned by
+         * GeneratingMatrix::getColsReverse.
+         * @param nBits Number of rows of the generating matrices (at most 64).
+         * @param columns Columns of the generating matrices, one vector per component. All the components must have the same number of columns.
+         * @param interlacingFactor Interlacing factor of the net.
+         */
+        PointGenerator(unsigned int nBits, const std::vector<std::vector<unsigned long>>& columns, unsigned int interlacingFactor = 1);
+
+        /** Returns the number of points. */
+        uInteger numPoints() const { return m_numPoints; }
+
+        /** Returns the dimension of the points. */
+        Dimension dimension() const { return m_dimension; }
+
+        /** Returns the interlacing factor of the net. */
+        unsigned int interlacingFactor() const { return m_interlacingFactor; }
+
+        /** Generates the digits of the points at positions \c first to <code>first + count - 1</code> in Gray-code order.
+         * @param digits Buffer of size <code>count * dimension()</code> where the digits are written point after point.
+         * @param first Position of the first point.
+         * @param count Number of points.
+         */
+        void generateDigits(Digits* digits, uInteger first, uInteger count) const;
+
+        /** Generates the first 32 digits of the points at positions \c first to <code>first + count - 1</code> in Gray-code order.
+         * @param digits Buffer of size <code>count * dimension()</code> where the digits are written point after point.
+         * @param first Position of the first point.
+         * @param count Number of points.
+         */
+        void generateDigits(uint32_t* digits, uInteger first, uInteger count) const;
+
+        /** Generates the points at positions \c first to <code>first + count - 1</code> in Gray-code order.
+         * @param points Buffer of size <code>count * dimension()</code> where the points are written point after point.
+         * @param first Position of the first point.
+         * @param count Number of points.
+         */
+        void generate(Real* points, uInteger first, uInteger count) const;
+
+        /** Generates the points at positions \c first to <code>first + count - 1</code> in Gray-code order, in single precision.
+         * @param points Buffer of size <code>count * dimension()</code> where the points are written point after point.
+         * @param first Position of the first point.
+         * @param count Number of points.
+         */
+        void generate(float* points, uInteger first, uInteger count) const;
+
+        /** Generates the points at positions \c first to <code>first + count - 1</code> in Gray-code order, in the given format.
+         * The integer formats contain the first digits of the coordinates.
+         * @param format Format of the values.
+         * @param points Buffer of <code>count * dimension()</code> values where the points are written point after point.
+         * @param first Position of the first point.
+         * @param count Number of points.
+         */
+        void generate(PointFormat format, void* points, uInteger first, uInteger count) const;
+
+        /** Generates the points at positions \c first to <code>first + count - 1</code> in Gray-code order, in the given format,
+         * with several threads. Each thread generates a block of consecutive points.
+         * @param format Format of the values.
+         * @param points Buffer of <code>count * dimension()</code> values where the points are written point after point.
+         * @param first Position of the first point.
+         * @param count Number of points.
+         * @param nThreads Number of threads.
+         */
+        void generate(PointFormat format, void* points, uInteger first, uInteger count, unsigned int nThreads) const;
+
+        /** Generates all the points in Gray-code order.
+         * @param points Buffer of size <code>numPoints() * dimension()</code> where the points are written point after point.
+         * @param nThreads Number of threads. Each thread generates a block of consecutive points.
+         */
+        void generate(Real* points, unsigned int nThreads = 1) const;
+
+        /** Generates all the points in Gray-code order and writes them in a point file (see PointFileWriter), block after block.
+         * @param filename Name of the file. The file is overwritten.
+         * @param format Format of the values.
+         * @param useMemoryMap Whether to write the file through a memory mapping.
+         * @param nThreads Number of threads. Each thread generates a part of each block.
+         */
+        void generateToFile(const std::string& filename, PointFormat format = PointFormat::FLOAT64, bool useMemoryMap = false, unsigned int nThreads = 1) const;
+
+        /** Converts the digits of a coordinate to a real number in \f$[0,1)\f$.
+         * @param digits Digits of the coordinate.
+         */
+        static Real toReal(Digits digits) { return (Real) (int64_t) (digits >> 11) / (Real) (int64_t(1) << 53); }
+
+        /** Converts the digits of a coordinate to a single precision real number in \f$[0,1)\f$.
+         * @param digits Digits of the coordinate.
+         */
+        static float toFloat(Digits digits) { return (float) (int32_t) (digits >> 40) / (float) (int32_t(1) << 24); }
+
+    private:
+
+        /** Computes the direction numbers from the columns of the generating matrices. */
+        void init(unsigned int nBits, const std::vector<std::vector<unsigned long>>& columns);
+
+        /** Throws an exception if the positions \c first to <code>first + count - 1</code> are not all valid. */
+        void checkRange(uInteger first, uInteger count) const;
+
+        /** Computes the digits of the point at position \c position in Gray-code order.
+         * @param point Buffer of size dimension() where the digits are written.
+         * @param position Position of the point.
+         */
+        void initialDigits(Digits* point, uInteger position) const;
+
+        /** Enumerates the points at positions \c first to <code>first + count - 1</code> and writes their coordinates
+         * converted by \c convert.
+         */
+        template <typename T, typename CONVERT>
+        void enumerate(T* points, uInteger first, uInteger count, CONVERT convert) const;
+
+        Dimension m_dimension; // dimension of the points
+        unsigned int m_interlacingFactor; // interlacing factor of the net
+        unsigned int m_nCols; // number of columns of the generating matrices
+        uInteger m_numPoints; // number of points
+        std::vector<Digits> m_directions; // digits added by each column, m_directions[c * m_dimension + j] for column c and coordinate j
+};
+
+}
+
+#endif
@@ -0,0 +1,182 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file
+ * This file contains the generator of independent randomizations of a digital net in base 2.
+ */
+
+#ifndef NETBUILDER__RANDOMIZED_POINT_GENERATOR_H
+#define NETBUILDER__RANDOMIZED_POINT_GENERATOR_H
+
+#include "netbuilder/Types.h"
+#include "netbuilder/DigitalNet.h"
+#include "netbuilder/PointFile.h"
+#include "netbuilder/PointGenerator.h"
+
+#include "latbuilder/LFSR258.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace NetBuilder {
+
+/** This class generates independent randomizations, or replicates, of a digital net in base 2 for randomized quasi-Monte Carlo.
+ *
+ * The following randomizations are supported (see Randomization):
+ * - a random digital shift: each coordinate is XORed with a uniform 64-bit word;
+ * - a left matrix scramble (LMS): each generating matrix \f$C\f$ is replaced by \f$LC\f$, where \f$L\f$ is a \f$64 \times 63\f$ random
+ * lower-triangular matrix with ones on the diagonal drawn with GeneratingMatrix::createRandomLowerTriangularMatrix, optionally
+ * followed by a random digital shift;
+ * - a nested uniform scramble (Owen's scrambling): digit \f$k\f$ of each coordinate is flipped according to a random function of
+ * the first \f$k\f$ digits. The random functions are not stored but computed by hashing the digits with a random seed per coordinate.
+ * The first scramblingDepth() digits are scrambled this way, and the remaining digits are XORed with a hash of the first ones.
+ *
+ * The random numbers of replicate \f$r\f$ are drawn from the <tt>LFSR258</tt> generator \cite rLEC99a started from the seed of the
+ * generator and jumped \f$r\f$ times ahead by \f$2^{100}\f$ steps, so that each replicate only depends on the seed and on its index,
+ * and not on the number of threads or on the replicates generated before.
+ *
+ * As with PointGenerator, the points of each replicate are enumerated in Gray-code order and can be split in blocks of consecutive
+ * positions generated by several threads.
+ */
+class RandomizedPointGenerator {
+
+    public:
+
+        typedef PointGenerator::Digits Digits;
+
+        /** One randomization of the digital net. */
+        class Replicate {
+
+            public:
+
+                /** Returns the number of points. */
+                uInteger numPoints() const { return m_points.numPoints(); }
+
+                /** Returns the dimension of the points. */
+                Dimension dimension() const { return m_points.dimension(); }
+
+                /** Generates the digits of the randomized points at positions \c first to <code>first + count - 1</code> in Gray-code order.
+                 * @param digits Buffer of size <code>count * dimension()</code> where the digits are written point after point.
+                 * @param first Position of the first point.
+                 * @param count Number of points.
+                 */
+                void generateDigits(Digits* digits, uInteger first, uInteger count) const;
+
+                /** Generates the randomized points at positions \c first to <code>first + count - 1</code> in Gray-code order, in the given format.
+                 * The integer formats contain the first digits of the coordinates.
+                 * @param format Format of the values.
+                 * @param points Buffer of <code>count * dimension()</code> values where the points are written point after point.
+                 * @param first Position of the first point.
+                 * @param count Number of points.
+                 */
+                void generate(PointFormat format, void* points, uInteger first, uInteger count) const;
+
+            private:
+
+                friend class RandomizedPointGenerator;
+
+                Replicate(PointGenerator points, std::vector<Digits> shift, std::vector<uint64_t> scramblingSeeds, unsigned int scramblingDepth);
+
+                /** Applies the digital shift and the nested uniform scramble to a block of points. */
+                void randomize(Digits* digits, uInteger count) const;
+
+                PointGenerator m_points; // generator of the points of the net, scrambled by the LMS if any
+                std::vector<Digits> m_shift; // digital shift of each coordinate, empty if none
+                std::vector<uint64_t> m_scramblingSeeds; // seed of the nested uniform scramble of each coordinate, empty if none
+                unsigned int m_scramblingDepth; // number of digits scrambled one by one
+        };
+
+        /** Constructs the generator of the randomizations of a digital net.
+         * @param net Digital net.
+         * @param randomization Randomization of the net.
+         * @param interlacingFactor Interlacing factor of the net.
+         * @param seed Seed of the <tt>LFSR258</tt> generator.
+         * @param scramblingDepth Number of digits scrambled one by one by the nested uniform scramble (at most 64).
+         * If zero, the number of columns of the generating matrices times the interlacing factor is used.
+         */
+        RandomizedPointGenerator(const AbstractDigitalNet& net, Randomization randomization, unsigned int interlacingFactor = 1,
+                                 LatBuilder::LFSR258::seed_type seed = LatBuilder::LFSR258::default_seed, unsigned int scramblingDepth = 0);
+
+        /** Returns a valid seed of the <tt>LFSR258</tt> generator derived from an integer, for instance given on the command line.
+         * @param seed Integer seed.
+         */
+        static LatBuilder::LFSR258::seed_type seedFromInteger(uint64_t seed);
+
+        /** Returns the number of points of each replicate. */
+        uInteger numPoints() const { return uInteger(1) << m_nCols; }
+
+        /** Returns the dimension of the points. */
+        Dimension dimension() const { return m_columns.size() / m_interlacingFactor; }
+
+        /** Returns the randomization of the net. */
+        Randomization randomization() const { return m_randomization; }
+
+        /** Returns the number of digits scrambled one by one by the nested uniform scramble. */
+        unsigned int scramblingDepth() const { return m_scramblingDepth; }
+
+        /** Draws replicate \c replicate.
+         * @param replicate Index of the replicate.
+         */
+        Replicate replicate(unsigned int replicate) const;
+
+        /** Generates the replicates \c firstReplicate to <code>firstReplicate + numReplicates - 1</code> in the given format, one after the other,
+         * with several threads. The work is split in blocks of consecutive points of the replicates.
+         * @param format Format of the values.
+         * @param points Buffer of <code>numReplicates * numPoints() * dimension()</code> values where the points are written.
+         * @param firstReplicate Index of the first replicate.
+         * @param numReplicates Number of replicates.
+         * @param nThreads Number of threads.
+         */
+        void generateReplicates(PointFormat format, void* points, unsigned int firstReplicate, unsigned int numReplicates, unsigned int nThreads = 1) const;
+
+        /** Generates the replicates \c 0 to <code>numReplicates - 1</code> and writes them one after the other in a point file
+         * (see PointFileWriter), block after block.
+         * @param filename Name of the file. The file is overwritten.
+         * @param numReplicates Number of replicates.
+         * @param format Format of the values.
+         * @param useMemoryMap Whether to write the file through a memory mapping.
+         * @param nThreads Number of threads. Each thread generates a part of each block.
+         */
+        void generateToFile(const std::string& filename, unsigned int numReplicates, PointFormat format = PointFormat::FLOAT64, bool useMemoryMap = false, unsigned int nThreads = 1) const;
+
+    private:
+
+        /** Draws the replicate from the state of the random generator for this replicate. */
+        Replicate draw(LatBuilder::LFSR258 randomGen) const;
+
+        /** Generates the points at global positions \c first to <code>first + count - 1</code> of the given replicates, where the
+         * global position of point \f$i\f$ of replicate \f$r\f$ is \f$rn+i\f$, with several threads.
+         */
+        void generateBlock(const std::vector<Replicate>& replicates, PointFormat format, void* points, uInteger first, uInteger count, unsigned int nThreads) const;
+
+        /** Draws the replicates \c firstReplicate to <code>firstReplicate + numReplicates - 1</code>. */
+        std::vector<Replicate> replicates(unsigned int firstReplicate, unsigned int numReplicates) const;
+
+        static constexpr unsigned int s_nRows = 63; // number of rows of the generating matrices before the LMS
+
+        Randomization m_randomization; // randomization of the net
+        unsigned int m_interlacingFactor; // interlacing factor of the net
+        unsigned int m_nCols; // number of columns of the generating matrices
+        unsigned int m_scramblingDepth; // number of digits scrambled one by one by the nested uniform scramble
+        LatBuilder::LFSR258::seed_type m_seed; // seed of the random generator
+        std::vector<std::vector<unsigned long>> m_columns; // columns of the generating matrices with s_nRows rows, one vector per component
+};
+
+}
+
+#endif
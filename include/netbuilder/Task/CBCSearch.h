@@ -18,6 +18,13 @@
 #define NETBUILDER__TASK__CBC_SEARCH_H
 
 #include "netbuilder/Task/Search.h"
+#include "netbuilder/Helpers/RingBuffer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 namespace NetBuilder { namespace Task {
 
@@ -28,6 +35,10 @@ namespace NetBuilder { namespace Task {
  * - <CODE> void reset() </CODE>: reset to its initial state the explorer.
  * - <CODE> void switchToCoordinate(Dimension coord) </CODE>: switch the explorer to coordinate \c coord.
  * - <CODE> typename NetConstructionTraits<NC>::GenValue nextGenValue() </CODE>: return the next generating value.
+ * - <CODE> size_t nextGenValues(std::vector<typename NetConstructionTraits<NC>::GenValue>& genValues) </CODE>: fill a block with the next 
+ * generating values and return their number.
+ * The block of generating values is reused for all the blocks, and the generating matrix of each candidate is filled in place 
+ * by NetConstructionTraits<NC>::fillGeneratingMatrix in a matrix released by a previous candidate.
  * - <CODE> bool isOver() </CODE>: indicate whether the exploration of the current coordinate is over.
  * where NC is the template parameter of EXPLORER.
  */ 
@@ -44,16 +55,23 @@ class CBCSearch : public Search<NC, ET, OBSERVER>
          * @param explorer Explorer to search for nets.
          * @param verbose Verbosity level.
          * @param earlyAbortion Early-abortion switch. If true, the computations will be stopped if the net is worse than the best one so far.
+         * @param nThreads Number of threads used to evaluate the candidate nets.
+         * @param nProducerThreads Number of threads constructing the candidate nets for the evaluation threads. If zero,
+         * the candidate nets are constructed by the evaluation threads.
          */
         CBCSearch(  Dimension dimension, 
                     typename NetConstructionTraits<NC>::SizeParameter sizeParameter,
                     std::unique_ptr<FigureOfMerit::CBCFigureOfMerit> figure,
                     std::unique_ptr<Explorer> explorer = std::make_unique<Explorer>(),
                     int verbose = 0,
-                    bool earlyAbortion = false):
+                    bool earlyAbortion = false,
+                    unsigned int nThreads = 1,
+                    unsigned int nProducerThreads = 0):
             Search<NC, ET, OBSERVER>(dimension, sizeParameter, verbose, earlyAbortion),
             m_figure(std::move(figure)),
-            m_explorer(std::move(explorer))
+            m_explorer(std::move(explorer)),
+            m_nThreads(std::max(nThreads, 1u)),
+            m_nProducerThreads(nProducerThreads)
         {};
 
         /** Constructor.
@@ -63,16 +81,23 @@ class CBCSearch : public Search<NC, ET, OBSERVER>
          * @param explorer Explorer to search for nets.
          * @param verbose Verbosity level.
          * @param earlyAbortion Early-abortion switch. If true, the computations will be stopped if the net is worse than the best one so far.
+         * @param nThreads Number of threads used to evaluate the candidate nets.
+         * @param nProducerThreads Number of threads constructing the candidate nets for the evaluation threads. If zero,
+         * the candidate nets are constructed by the evaluation threads.
          */
         CBCSearch(  Dimension dimension, 
                     std::unique_ptr<DigitalNet<NC>> baseNet,
                     std::unique_ptr<FigureOfMerit::CBCFigureOfMerit> figure,
                     std::unique_ptr<Explorer> explorer = std::make_unique<Explorer>(),
                     int verbose = 0,
-                    bool earlyAbortion = false):
+                    bool earlyAbortion = false,
+                    unsigned int nThreads = 1,
+                    unsigned int nProducerThreads = 0):
             Search<NC, ET, OBSERVER>(dimension, std::move(baseNet), verbose, earlyAbortion),
             m_figure(std::move(figure)),
-            m_explorer(std::move(explorer))
+            m_explorer(std::move(explorer)),
+            m_nThreads(std::max(nThreads, 1u)),
+            m_nProducerThreads(nProducerThreads)
         {};
 
         /** 
@@ -95,6 +120,14 @@ class CBCSearch : public Search<NC, ET, OBSERVER>
             std::ostringstream stream;
             stream << Search<NC, ET, OBSERVER>::format();
             stream << "Exploration method: CBC - " << m_explorer->format() << std::endl;
+            if (m_nThreads > 1)
+            {
+                stream << "Number of threads: " << m_nThreads << std::endl;
+            }
+            if (m_nProducerThreads > 0)
+            {
+                stream << "Number of producer threads: " << m_nProducerThreads << std::endl;
+            }
             stream << "Figure of merit: " << m_figure->format() << std::endl;
             res += stream.str();
             stream.str(std::string());
@@ -104,6 +137,10 @@ class CBCSearch : public Search<NC, ET, OBSERVER>
         /**
          * Executes the search task.
          * The best net and merit value are set in the process.
+         * With more than one thread, the candidate nets of each coordinate are evaluated concurrently, each thread having its own evaluator.
+         * With producer threads, the construction of the candidate nets and their evaluation are pipelined: the producer threads
+         * construct the candidate nets while the evaluation threads evaluate the ones already constructed.
+         * The observer still receives the candidates in the order of the explorer, so that the selected net is the same as with one thread.
          */
         virtual void execute() override
         {
@@ -126,35 +163,53 @@ class CBCSearch : public Search<NC, ET, OBSERVER>
                 evaluator->onAbort().connect(boost::bind(&Search<NC, ET, OBSERVER>::Observer::onAbort, &this->observer(), boost::placeholders::_1));
             }
 
+            std::vector<std::unique_ptr<Worker>> workers = createWorkers(); // empty if the search is sequential
+
             m_explorer->switchToCoordinate(this->observer().bestNet().dimension()); // to to the first dimension to explore
 
             for(Dimension coord = this->observer().bestNet().dimension() ; coord < this->dimension(); ++coord) // for each dimension to explore
             {
                 evaluator->prepareForNextDimension();
+                for(auto& worker : workers)
+                {
+                    worker->evaluator->prepareForNextDimension();
+                }
                 if(this->m_verbose>=1 && coord > 0)
                 {
                     std::cout << "Begin coordinate: " << coord + 1 << "/" << this->dimension() << std::endl;
                 }
                 auto net = this->m_observer->bestNet(); // base net of the search
-                while(!m_explorer->isOver()) // for each generating values provided by the explorer
+                if (workers.empty())
                 {
-                    auto newNet = net.appendNewCoordinate(m_explorer->nextGenValue());
-                    unsigned long totalSize = m_explorer->size();
-                    if (this->m_verbose>=2 && ((totalSize > 100 && m_explorer->count() % 100 == 0) || (m_explorer->count() % 10 == 0)))
-                    {
-                        std::cout << "Coordinate " << coord + 1 << "/" << this->dimension() << " - net " << m_explorer->count() << "/" << totalSize << std::endl;
-                    }
-                    double newMerit = (*evaluator)(*newNet,coord,merit, this->m_verbose-3); // evaluate the net
-                    if (this->m_observer->observe(std::move(newNet),newMerit)) // give it to the observer
-                    {
-                        evaluator->lastNetWasBest();
-                    }
+                    exploreCoordinate(*evaluator, net, coord, merit);
+                }
+                else if (m_nProducerThreads > 0)
+                {
+                    exploreCoordinatePipelined(workers, net, coord, merit);
+                }
+                else
+                {
+                    exploreCoordinateInParallel(workers, net, coord, merit);
                 }
                 if (!this->m_observer->hasFoundNet())
                 {
                     this->onFailedSearch()(*this); // fails if the search has failed
                     return;
                 }
+                for(auto& worker : workers)
+                {
+                    worker->bestMerit = std::numeric_limits<Real>::infinity();
+                }
+                if (!workers.empty()) // bring the evaluators of the threads to the state of the selected net, which is evaluated once
+                {
+                    const FigureOfMerit::CBCFigureOfMeritEvaluator& source = *workers[0]->evaluator;
+                    (*workers[0]->evaluator)(this->m_observer->bestNet(), coord, merit);
+                    workers[0]->evaluator->lastNetWasBest();
+                    for(size_t w = 1; w < workers.size(); ++w)
+                    {
+                        workers[w]->evaluator->copyBestNet(source);
+                    }
+                }
                 merit = this->m_observer->bestMerit();
                 if(this->m_verbose>=1)
                 {
@@ -194,10 +249,452 @@ class CBCSearch : public Search<NC, ET, OBSERVER>
         }
 
     private:
+        /**
+         * Evaluation state of a thread: its own evaluator and the best merit of the candidates which precede
+         * the ones it evaluates, used for early abortion.
+         */
+        struct Worker
+        {
+            std::unique_ptr<FigureOfMerit::CBCFigureOfMeritEvaluator> evaluator;
+            Real bestMerit = std::numeric_limits<Real>::infinity();
+            std::atomic<Real> publishedMerit{std::numeric_limits<Real>::infinity()}; // best merit published by the other threads in pipelined searches
+        };
+
+        /// Number of batches of candidates per thread pulled at once from the explorer.
+        static constexpr unsigned int batchesPerThread = 8;
+
+        /**
+         * Creates one evaluator per thread and brings it to the state of the base net, or none if the search is sequential.
+         */
+        std::vector<std::unique_ptr<Worker>> createWorkers()
+        {
+            std::vector<std::unique_ptr<Worker>> workers;
+            if (m_nThreads <= 1 && m_nProducerThreads == 0)
+            {
+                return workers;
+            }
+            for(unsigned int i = 0; i < m_nThreads; ++i)
+            {
+                auto worker = std::make_unique<Worker>();
+                worker->evaluator = m_figure->evaluator();
+                Real merit = 0;
+                for(Dimension coord = 0; coord < this->observer().bestNet().dimension(); ++coord)
+                {
+                    worker->evaluator->prepareForNextDimension();
+                    merit = (*worker->evaluator)(this->observer().bestNet(), coord, merit);
+                    worker->evaluator->lastNetWasBest();
+                }
+                if (this->m_earlyAbortion)
+                {
+                    // a candidate can only be aborted by candidates which precede it, so that ties are broken as in the sequential search
+                    Worker* w = worker.get();
+                    worker->evaluator->onProgress().connect([w](const MeritValue& value) { return value < w->bestMerit && value < w->publishedMerit.load(std::memory_order_relaxed); });
+                }
+                workers.push_back(std::move(worker));
+            }
+            return workers;
+        }
+
+        /**
+         * Evaluates one by one, or by batches if the evaluator supports it, the candidates of coordinate \c coord provided by the explorer.
+         * @param evaluator Evaluator of the figure of merit.
+         * @param net Base net of the search.
+         * @param coord Coordinate to explore.
+         * @param merit Merit of the base net.
+         */
+        void exploreCoordinate(FigureOfMerit::CBCFigureOfMeritEvaluator& evaluator, const DigitalNet<NC>& net, Dimension coord, Real merit)
+        {
+            const unsigned int batchSize = evaluator.batchSize(); // number of nets the evaluator can handle at once
+            std::vector<typename NetConstructionTraits<NC>::GenValue> genValues(batchSize); // block reused for all the batches
+            std::vector<std::unique_ptr<DigitalNet<NC>>> newNets;
+            std::vector<const AbstractDigitalNet*> batch;
+            while(!m_explorer->isOver()) // for each batch of generating values provided by the explorer
+            {
+                const size_t n = m_explorer->nextGenValues(genValues);
+                printProgress(coord, n);
+                newNets.clear();
+                batch.clear();
+                for(size_t i = 0; i < n; ++i)
+                {
+                    newNets.push_back(net.appendNewCoordinate(genValues[i]));
+                    batch.push_back(newNets.back().get());
+                }
+                std::vector<MeritValue> newMerits = evaluator.evaluateBatch(batch, coord, merit, this->m_verbose-3); // evaluate the nets
+                for(unsigned int i = 0; i < newNets.size(); ++i)
+                {
+                    if (this->m_observer->observe(std::move(newNets[i]),newMerits[i])) // give it to the observer
+                    {
+                        evaluator.batchNetWasBest(i);
+                    }
+                }
+            }
+        }
+
+        /**
+         * Evaluates concurrently all the candidates of coordinate \c coord provided by the explorer.
+         * The threads are started once for the coordinate. The candidates are pulled by blocks from the explorer by the calling thread,
+         * and each thread evaluates batches of consecutive candidates of the block.
+         * The candidates of a block are then given to the observer in the order of the explorer, while the other threads wait for the next block.
+         * @param workers Evaluation states of the threads.
+         * @param net Base net of the search.
+         * @param coord Coordinate to explore.
+         * @param merit Merit of the base net.
+         */
+        void exploreCoordinateInParallel(std::vector<std::unique_ptr<Worker>>& workers, const DigitalNet<NC>& net, Dimension coord, Real merit)
+        {
+            const size_t batchSize = workers[0]->evaluator->batchSize();
+            const size_t blockSize = batchSize * batchesPerThread * workers.size();
+
+            std::vector<typename NetConstructionTraits<NC>::GenValue> genValues(blockSize); // block reused for all the blocks
+            std::vector<std::unique_ptr<DigitalNet<NC>>> newNets;
+            std::vector<MeritValue> newMerits;
+            std::vector<std::exception_ptr> errors(workers.size());
+            std::vector<std::vector<const AbstractDigitalNet*>> batches(workers.size()); // batch of each thread
+
+            // state of the current block, written by the calling thread before the block is handed to the other threads
+            size_t n = 0; // number of candidates of the block
+            size_t nBatches = 0;
+            std::atomic<size_t> nextBatch(0);
+            Real bestMerit = std::numeric_limits<Real>::infinity(); // best merit of the previous blocks
+
+            std::mutex mutex; // protects the following variables
+            std::condition_variable blockReady;
+            std::condition_variable blockDone;
+            size_t nBlocks = 0; // number of blocks handed to the threads
+            unsigned int nBusy = 0; // number of other threads evaluating the current block
+            bool over = false; // whether the exploration of the coordinate is over
+
+            auto work = [&](unsigned int w)
+            {
+                try
+                {
+                    Worker& worker = *workers[w];
+                    worker.bestMerit = bestMerit;
+                    std::vector<const AbstractDigitalNet*>& batch = batches[w];
+                    for(size_t b = nextBatch++; b < nBatches; b = nextBatch++) // batches are taken in increasing order
+                    {
+                        const size_t begin = b * batchSize;
+                        const size_t end = std::min(begin + batchSize, n);
+                        batch.clear();
+                        for(size_t i = begin; i < end; ++i)
+                        {
+                            newNets[i] = net.appendNewCoordinate(genValues[i]);
+                            batch.push_back(newNets[i].get());
+                        }
+                        std::vector<MeritValue> merits = worker.evaluator->evaluateBatch(batch, coord, merit, this->m_verbose-3); // evaluate the nets
+                        for(size_t i = begin; i < end; ++i)
+                        {
+                            newMerits[i] = merits[i - begin];
+                            worker.bestMerit = std::min(worker.bestMerit, newMerits[i]);
+                        }
+                    }
+                }
+                catch(...)
+                {
+                    errors[w] = std::current_exception();
+                }
+            };
+
+            auto loop = [&](unsigned int w)
+            {
+                size_t nSeen = 0;
+                while (true)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        blockReady.wait(lock, [&]() { return over || nBlocks > nSeen; });
+                        if (over)
+                        {
+                            return;
+                        }
+                        nSeen = nBlocks;
+                    }
+                    work(w);
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (--nBusy == 0)
+                    {
+                        blockDone.notify_one();
+                    }
+                }
+            };
+
+            std::vector<std::thread> threads;
+            for(unsigned int w = 1; w < workers.size(); ++w)
+            {
+                threads.emplace_back(loop, w);
+            }
+
+            std::exception_ptr error;
+            try
+            {
+                while(!m_explorer->isOver() && !error) // for each block of generating values provided by the explorer
+                {
+                    n = m_explorer->nextGenValues(genValues);
+                    printProgress(coord, n);
+                    newNets.clear();
+                    newNets.resize(n);
+                    newMerits.assign(n, std::numeric_limits<Real>::infinity());
+                    nBatches = (n + batchSize - 1) / batchSize;
+                    nextBatch = 0;
+                    bestMerit = this->m_observer->bestMerit();
+
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        ++nBlocks;
+                        nBusy = (unsigned int) threads.size();
+                    }
+                    blockReady.notify_all();
+                    work(0);
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        blockDone.wait(lock, [&]() { return nBusy == 0; });
+                    }
+
+                    for(const auto& e : errors)
+                    {
+                        if (e && !error)
+                        {
+                            error = e;
+                        }
+                    }
+                    if (!error)
+                    {
+                        for(size_t i = 0; i < newNets.size(); ++i)
+                        {
+                            this->m_observer->observe(std::move(newNets[i]), newMerits[i]); // give it to the observer
+                        }
+                    }
+                }
+            }
+            catch(...)
+            {
+                error = std::current_exception();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                over = true;
+            }
+            blockReady.notify_all();
+            for(auto& thread : threads)
+            {
+                thread.join();
+            }
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        /**
+         * Evaluates all the candidates of coordinate \c coord provided by the explorer with producer and evaluation threads.
+         *
+         * The producer threads pull blocks of generating values from the explorer, construct the candidate nets and pass their
+         * indices to the evaluation threads through a RingBuffer. The candidates are numbered in the order of the explorer, and a
+         * producer waits before constructing a candidate more than a window of candidates ahead of the first one not yet given
+         * to the observer, so that the memory used is bounded. Once evaluated, the candidates are given to the observer in the
+         * order of the explorer, and each new best merit is published to the evaluation threads as the threshold of early abortion.
+         * As the candidates given to the observer precede the ones being evaluated, the selected net is the same as with one thread.
+         * @param workers Evaluation states of the evaluation threads.
+         * @param net Base net of the search.
+         * @param coord Coordinate to explore.
+         * @param merit Merit of the base net.
+         */
+        void exploreCoordinatePipelined(std::vector<std::unique_ptr<Worker>>& workers, const DigitalNet<NC>& net, Dimension coord, Real merit)
+        {
+            const size_t batchSize = workers[0]->evaluator->batchSize();
+            RingBuffer<size_t> queue(batchSize * batchesPerThread * workers.size()); // indices of the constructed candidates
+            const size_t window = queue.capacity(); // maximal number of candidates constructed but not yet observed
+
+            struct Slot
+            {
+                std::unique_ptr<DigitalNet<NC>> net;
+                MeritValue merit;
+                bool evaluated = false;
+            };
+            std::vector<Slot> slots(window); // candidate i is stored in slot i % window
+
+            std::mutex explorerMutex; // protects the explorer
+            size_t nextIndex = 0; // index of the next candidate pulled from the explorer
+            std::mutex observerMutex; // protects the observer, the slots which are evaluated and the number of observed candidates
+            std::condition_variable windowMoved; // signaled when candidates are given to the observer or on failure
+            size_t nObserved = 0; // number of candidates given to the observer
+            std::atomic<unsigned int> nProducersDone(0);
+            std::atomic<bool> failed(false);
+            std::vector<std::exception_ptr> errors(m_nProducerThreads + workers.size());
+
+            auto fail = [&]()
+            {
+                failed.store(true);
+                queue.close();
+                std::lock_guard<std::mutex> lock(observerMutex);
+                windowMoved.notify_all();
+            };
+
+            for(auto& worker : workers)
+            {
+                worker->bestMerit = std::numeric_limits<Real>::infinity();
+                worker->publishedMerit.store(this->m_observer->bestMerit(), std::memory_order_relaxed);
+            }
+
+            auto produce = [&](unsigned int p)
+            {
+                try
+                {
+                    std::vector<typename NetConstructionTraits<NC>::GenValue> genValues(batchSize);
+                    while (!failed.load(std::memory_order_relaxed))
+                    {
+                        size_t first;
+                        size_t n;
+                        {
+                            std::lock_guard<std::mutex> lock(explorerMutex);
+                            n = m_explorer->nextGenValues(genValues);
+                            first = nextIndex;
+                            nextIndex += n;
+                            printProgress(coord, n);
+                        }
+                        if (n == 0)
+                        {
+                            break;
+                        }
+                        for(size_t i = first; i < first + n; ++i)
+                        {
+                            {
+                                std::unique_lock<std::mutex> lock(observerMutex);
+                                windowMoved.wait(lock, [&] { return i < nObserved + window || failed.load(std::memory_order_relaxed); }); // back-pressure
+                            }
+                            if (failed.load(std::memory_order_relaxed))
+                            {
+                                break;
+                            }
+                            slots[i % window].net = net.appendNewCoordinate(genValues[i - first]);
+                            if (!queue.push(i))
+                            {
+                                break;
+                            }
+                        }
+                    }
+                }
+                catch(...)
+                {
+                    errors[p] = std::current_exception();
+                    fail();
+                }
+                if (nProducersDone.fetch_add(1) + 1 == m_nProducerThreads)
+                {
+                    queue.close(); // the evaluation threads stop once the queue is empty
+                }
+            };
+
+            auto consume = [&](unsigned int w)
+            {
+                try
+                {
+                    Worker& worker = *workers[w];
+                    std::vector<size_t> indices;
+                    std::vector<const AbstractDigitalNet*> batch;
+                    size_t i;
+                    while (!failed.load(std::memory_order_relaxed) && queue.pop(i))
+                    {
+                        indices.clear();
+                        batch.clear();
+                        do
+                        {
+                            indices.push_back(i);
+                            batch.push_back(slots[i % window].net.get());
+                        }
+                        while (indices.size() < batchSize && queue.tryPop(i));
+                        std::vector<MeritValue> merits = worker.evaluator->evaluateBatch(batch, coord, merit, this->m_verbose-3); // evaluate the nets
+
+                        std::lock_guard<std::mutex> lock(observerMutex);
+                        for(size_t k = 0; k < indices.size(); ++k)
+                        {
+                            slots[indices[k] % window].merit = merits[k];
+                            slots[indices[k] % window].evaluated = true;
+                        }
+                        const size_t firstObserved = nObserved;
+                        while (slots[nObserved % window].evaluated) // give the candidates to the observer in the order of the explorer
+                        {
+                            Slot& slot = slots[nObserved % window];
+                            slot.evaluated = false;
+                            if (this->m_observer->observe(std::move(slot.net), slot.merit))
+                            {
+                                for(auto& other : workers)
+                                {
+                                    other->publishedMerit.store(this->m_observer->bestMerit(), std::memory_order_relaxed);
+                                }
+                            }
+                            slot.net.reset();
+                            ++nObserved;
+                        }
+                        if (nObserved != firstObserved)
+                        {
+                            windowMoved.notify_all();
+                        }
+                    }
+                }
+                catch(...)
+                {
+                    errors[m_nProducerThreads + w] = std::current_exception();
+                    fail();
+                }
+            };
+
+            std::vector<std::thread> threads;
+            for(unsigned int p = 0; p < m_nProducerThreads; ++p)
+            {
+                threads.emplace_back(produce, p);
+            }
+            for(unsigned int w = 1; w < workers.size(); ++w)
+            {
+                threads.emplace_back(consume, w);
+            }
+            consume(0);
+            for(auto& thread : threads)
+            {
+                thread.join();
+            }
+            for(const auto& error : errors)
+            {
+                if (error)
+                {
+                    std::rethrow_exception(error);
+                }
+            }
+            for(auto& worker : workers)
+            {
+                worker->publishedMerit.store(std::numeric_limits<Real>::infinity(), std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * Prints the progress of the exploration of coordinate \c coord after \c n generating values were pulled from the explorer.
+         */
+        void printProgress(Dimension coord, size_t n) const
+        {
+            if (this->m_verbose < 2)
+            {
+                return;
+            }
+            const unsigned long totalSize = m_explorer->size();
+            for(size_t count = m_explorer->count() - n + 1; count <= m_explorer->count(); ++count)
+            {
+                if ((totalSize > 100 && count % 100 == 0) || (count % 10 == 0))
+                {
+                    std::cout << "Coordinate " << coord + 1 << "/" << this->dimension() << " - net " << count << "/" << totalSize << std::endl;
+                }
+            }
+        }
+
         std::unique_ptr<FigureOfMerit::CBCFigureOfMerit> m_figure;
         std::unique_ptr<Explorer> m_explorer;
+        unsigned int m_nThreads; // number of threads used to evaluate the candidate nets
+        unsigned int m_nProducerThreads; // number of threads constructing the candidate nets, zero if they are constructed by the evaluation threads
 };
 
+template < NetConstruction NC, EmbeddingType ET, template <NetConstruction, EmbeddingType> class EXPLORER, template <NetConstruction> class OBSERVER>
+constexpr unsigned int CBCSearch<NC, ET, EXPLORER, OBSERVER>::batchesPerThread;
+
 }}
 
 
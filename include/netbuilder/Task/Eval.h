@@ -33,11 +33,12 @@ class Eval : public Task
 {
     public:
 
-        Eval(std::unique_ptr<AbstractDigitalNet> net, std::unique_ptr<FigureOfMerit::FigureOfMerit> figure, int verbose = 0):
+        Eval(std::unique_ptr<AbstractDigitalNet> net, std::unique_ptr<FigureOfMerit::FigureOfMerit> figure, int verbose = 0, unsigned int nThreads = 1):
             m_net(std::move(net)),
             m_merit(0),
             m_figure(std::move(figure)),
-            m_verbose(verbose)
+            m_verbose(verbose),
+            m_nThreads(nThreads)
         {};
 
         Eval(Eval&&) = default;
@@ -66,6 +67,12 @@ class Eval : public Task
         virtual std::string outputNet(OutputStyle outputStyle, unsigned int interlacingFactor) const 
         { return net().format(outputStyle, interlacingFactor); }
 
+        /**
+        * Returns the evaluated net.
+        */
+        virtual const AbstractDigitalNet& outputNetObject() const 
+        { return net(); }
+
         /**
          *  Returns information about the task
          */
@@ -78,6 +85,10 @@ class Eval : public Task
             stream << "Evaluation of the net:" << std::endl;
             stream << m_net->format(OutputStyle::TERMINAL, 1);
             stream << "Figure of merit: " << m_figure->format() << std::endl;
+            if (m_nThreads > 1)
+            {
+                stream << "Number of threads: " << m_nThreads << std::endl;
+            }
             res += stream.str();
             stream.str(std::string());
             return res;
@@ -108,6 +119,7 @@ class Eval : public Task
         virtual void execute() {
 
             auto evaluator = m_figure->evaluator(); 
+            evaluator->setNumThreads(m_nThreads);
             m_merit = evaluator->operator()(*m_net, m_verbose);
         }
 
@@ -128,6 +140,7 @@ class Eval : public Task
         Real m_merit;
         std::unique_ptr<FigureOfMerit::FigureOfMerit> m_figure;
         int m_verbose;
+        unsigned int m_nThreads;
 
 };
 
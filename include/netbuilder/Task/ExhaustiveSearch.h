@@ -18,11 +18,17 @@
 #define NETBUILDER__TASK__EXHAUSTIVE_SEARCH_H
 
 #include "netbuilder/Task/Search.h"
+#include "netbuilder/Helpers/GrayCodeMatrixEnumerator.h"
+
+#include <type_traits>
 
 namespace NetBuilder { namespace Task {
 
 /** 
  * Class for exhaustive search tasks.
+ * For explicit nets, the tuples of generating matrices are enumerated in a Gray-code order by a GrayCodeMatrixEnumerator
+ * instead of being stored all at once. Each net is still evaluated from scratch, and the generating matrices of the nets
+ * must have at most GrayCodeMatrixEnumerator::maxNumElements elements in total.
  */ 
 template < NetConstruction NC, EmbeddingType ET, template <NetConstruction> class OBSERVER = MinimumObserver>
 class ExhaustiveSearch : public Search<NC, ET, OBSERVER>
@@ -35,15 +41,21 @@ class ExhaustiveSearch : public Search<NC, ET, OBSERVER>
          * @param figure Figure of merit used to compare nets.
          * @param verbose Verbosity level.
          * @param earlyAbortion Early-abortion switch. If true, the computations will be stopped if the net is worse than the best one so far.
+         * @param fullRankOnly Only for explicit nets. If true, the nets with a generating matrix which is not of full rank are skipped.
+         * Throws a std::logic_error for explicit nets whose generating matrices have too many elements to be enumerated.
          */
         ExhaustiveSearch(   Dimension dimension, 
                             typename NetConstructionTraits<NC>::SizeParameter sizeParameter,
                             std::unique_ptr<FigureOfMerit::FigureOfMerit> figure,
                             int verbose = 0,
-                            bool earlyAbortion = false):
+                            bool earlyAbortion = false,
+                            bool fullRankOnly = false):
             Search<NC, ET, OBSERVER>(dimension, sizeParameter, verbose, earlyAbortion),
-            m_figure(std::move(figure))
-        {};
+            m_figure(std::move(figure)),
+            m_fullRankOnly(fullRankOnly)
+        {
+            checkSearchSpace(std::integral_constant<bool, NC == NetConstruction::EXPLICIT>());
+        };
 
         /** 
          * Default move constructor. 
@@ -60,7 +72,7 @@ class ExhaustiveSearch : public Search<NC, ET, OBSERVER>
             std::string res;
             std::ostringstream stream;
             stream << Search<NC, ET, OBSERVER>::format();
-            stream << "Exploration method: exhaustive" << std::endl;
+            stream << "Exploration method: exhaustive" << (m_fullRankOnly ? " (full-rank matrices only)" : "") << std::endl;
             stream << "Figure of merit: " << m_figure->format() << std::endl;
             res += stream.str();
             stream.str(std::string());
@@ -83,20 +95,19 @@ class ExhaustiveSearch : public Search<NC, ET, OBSERVER>
                 evaluator->onAbort().connect(boost::bind(&Search<NC, ET, OBSERVER>::Observer::onAbort, &this->observer(), boost::placeholders::_1));
             }
             
-            auto searchSpace = DigitalNet<NC>::ConstructionMethod::genValueSpace(this->dimension(), this->m_sizeParameter);
-            
             uInteger nbNets = 1;
-            for(const auto& genVal : searchSpace)
+            forEachGenValues([&](const std::vector<typename NetConstructionTraits<NC>::GenValue>& genVal, uInteger nbTotal)
             {
-                if(this->m_verbose>0 && ((searchSpace.size() > 100 && nbNets % 100 == 0) || (nbNets % 10 == 0)))
+                if(this->m_verbose>0 && ((nbTotal > 100 && nbNets % 100 == 0) || (nbNets % 10 == 0)))
                 {
-                    std::cout << "Net " << nbNets << "/" << searchSpace.size() << std::endl;
+                    std::cout << "Net " << nbNets << "/" << nbTotal << std::endl;
                 }
                 nbNets++;
                 auto net = std::make_unique<DigitalNet<NC>>(this->m_dimension, this->m_sizeParameter, genVal);
                 double merit = (*evaluator)(*net, this->m_verbose-3);
                 this->m_observer->observe(std::move(net),merit);
-            }
+            }, std::integral_constant<bool, NC == NetConstruction::EXPLICIT>());
+
             if (!this->m_observer->hasFoundNet())
             {
                 this->onFailedSearch()(*this);
@@ -115,6 +126,54 @@ class ExhaustiveSearch : public Search<NC, ET, OBSERVER>
 
     private:
         std::unique_ptr<FigureOfMerit::FigureOfMerit> m_figure;
+        bool m_fullRankOnly;
+
+        /**
+         * Checks that the generating matrices of the explicit nets of the search space can be enumerated.
+         */
+        void checkSearchSpace(std::true_type) const
+        {
+            typedef NetConstructionTraits<NC> ConstructionMethod;
+            GrayCodeMatrixEnumerator::checkNumElements(this->dimension(), ConstructionMethod::nRows(this->m_sizeParameter), ConstructionMethod::nCols(this->m_sizeParameter));
+        }
+
+        void checkSearchSpace(std::false_type) const {}
+
+        /**
+         * Calls \c func on the generating values of all the nets of the search space and on the number of nets.
+         */
+        template <typename FUNC>
+        void forEachGenValues(FUNC&& func, std::false_type)
+        {
+            auto searchSpace = DigitalNet<NC>::ConstructionMethod::genValueSpace(this->dimension(), this->m_sizeParameter);
+            for(const auto& genVal : searchSpace)
+            {
+                func(genVal, searchSpace.size());
+            }
+        }
+
+        /**
+         * Calls \c func on the generating matrices of all the explicit nets of the search space and on the number of nets.
+         * The matrices are enumerated in a Gray-code order, so that only one matrix changes from one net to the next.
+         */
+        template <typename FUNC>
+        void forEachGenValues(FUNC&& func, std::true_type)
+        {
+            typedef NetConstructionTraits<NC> ConstructionMethod;
+            GrayCodeMatrixEnumerator enumerator(this->dimension(), ConstructionMethod::nRows(this->m_sizeParameter), ConstructionMethod::nCols(this->m_sizeParameter), m_fullRankOnly);
+            std::vector<typename ConstructionMethod::GenValue> genVal(this->dimension());
+            while(enumerator.goToNextMatrices())
+            {
+                for(Dimension coord = 0; coord < this->dimension(); ++coord)
+                {
+                    if (enumerator.isModified(coord))
+                    {
+                        genVal[coord] = enumerator.matrix(coord);
+                    }
+                }
+                func(genVal, enumerator.size());
+            }
+        }
 };
 
 }}
@@ -21,6 +21,7 @@
 #include "netbuilder/NetConstructionTraits.h"
 
 #include <memory>
+#include <vector>
 
 namespace NetBuilder { namespace Task {
 
@@ -68,6 +69,24 @@ class FullCBCExplorer
             return val;
         }
 
+        /**
+         * Fills a block with the next generating values for the current coordinate.
+         * The values are assigned to the elements of the block, so that their memory is reused from one block to the next.
+         * @param genValues Block of generating values. At most <code>genValues.size()</code> values are written.
+         * @return The number of generating values written at the beginning of the block.
+         */ 
+        size_t nextGenValues(std::vector<typename ConstructionMethod::GenValue>& genValues)
+        {
+            size_t n = 0;
+            while (n < genValues.size() && !isOver())
+            {
+                genValues[n++] = *m_state;
+                m_state++;
+                m_count++;
+            }
+            return n;
+        }
+
         /**
          * Resets the explorer to the first coordinate.
          */ 
@@ -79,6 +79,23 @@ class MixedCBCExplorer
             } 
         }
 
+        /**
+         * Fills a block with the next generating values for the current coordinate.
+         * @param genValues Block of generating values. At most <code>genValues.size()</code> values are written.
+         * @return The number of generating values written at the beginning of the block.
+         */
+        size_t nextGenValues(std::vector<typename ConstructionMethod::GenValue>& genValues)
+        {
+            if (m_currentCoord < m_nbFullCoordinates)
+            {
+                return m_fullExplorer->nextGenValues(genValues);
+            }
+            else
+            {
+                return m_randExplorer->nextGenValues(genValues);
+            }
+        }
+
         /**
          * Resets the explorer to the first coordinate.
          */ 
@@ -67,6 +67,21 @@ class RandomCBCExplorer
             return m_randomGenValueGenerator(m_currentCoord);
         }
 
+        /**
+         * Fills a block with the next generating values for the current coordinate.
+         * @param genValues Block of generating values. At most <code>genValues.size()</code> values are written.
+         * @return The number of generating values written at the beginning of the block.
+         */
+        size_t nextGenValues(std::vector<typename ConstructionMethod::GenValue>& genValues)
+        {
+            size_t n = 0;
+            while (n < genValues.size() && !isOver())
+            {
+                genValues[n++] = nextGenValue();
+            }
+            return n;
+        }
+
         /**
          * Resets the explorer to the first coordinate.
          */ 
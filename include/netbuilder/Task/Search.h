@@ -179,6 +179,12 @@ public:
     virtual std::string outputNet(OutputStyle outputStyle, unsigned int interlacingFactor) const override
     { return bestNet().format(outputStyle, interlacingFactor); }
 
+    /**
+     *  Returns the best net found by the search task.
+     */
+    virtual const AbstractDigitalNet& outputNetObject() const override
+    { return bestNet(); }
+
     /**
      *  Returns information about the task
      */
@@ -43,6 +43,11 @@ public:
      */ 
     virtual std::string outputNet(OutputStyle outputStyle, unsigned int interlacingFactor) const = 0;
 
+    /**
+     * Returns the resulting net of the task.
+     */ 
+    virtual const AbstractDigitalNet& outputNetObject() const = 0;
+
     /**
      * Output information about the task.
      */ 
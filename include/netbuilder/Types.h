@@ -72,6 +72,9 @@ typedef NTL::ZZX IntPolynomial;
 /// Outputs Style for nets
 enum class OutputStyle {TERMINAL, SOBOL, SOBOLJK, LATTICE, NET, RANDOMIZED_NET};
 
+/// Randomizations of point sets: random shift modulo 1 for ordinary lattices, the other ones for digital nets in base 2
+enum class Randomization {NONE, RANDOM_SHIFT, DIGITAL_SHIFT, LMS, LMS_DIGITAL_SHIFT, NESTED_UNIFORM_SCRAMBLING};
+
 
 //@}
 }
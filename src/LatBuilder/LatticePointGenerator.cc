@@ -0,0 +1,333 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "latbuilder/LatticePointGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace LatBuilder
+{
+
+namespace {
+   /**
+    * Returns \f$a b \bmod n\f$ without overflow.
+    */
+   uInteger mulMod(uInteger a, uInteger b, uInteger n)
+   {
+#ifdef __SIZEOF_INT128__
+      return (uInteger) (((unsigned __int128) a * b) % n);
+#else
+      uInteger res = 0;
+      a %= n;
+      while (b) {
+         if (b & 1)
+            res = (res >= n - a) ? res - (n - a) : res + a;
+         a = (a >= n - a) ? a - (n - a) : a + a;
+         b >>= 1;
+      }
+      return res;
+#endif
+   }
+
+   /**
+    * Largest number of points for which the numerators are handled four at a time: the numerators are then exactly
+    * converted to double through their 52-bit mantissa.
+    */
+   constexpr uInteger maxVectorizedNumPoints = uInteger(1) << 52;
+
+   /**
+    * Number of points converted at once to single precision.
+    */
+   constexpr uInteger chunkSize = 1024;
+
+   /**
+    * Adds \c step to the numerators \c x modulo \c n.
+    */
+   inline void addSteps(uInteger* x, const uInteger* step, Dimension dim, uInteger n)
+   {
+      Dimension j = 0;
+#ifdef __AVX2__
+      if (n <= maxVectorizedNumPoints) {
+         const __m256i vn = _mm256_set1_epi64x((long long) n);
+         const __m256i vnMinus1 = _mm256_set1_epi64x((long long) (n - 1));
+         for (; j + 4 <= dim; j += 4) {
+            __m256i v = _mm256_add_epi64(_mm256_loadu_si256((const __m256i*) (x + j)), _mm256_loadu_si256((const __m256i*) (step + j)));
+            v = _mm256_sub_epi64(v, _mm256_and_si256(_mm256_cmpgt_epi64(v, vnMinus1), vn));
+            _mm256_storeu_si256((__m256i*) (x + j), v);
+         }
+      }
+#endif
+      for (; j < dim; j++)
+         x[j] = (x[j] >= n - step[j]) ? x[j] - (n - step[j]) : x[j] + step[j];
+   }
+
+   /**
+    * Writes the coordinates \f$\{x_j / n + \Delta_j\}\f$ of a point in \c u, followed by the baker's transformation if
+    * \c bakerTransform is \c true. The shift is ignored if \c shift is \c nullptr.
+    */
+   inline void toReals(Real* u, const uInteger* x, const Real* shift, bool bakerTransform, Dimension dim, uInteger n)
+   {
+      const Real rn = (Real) n;
+      Dimension j = 0;
+#ifdef __AVX2__
+      if (n <= maxVectorizedNumPoints) {
+         // x + 2^52 has the bits of x as mantissa
+         const __m256i magicBits = _mm256_set1_epi64x(0x4330000000000000LL);
+         const __m256d magic = _mm256_set1_pd(4503599627370496.0);
+         const __m256d vn = _mm256_set1_pd(rn);
+         const __m256d one = _mm256_set1_pd(1.0);
+         const __m256d two = _mm256_set1_pd(2.0);
+         const __m256d signMask = _mm256_set1_pd(-0.0);
+         for (; j + 4 <= dim; j += 4) {
+            const __m256i xi = _mm256_loadu_si256((const __m256i*) (x + j));
+            __m256d v = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(xi, magicBits)), magic);
+            v = _mm256_div_pd(v, vn);
+            if (shift) {
+               v = _mm256_add_pd(v, _mm256_loadu_pd(shift + j));
+               v = _mm256_sub_pd(v, _mm256_and_pd(_mm256_cmp_pd(v, one, _CMP_GE_OQ), one));
+            }
+            if (bakerTransform)
+               v = _mm256_sub_pd(one, _mm256_andnot_pd(signMask, _mm256_sub_pd(_mm256_mul_pd(two, v), one)));
+            _mm256_storeu_pd(u + j, v);
+         }
+      }
+#endif
+      for (; j < dim; j++) {
+         Real v = (Real) x[j] / rn;
+         if (shift) {
+            v += shift[j];
+            if (v >= 1.0)
+               v -= 1.0;
+         }
+         if (bakerTransform)
+            v = 1.0 - std::abs(2.0 * v - 1.0);
+         u[j] = v;
+      }
+   }
+
+   bool isIntegerFormat(NetBuilder::PointFormat format)
+   { return format == NetBuilder::PointFormat::UINT32 || format == NetBuilder::PointFormat::UINT64; }
+}
+
+LatticePointGenerator::LatticePointGenerator(uInteger numPoints, std::vector<uInteger> gen, NetBuilder::PointOrder order, uInteger base):
+   m_numPoints(numPoints),
+   m_gen(std::move(gen)),
+   m_order(order),
+   m_base(base),
+   m_numDigits(0)
+{
+   if (m_numPoints == 0)
+      throw std::runtime_error("Lattice point generator: the lattice must have at least one point.");
+   for (auto& a : m_gen)
+      a %= m_numPoints;
+
+   switch (m_order) {
+      case NetBuilder::PointOrder::NATURAL:
+         m_steps = m_gen;
+         break;
+      case NetBuilder::PointOrder::RADICAL_INVERSE: {
+         if (m_base < 2)
+            throw std::runtime_error("Lattice point generator: the base of the radical-inverse order must be at least 2.");
+         std::vector<uInteger> powers(1, 1); // powers of the base up to the number of points
+         while (powers.back() < m_numPoints) {
+            if (powers.back() > m_numPoints / m_base)
+               break;
+            powers.push_back(powers.back() * m_base);
+         }
+         if (powers.back() != m_numPoints)
+            throw std::runtime_error("Lattice point generator: the number of points must be a power of the base of the radical-inverse order.");
+         m_numDigits = powers.size() - 1;
+         // With c carries, the digits 0 to c-1 of the position go from b-1 to 0 and digit c is incremented, so that the
+         // index changes by b^(m-1-c) - (b^m - b^(m-c)), which is b^(m-1-c) + b^(m-c) modulo n.
+         m_steps.resize(m_numDigits * dimension());
+         for (unsigned int c = 0; c < m_numDigits; c++) {
+            const uInteger delta = (powers[m_numDigits - 1 - c] + powers[m_numDigits - c]) % m_numPoints;
+            for (Dimension j = 0; j < dimension(); j++)
+               m_steps[c * dimension() + j] = mulMod(delta, m_gen[j], m_numPoints);
+         }
+         break;
+      }
+      default:
+         throw std::runtime_error("Lattice point generator: the points of lattices are enumerated in the natural or radical-inverse order.");
+   }
+}
+
+uInteger LatticePointGenerator::index(uInteger position) const
+{
+   if (m_order == NetBuilder::PointOrder::NATURAL)
+      return position;
+   uInteger res = 0;
+   for (unsigned int t = 0; t < m_numDigits; t++) {
+      res = res * m_base + position % m_base;
+      position /= m_base;
+   }
+   return res;
+}
+
+template <typename VISIT>
+void LatticePointGenerator::enumerate(uInteger first, uInteger count, VISIT visit) const
+{
+   if (first > m_numPoints || count > m_numPoints - first)
+      throw std::runtime_error("Lattice point generator: the indices of the points are out of range.");
+   if (count == 0)
+      return;
+
+   const Dimension dim = dimension();
+   std::vector<uInteger> point(dim);
+   const uInteger start = index(first);
+   for (Dimension j = 0; j < dim; j++)
+      point[j] = mulMod(start, m_gen[j], m_numPoints);
+
+   // digits of the position in base m_base, for the radical-inverse order
+   std::vector<uInteger> digits(m_numDigits);
+   uInteger position = first;
+   for (auto& d : digits) {
+      d = position % m_base;
+      position /= m_base;
+   }
+
+   for (uInteger i = 0; ; i++) {
+      visit(point.data());
+      if (i + 1 == count)
+         break;
+      unsigned int carries = 0;
+      if (m_order == NetBuilder::PointOrder::RADICAL_INVERSE) {
+         while (digits[carries] == m_base - 1)
+            digits[carries++] = 0;
+         digits[carries]++;
+      }
+      addSteps(point.data(), &m_steps[carries * dim], dim, m_numPoints);
+   }
+}
+
+void LatticePointGenerator::generateNumerators(uint64_t* numerators, uInteger first, uInteger count) const
+{
+   const Dimension dim = dimension();
+   enumerate(first, count, [&](const uInteger* x) {
+         numerators = std::copy(x, x + dim, numerators);
+         });
+}
+
+void LatticePointGenerator::generate(Real* points, uInteger first, uInteger count) const
+{
+   generate(points, first, count, std::vector<Real>(), false);
+}
+
+void LatticePointGenerator::generate(Real* points, uInteger first, uInteger count, const std::vector<Real>& shift, bool bakerTransform) const
+{
+   const Dimension dim = dimension();
+   if (!shift.empty() && shift.size() != dim)
+      throw std::runtime_error("Lattice point generator: the shift must have the dimension of the lattice.");
+   const Real* s = shift.empty() ? nullptr : shift.data();
+   enumerate(first, count, [&](const uInteger* x) {
+         toReals(points, x, s, bakerTransform, dim, m_numPoints);
+         points += dim;
+         });
+}
+
+void LatticePointGenerator::generate(NetBuilder::PointFormat format, void* points, uInteger first, uInteger count) const
+{
+   generate(format, points, first, count, std::vector<Real>(), false);
+}
+
+void LatticePointGenerator::generate(NetBuilder::PointFormat format, void* points, uInteger first, uInteger count, const std::vector<Real>& shift, bool bakerTransform) const
+{
+   using NetBuilder::PointFormat;
+   if (isIntegerFormat(format) && (!shift.empty() || bakerTransform))
+      throw std::runtime_error("Lattice point generator: shifted or transformed points cannot be written as numerators.");
+   const Dimension dim = dimension();
+   switch (format) {
+      case PointFormat::FLOAT64:
+         generate(static_cast<Real*>(points), first, count, shift, bakerTransform);
+         return;
+      case PointFormat::FLOAT32: {
+         // largest single precision number smaller than one
+         const float belowOne = 1.0f - std::numeric_limits<float>::epsilon() / 2;
+         std::vector<Real> buffer(std::min(chunkSize, count) * dim);
+         float* out = static_cast<float*>(points);
+         for (uInteger i = 0; i < count; i += chunkSize) {
+            const uInteger chunk = std::min(chunkSize, count - i);
+            generate(buffer.data(), first + i, chunk, shift, bakerTransform);
+            out = std::transform(buffer.begin(), buffer.begin() + chunk * dim, out, [belowOne](Real x) { return std::min((float) x, belowOne); });
+         }
+         return;
+      }
+      case PointFormat::UINT32: {
+         if (m_numPoints - 1 > (uInteger) UINT32_MAX)
+            throw std::runtime_error("Lattice point generator: too many points for 32-bit numerators.");
+         uint32_t* out = static_cast<uint32_t*>(points);
+         enumerate(first, count, [&](const uInteger* x) {
+               for (Dimension j = 0; j < dim; j++)
+                  *out++ = (uint32_t) x[j];
+               });
+         return;
+      }
+      case PointFormat::UINT64:
+         generateNumerators(static_cast<uint64_t*>(points), first, count);
+         return;
+   }
+}
+
+void LatticePointGenerator::generateReplicates(Real* points, const std::vector<std::vector<Real>>& shifts, bool bakerTransform) const
+{
+   for (const auto& shift : shifts) {
+      generate(points, 0, m_numPoints, shift, bakerTransform);
+      points += m_numPoints * dimension();
+   }
+}
+
+std::vector<std::vector<Real>> LatticePointGenerator::randomShifts(unsigned int numReplicates, LFSR258::seed_type seed) const
+{
+   LFSR258 randomGen(std::move(seed));
+   std::vector<std::vector<Real>> res(numReplicates, std::vector<Real>(dimension()));
+   for (auto& shift : res) {
+      // uniform in [0,1) with 53 random bits
+      for (auto& x : shift)
+         x = std::ldexp((Real) (randomGen() >> 11), -53);
+      randomGen.jump();
+   }
+   return res;
+}
+
+void LatticePointGenerator::generateToFile(const std::string& filename, NetBuilder::PointFormat format, bool useMemoryMap,
+      const std::vector<std::vector<Real>>& shifts, bool bakerTransform) const
+{
+   if (isIntegerFormat(format) && (!shifts.empty() || bakerTransform))
+      throw std::runtime_error("Lattice point generator: shifted or transformed points cannot be written as numerators.");
+   const uInteger numReplicates = std::max<uInteger>(1, shifts.size());
+   const size_t pointBytes = NetBuilder::PointFileWriter::valueSize(format) * dimension();
+   const std::vector<Real> noShift;
+   NetBuilder::PointFileWriter writer(filename, format, m_order, m_numPoints, dimension(), m_numPoints, useMemoryMap, numReplicates);
+   writer.write([&](void* points, uInteger first, uInteger count) {
+         // the block may span several replicates
+         for (uInteger i = 0; i < count; ) {
+            const uInteger r = (first + i) / m_numPoints;
+            const uInteger position = (first + i) % m_numPoints;
+            const uInteger size = std::min(count - i, m_numPoints - position);
+            generate(format, static_cast<char*>(points) + i * pointBytes, position, size, shifts.empty() ? noShift : shifts[r], bakerTransform);
+            i += size;
+         }
+         });
+}
+
+}
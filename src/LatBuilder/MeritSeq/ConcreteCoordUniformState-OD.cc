@@ -47,12 +47,16 @@ update(const RealVector& kernelValues, typename LatticeTraits<LR>::GenValue gen)
    // add new order
    m_state.push_back(RealVector(this->storage().size(), 0.0));
 
-   // recursive update by decreasing order to avoid unwanted overwriting
-   for (size_t order = m_state.size() - 1; order > 0; order--)
-      m_state[order] += boost::numeric::ublas::element_prod(
-            stridedKernelValues,
-            m_state[order - 1]
-            );
+   // recursive update by decreasing order to avoid unwanted overwriting,
+   // block by block
+   this->forEachBlock([&](size_t begin, size_t end) {
+         for (size_t order = m_state.size() - 1; order > 0; order--) {
+            RealVector& state = m_state[order];
+            const RealVector& prevState = m_state[order - 1];
+            for (size_t i = begin; i < end; i++)
+               state[i] += stridedKernelValues[i] * prevState[i];
+         }
+         });
 }
 
 //===========================================================================
@@ -47,12 +47,12 @@ update(const RealVector& kernelValues, typename LatticeTraits<LR>::GenValue gen)
 
    const Real weight = m_weights.getWeightForCoordinate(newCoordinate);
 
-   const auto ones = boost::numeric::ublas::scalar_vector<Real>(this->storage().size(), 1.0);
-
-   m_state = boost::numeric::ublas::element_prod(
-         ones + weight * stridedKernelValues,
-         m_state
-         );
+   // each element of the state only depends on the same element of the
+   // strided kernel values: update in place, block by block
+   this->forEachBlock([&](size_t begin, size_t end) {
+         for (size_t i = begin; i < end; i++)
+            m_state[i] *= 1.0 + weight * stridedKernelValues[i];
+         });
 }
 
 //===========================================================================
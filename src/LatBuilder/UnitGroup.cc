@@ -0,0 +1,203 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "latbuilder/UnitGroup.h"
+#include "latbuilder/GenSeq/CyclicGroup.h"
+#include "latbuilder/Util.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace LatBuilder {
+
+namespace {
+   // exponent of the prime p in m
+   uInteger valuation(uInteger m, uInteger p)
+   {
+      uInteger e = 0;
+      while (m % p == 0) {
+         m /= p;
+         e++;
+      }
+      return e;
+   }
+
+   uInteger intPow(uInteger base, uInteger exponent)
+   {
+      uInteger result = 1;
+      while (exponent--)
+         result *= base;
+      return result;
+   }
+}
+
+//================================================================================
+
+UnitGroup::UnitGroup(Modulus modulus, bool symmetric):
+   m_modulus(modulus),
+   m_symmetric(false)
+{
+   if (modulus < 1)
+      throw std::invalid_argument("UnitGroup(): modulus must be >= 1");
+
+   const auto factors = primeFactorsMap(modulus);
+
+   m_divisors.push_back(1);
+   for (const auto& factor : factors) {
+      m_primes.push_back(factor.first);
+      const size_t numDivisors = m_divisors.size();
+      Modulus power = 1;
+      for (uInteger e = 1; e <= factor.second; e++) {
+         power *= factor.first;
+         for (size_t i = 0; i < numDivisors; i++)
+            m_divisors.push_back(m_divisors[i] * power);
+      }
+   }
+   std::sort(m_divisors.begin(), m_divisors.end());
+
+   for (const auto& factor : factors) {
+      const Modulus p = factor.first;
+      const uInteger e = factor.second;
+      const Modulus power = intPow(p, e);
+      const Modulus cofactor = modulus / power;
+
+      // lifts g modulo p^e to the unit congruent to g modulo p^e and to 1
+      // modulo the other prime powers
+      long long inv = egcd(cofactor % power, power).first % (long long) power;
+      if (inv < 0)
+         inv += power;
+      auto lift = [&](Modulus g) {
+         return (1 + cofactor * ((g + power - 1) % power * (Modulus) inv % power)) % modulus;
+      };
+
+      if (p == 2) {
+         if (e >= 2)
+            m_components.push_back(Component{p, true, lift(power - 1), true});
+         if (e >= 3)
+            m_components.push_back(Component{p, false, lift(5), false});
+      }
+      else {
+         const Modulus g = GenSeq::CyclicGroup<LatticeType::ORDINARY>::smallestGenerator(p, e, false);
+         m_components.push_back(Component{p, false, lift(g % power), true});
+      }
+   }
+
+   // -1 has a nonzero exponent in each component marked as opposite
+   if (symmetric)
+      m_symmetric = std::count_if(m_components.begin(), m_components.end(),
+            [] (const Component& c) { return c.opposite; }) == 1;
+
+   std::stable_sort(m_components.begin(), m_components.end(),
+         [this] (const Component& a, const Component& b)
+         { return order(a, m_modulus) < order(b, m_modulus); });
+}
+
+//================================================================================
+
+size_t UnitGroup::order(const Component& component, Modulus m) const
+{
+   const uInteger f = valuation(m, component.prime);
+   size_t r;
+   if (component.sign)
+      r = f >= 2 ? 2 : 1;
+   else if (component.prime == 2)
+      r = f >= 3 ? intPow(2, f - 2) : 1;
+   else
+      r = f >= 1 ? intPow(component.prime, f - 1) * (component.prime - 1) : 1;
+   // -1 is the generator raised to half its order
+   if (m_symmetric and component.opposite)
+      r = std::max<size_t>(1, r / 2);
+   return r;
+}
+
+//================================================================================
+
+std::vector<UnitGroup::Modulus> UnitGroup::generators() const
+{
+   std::vector<Modulus> out;
+   for (const auto& component : m_components)
+      out.push_back(component.generator);
+   return out;
+}
+
+//================================================================================
+
+std::vector<size_t> UnitGroup::orders(Modulus m) const
+{
+   if (m == 0 or m_modulus % m != 0)
+      throw std::invalid_argument("UnitGroup::orders(): not a divisor of the modulus");
+   std::vector<size_t> out;
+   for (const auto& component : m_components)
+      out.push_back(order(component, m));
+   return out;
+}
+
+//================================================================================
+
+size_t UnitGroup::size(Modulus m) const
+{
+   size_t n = 1;
+   for (const auto r : orders(m))
+      n *= r;
+   return n;
+}
+
+//================================================================================
+
+UnitGroup::Modulus UnitGroup::element(Modulus m, size_t index) const
+{ return Cursor(*this, m, index).value(); }
+
+//================================================================================
+
+UnitGroup::Cursor::Cursor(const UnitGroup& group, Modulus m, size_t index):
+   m_modulus(m),
+   m_orders(group.orders(m)),
+   m_exponents(m_orders.size()),
+   m_partial(m_orders.size())
+{
+   for (const auto& component : group.m_components)
+      m_generators.push_back(component.generator % m);
+
+   for (size_t k = m_orders.size(); k-- > 0; ) {
+      m_exponents[k] = index % m_orders[k];
+      index /= m_orders[k];
+   }
+
+   Modulus value = 1 % m;
+   for (size_t k = 0; k < m_orders.size(); k++) {
+      value = value * modularPow(m_generators[k], m_exponents[k], m) % m;
+      m_partial[k] = value;
+   }
+}
+
+//================================================================================
+
+void UnitGroup::Cursor::next()
+{
+   size_t k = m_orders.size();
+   while (k-- > 0) {
+      if (++m_exponents[k] < m_orders[k]) {
+         m_partial[k] = m_partial[k] * m_generators[k] % m_modulus;
+         break;
+      }
+      m_exponents[k] = 0;
+   }
+   // the exponents of the following components are back to 0
+   for (size_t j = k + 1; j < m_orders.size(); j++)
+      m_partial[j] = j > 0 ? m_partial[j - 1] : 1 % m_modulus;
+}
+
+}
@@ -24,9 +24,17 @@
 #include "netbuilder/Types.h"
 
 #include "netbuilder/Parser/OutputStyleParser.h"
+#include "netbuilder/Parser/PointFormatParser.h"
+#include "netbuilder/Parser/RandomizationParser.h"
+#include "netbuilder/PointGenerator.h"
+#include "netbuilder/RandomizedPointGenerator.h"
+#include "latbuilder/LatticePointGenerator.h"
+#include "latbuilder/fftw++.h"
+#include "latbuilder/Parallel.h"
 
 #include <fstream>
 #include <chrono>
+#include <limits>
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string/join.hpp>
 
@@ -168,7 +176,49 @@ makeOptionsDescription()
     ("output-style,O", po::value<std::string>()->default_value(""),
     "(optional) TBD")
    ("merit-digits-displayed", po::value<unsigned int>()->default_value(0),
-    "(optional) number of significant figures to use when displaying merit values\n");
+    "(optional) number of significant figures to use when displaying merit values\n")
+   ("fft-planner", po::value<std::string>()->default_value("estimate"),
+    "(optional) FFTW planner used by the fast CBC exploration; the plans are created once for each number of points and then reused; possible values:\n"
+    "  estimate (default)\n"
+    "  measure\n"
+    "  patient\n")
+   ("fft-wisdom", po::value<std::string>(),
+    "(optional) path to a FFTW wisdom file, read before the exploration if it exists and written after it, "
+    "so that repeated runs with the same number of points skip the planning\n")
+   ("threads,T", po::value<unsigned int>()->default_value(1),
+    "(optional) number of threads used by the fast CBC exploration to convolve the levels of embedded lattices concurrently, "
+    "to update the state vectors and, if FFTW was built with threads, to compute the largest transforms; "
+    "if 0, the number of hardware threads is used (default: 1)\n")
+   ("output-points", po::value<std::string>(),
+    "(optional) path to a binary file where the points of the resulting lattice are written, after a 64-byte header "
+    "giving the format, the ordering, the number of points and the dimension (see netbuilder/PointFile.h). The points of "
+    "ordinary lattice rules are written in their natural order, or in radical-inverse order for embedded lattices, so that "
+    "the first b^k points form the lattice of level k; those of polynomial lattice rules are written in Gray-code order. "
+    "The file is overwritten.\n")
+   ("output-points-format", po::value<std::string>()->default_value("float64"),
+    "(optional) format of the values written with --output-points; possible values:\n"
+    "  float64 (default)\n"
+    "  float32\n"
+    "  uint32 (numerators i*a_j mod n for ordinary lattice rules, first 32 binary digits for polynomial lattice rules)\n"
+    "  uint64 (numerators i*a_j mod n for ordinary lattice rules, first 64 binary digits for polynomial lattice rules)\n")
+   ("output-points-mmap", po::value<std::string>()->default_value("false"),
+    "(optional) write the points through a memory mapping of the file instead of a stream; possible values:\n"
+    "  false (default)\n"
+    "  true\n")
+   ("output-points-randomization", po::value<std::string>()->default_value("none"),
+    "(optional) randomization of the points written with --output-points; possible values:\n"
+    "  none (default)\n"
+    "  random-shift (random shift modulo 1, for ordinary lattice rules)\n"
+    "  digital-shift, lms, lms-digital-shift, nested-uniform (for polynomial lattice rules, see netbuilder --help)\n")
+   ("output-points-replicates", po::value<unsigned int>()->default_value(1),
+    "(optional) number of independent randomizations of the lattice written one after the other with --output-points (default: 1)\n")
+   ("output-points-seed", po::value<uint64_t>()->default_value(0),
+    "(optional) seed of the randomizations of the points written with --output-points; replicate r only depends on the seed and on r "
+    "(default: 0, the default seed of the LFSR258 generator)\n")
+   ("output-points-baker", po::value<std::string>()->default_value("false"),
+    "(optional) apply the baker's transformation to the points of ordinary lattice rules written with --output-points; possible values:\n"
+    "  false (default)\n"
+    "  true\n");
 
    return desc;
 }
@@ -238,8 +288,32 @@ std::string helper2(const SizeParam<LatticeType::ORDINARY, EmbeddingType::UNILEV
 
 
 
+/**
+ * Returns the seed of the randomizations given by \c options.
+ */
+LFSR258::seed_type pointsSeed(const NetBuilder::PointFileOptions& options)
+{
+   return (options.seed == 0) ? LFSR258::default_seed : NetBuilder::RandomizedPointGenerator::seedFromInteger(options.seed);
+}
+
+/**
+ * Writes the points of the point set generated by \c generator in the file given by \c options, with \c write.
+ */
+template <typename GENERATOR, typename WRITE>
+void pointsOutput(const GENERATOR& generator, const NetBuilder::PointFileOptions& options, WRITE write)
+{
+   using namespace std::chrono;
+   auto t0 = high_resolution_clock::now();
+   write();
+   auto dt = duration_cast<duration<double>>(high_resolution_clock::now() - t0);
+   std::cout << "Points written in " << options.filename << " (" << generator.numPoints() << " points in dimension " << generator.dimension();
+   if (options.randomization != NetBuilder::Randomization::NONE)
+      std::cout << ", " << options.numReplicates << " replicates";
+   std::cout << ") in " << dt.count() << " seconds" << std::endl << std::endl;
+}
+
 template <EmbeddingType ET>
-void executeOrdinary(const Parser::CommandLine<LatticeType::ORDINARY, ET>& cmd, int verbose, unsigned int repeat, std::string outputFolder)
+void executeOrdinary(const Parser::CommandLine<LatticeType::ORDINARY, ET>& cmd, int verbose, unsigned int repeat, std::string outputFolder, const NetBuilder::PointFileOptions& pointsFile)
 {
    const LatticeType LR = LatticeType::ORDINARY ;
    using namespace std::chrono;
@@ -311,6 +385,16 @@ void executeOrdinary(const Parser::CommandLine<LatticeType::ORDINARY, ET>& cmd,
         }
         outFile.close();
       }
+
+      if (pointsFile.filename != ""){
+         const LatticePointGenerator generator(lat);
+         std::vector<std::vector<Real>> shifts;
+         if (pointsFile.randomization == NetBuilder::Randomization::RANDOM_SHIFT)
+            shifts = generator.randomShifts(pointsFile.numReplicates, pointsSeed(pointsFile));
+         pointsOutput(generator, pointsFile, [&]() {
+               generator.generateToFile(pointsFile.filename, pointsFile.format, pointsFile.useMemoryMap, shifts, pointsFile.bakerTransform);
+               });
+      }
       
       if (merit_digits_displayed)
    std::cout.precision(old_precision);
@@ -321,7 +405,7 @@ void executeOrdinary(const Parser::CommandLine<LatticeType::ORDINARY, ET>& cmd,
 
 
 template <EmbeddingType ET>
-void executePolynomial(const Parser::CommandLine<LatticeType::POLYNOMIAL, ET>& cmd, int verbose, unsigned int repeat, std::string outputFolder, NetBuilder::OutputStyle outputStyle)
+void executePolynomial(const Parser::CommandLine<LatticeType::POLYNOMIAL, ET>& cmd, int verbose, unsigned int repeat, std::string outputFolder, NetBuilder::OutputStyle outputStyle, const NetBuilder::PointFileOptions& pointsFile)
 {
    const LatticeType LR = LatticeType::POLYNOMIAL ;
    using namespace std::chrono;
@@ -392,6 +476,20 @@ void executePolynomial(const Parser::CommandLine<LatticeType::POLYNOMIAL, ET>& c
           }
       }
 
+      if (pointsFile.filename != ""){
+          NetBuilder::DigitalNet<NetBuilder::NetConstruction::POLYNOMIAL> net((unsigned int) lat.gen().size(), lat.sizeParam().modulus(),lat.gen());
+          if (pointsFile.randomization == NetBuilder::Randomization::NONE){
+            const NetBuilder::PointGenerator generator(net, interlacingFactor, std::numeric_limits<unsigned long>::digits);
+            pointsOutput(generator, pointsFile, [&]() { generator.generateToFile(pointsFile.filename, pointsFile.format, pointsFile.useMemoryMap); });
+          }
+          else{
+            const NetBuilder::RandomizedPointGenerator generator(net, pointsFile.randomization, interlacingFactor, pointsSeed(pointsFile));
+            pointsOutput(generator, pointsFile, [&]() {
+                generator.generateToFile(pointsFile.filename, pointsFile.numReplicates, pointsFile.format, pointsFile.useMemoryMap);
+                });
+          }
+      }
+
         
         if (merit_digits_displayed){
           std::cout.precision(old_precision);
@@ -430,8 +528,65 @@ int main(int argc, const char *argv[])
 
         std::string outputstyle = opt["output-style"].as<std::string>();
 
+        const std::string fftPlanner = opt["fft-planner"].as<std::string>();
+        if (fftPlanner == "estimate")
+          fftw<Real>::set_planner_flags(FFTW_ESTIMATE);
+        else if (fftPlanner == "measure")
+          fftw<Real>::set_planner_flags(FFTW_MEASURE);
+        else if (fftPlanner == "patient")
+          fftw<Real>::set_planner_flags(FFTW_PATIENT);
+        else
+          throw std::runtime_error("--fft-planner must be estimate, measure or patient (try --help)");
+
+        std::string fftWisdom = "";
+        if (opt.count("fft-wisdom") >= 1){
+          fftWisdom = opt["fft-wisdom"].as<std::string>();
+          fftw<Real>::import_wisdom(fftWisdom); // the file does not exist before the first run
+        }
+
+        LatBuilder::Parallel::setNumThreads(opt["threads"].as<unsigned int>());
+        if (!fftw<Real>::set_planner_threads(LatBuilder::Parallel::numThreads()) && verbose > 0){
+          std::cout << "FFTW was built without threads: the transforms are computed on a single thread" << std::endl;
+        }
+
+        NetBuilder::PointFileOptions pointsFile;
+        if (opt.count("output-points") >= 1){
+          pointsFile.filename = opt["output-points"].as<std::string>();
+          pointsFile.format = NetBuilder::Parser::PointFormatParser::parse(opt["output-points-format"].as<std::string>());
+          std::string s_mmap = opt["output-points-mmap"].as<std::string>();
+          if (s_mmap != "true" && s_mmap != "false"){
+            throw std::runtime_error("--output-points-mmap must be true or false (try --help)");
+          }
+          pointsFile.useMemoryMap = (s_mmap == "true");
+          pointsFile.randomization = NetBuilder::Parser::RandomizationParser::parse(opt["output-points-randomization"].as<std::string>());
+          pointsFile.numReplicates = opt["output-points-replicates"].as<unsigned int>();
+          pointsFile.seed = opt["output-points-seed"].as<uint64_t>();
+          std::string s_baker = opt["output-points-baker"].as<std::string>();
+          if (s_baker != "true" && s_baker != "false"){
+            throw std::runtime_error("--output-points-baker must be true or false (try --help)");
+          }
+          pointsFile.bakerTransform = (s_baker == "true");
+          if (pointsFile.randomization == NetBuilder::Randomization::NONE && pointsFile.numReplicates != 1){
+            throw std::runtime_error("--output-points-replicates requires --output-points-randomization (try --help)");
+          }
+        }
+
        LatBuilder::LatticeType lattice = Parser::LatticeParser::parse(opt["construction"].as<std::string>());
 
+       if (lattice == LatticeType::ORDINARY){
+         if (pointsFile.randomization != NetBuilder::Randomization::NONE && pointsFile.randomization != NetBuilder::Randomization::RANDOM_SHIFT){
+           throw std::runtime_error("--output-points-randomization must be none or random-shift for ordinary lattice rules (try --help)");
+         }
+       }
+       else{
+         if (pointsFile.randomization == NetBuilder::Randomization::RANDOM_SHIFT){
+           throw std::runtime_error("--output-points-randomization random-shift only applies to ordinary lattice rules (try --help)");
+         }
+         if (pointsFile.bakerTransform){
+           throw std::runtime_error("--output-points-baker only applies to ordinary lattice rules (try --help)");
+         }
+       }
+
        std::vector<std::string> all_args;
        if (argc > 1) {
           all_args.assign(argv + 1, argv + argc);
@@ -486,11 +641,11 @@ int main(int argc, const char *argv[])
             EmbeddingType latType = Parser::EmbeddingType::parse(opt["multilevel"].as<std::string>());
 
             if (latType == EmbeddingType::UNILEVEL){
-               executeOrdinary<EmbeddingType::UNILEVEL> (cmd, verbose, repeat, outputFolder);
+               executeOrdinary<EmbeddingType::UNILEVEL> (cmd, verbose, repeat, outputFolder, pointsFile);
                
              }
             else{
-               executeOrdinary<EmbeddingType::MULTILEVEL> (cmd, verbose, repeat, outputFolder);
+               executeOrdinary<EmbeddingType::MULTILEVEL> (cmd, verbose, repeat, outputFolder, pointsFile);
                
              }
       }
@@ -542,14 +697,18 @@ int main(int argc, const char *argv[])
 
 
             if (latType == EmbeddingType::UNILEVEL){
-              executePolynomial< EmbeddingType::UNILEVEL> (cmd, verbose, repeat, outputFolder, outputStyle);
+              executePolynomial< EmbeddingType::UNILEVEL> (cmd, verbose, repeat, outputFolder, outputStyle, pointsFile);
                
              }
             else{
-              executePolynomial<EmbeddingType::MULTILEVEL> (cmd, verbose, repeat, outputFolder, outputStyle);
+              executePolynomial<EmbeddingType::MULTILEVEL> (cmd, verbose, repeat, outputFolder, outputStyle, pointsFile);
                
              }
       }
+
+      if (!fftWisdom.empty() && !fftw<Real>::export_wisdom(fftWisdom)){
+        std::cerr << "WARNING: cannot write FFTW wisdom to " << fftWisdom << std::endl;
+      }
    }
    catch (Parser::ParserError& e) {
       std::cerr << "COMMAND LINE ERROR: " << e.what() << std::endl;
@@ -17,74 +17,208 @@
 #include <map>
 #include <fstream>
 #include <algorithm>
+#include <cassert>
+#include <cstdint>
 
 #include "netbuilder/FigureOfMerit/TValueComputation.h"
 #include "netbuilder/Helpers/RankComputer.h"
-#include "netbuilder/Helpers/CompositionMaker.h"
 
 
 
 namespace NetBuilder {
 
-unsigned int iteration_on_k(std::vector<GeneratingMatrix>& baseMatrices, unsigned int k, int verbose){
-    unsigned int nCols = baseMatrices[0].nCols();
-    unsigned int s = (unsigned int) baseMatrices.size();
-    
-    // Initialization of row map from original matrices to computation matrix
-    std::map<std::pair<int, int>, int> Origin_to_M;
+namespace {
 
-    RankComputer rankComputer(nCols);
+// index of the lowest non-zero bit of the row, or notFound if the row is zero
+inline unsigned int lowestBit(const GeneratingMatrix::Row& row, unsigned int notFound)
+{
+    auto j = row.find_first();
+    return (j == GeneratingMatrix::Row::npos) ? notFound : (unsigned int) j;
+}
+inline unsigned int lowestBit(PackedGeneratingMatrix::Row row, unsigned int notFound)
+{
+    return row ? PackedGeneratingMatrix::lowestBit(row) : notFound;
+}
 
-    for (unsigned int i=0; i<k-s+1; i++){
-        Origin_to_M[{1, i+1}] = i;
-        rankComputer.addRow(baseMatrices[s-1].subMatrix(i, 0, 1, nCols));
-    }
-    for (unsigned int i=1; i<s; i++){
-        Origin_to_M[{i+1, 1}] = k-s+i;
-        rankComputer.addRow(baseMatrices[s-1-i].subMatrix(0, 0, 1, nCols));
-    }
+/**
+ * Basis of the span of a system of rows in which each row has a distinct lowest non-zero column, its pivot.
+ * The set of pivots only depends on the span of the system. The rows restricted to their first \f$c\f$ columns 
+ * are linearly independent if and only if they are independent and all the pivots are smaller than \f$c\f$.
+ * Adding a row fills a single pivot slot, so that rows can be removed in the reverse order of their insertion at no cost.
+ * A vector is reduced modulo the span by eliminating the pivots in increasing order, since each row of the basis
+ * vanishes on the columns before its pivot.
+ * This is the row reduction shared by the depth-first walks of StrengthSearch and BitSlicedTValueBatch.
+ */
+template <typename MATRIX>
+class PivotBasis
+{
+    public:
+        typedef typename MATRIX::Row Row;
 
-    unsigned int smallestFullRankIndex = rankComputer.smallestFullRank() - 1;
+        PivotBasis(unsigned int nCols = 0)
+        {
+            reset(nCols);
+        }
 
-    if (smallestFullRankIndex == nCols){
-        return nCols;
-    }
+        /**
+         * Empties the basis and sets the number of columns to \c nCols. The storage is kept for the next systems.
+         */
+        void reset(unsigned int nCols)
+        {
+            m_nCols = nCols;
+            m_slots.resize(nCols);
+            m_filled.assign(nCols, false);
+            m_pivots.clear();
+            m_nColsForFullRank.clear();
+        }
 
-    CompositionMaker compositionMaker(k, s);
+        /**
+         * Adds a row to the system. Returns false and leaves the basis unchanged if the row is in the span of the system.
+         */
+        bool addRow(const Row& row)
+        {
+            m_row = row;
+            for (unsigned int col = lowestBit(m_row, m_nCols); col < m_nCols; col = lowestBit(m_row, m_nCols)){
+                if (!m_filled[col]){
+                    std::swap(m_slots[col], m_row);
+                    m_filled[col] = true;
+                    m_nColsForFullRank.push_back(std::max(nColsForFullRank(), col + 1));
+                    m_pivots.push_back(col);
+                    return true;
+                }
+                m_row ^= m_slots[col];
+            }
+            return false;
+        }
 
-    while (compositionMaker.goToNextComposition()) {
+        /**
+         * Removes the last row added to the system.
+         */
+        void removeLastRow()
+        {
+            m_filled[m_pivots.back()] = false;
+            m_pivots.pop_back();
+            m_nColsForFullRank.pop_back();
+        }
 
-        std::pair<std::pair<int, int>, std::pair<int, int>> rowChange = compositionMaker.changeFromPreviousComposition();
+        /**
+         * Returns the smallest number of columns for which the system is full rank.
+         */
+        unsigned int nColsForFullRank() const { return m_nColsForFullRank.empty() ? 0 : m_nColsForFullRank.back(); }
 
-        int ind_exchange = Origin_to_M[rowChange.first];
-        Origin_to_M[rowChange.second] = ind_exchange;
-        Origin_to_M.erase(rowChange.first);
-        
-        GeneratingMatrix newRow = baseMatrices[s-rowChange.second.first].subMatrix(rowChange.second.second-1, 0, 1, nCols);
+        /**
+         * Returns whether a row of the basis has the column \c col as pivot.
+         */
+        bool hasPivot(unsigned int col) const { return m_filled[col]; }
 
-        rankComputer.replaceRow(ind_exchange, std::move(newRow), verbose-1);
+        /**
+         * Returns the row of the basis whose pivot is the column \c col.
+         */
+        const Row& row(unsigned int col) const { return m_slots[col]; }
 
-        smallestFullRankIndex = rankComputer.smallestFullRank() - 1;
+    private:
+        unsigned int m_nCols; // number of columns
+        std::vector<Row> m_slots; // row whose pivot is the column, if any
+        std::vector<bool> m_filled; // whether a row of the basis has the column as pivot
+        std::vector<unsigned int> m_pivots; // pivots in the order of insertion of the rows
+        std::vector<unsigned int> m_nColsForFullRank; // number of columns required by the rows inserted so far
+        Row m_row; // row being reduced
+};
 
-        if (smallestFullRankIndex == nCols){
-            return smallestFullRankIndex;
+/**
+ * Computes the strength of a projection for each level by a depth-first walk over the numbers of rows \f$d_1, \dots, d_s \geq 1\f$ 
+ * taken in each generating matrix. The strength for \f$c\f$ columns is the largest \f$k\f$ such that all the systems made of the first
+ * \f$d_1, \dots, d_s\f$ rows with \f$d_1 + \dots + d_s = k\f$ are full rank on their first \f$c\f$ columns.
+ * The elimination of the rows of a prefix \f$d_1, \dots, d_j\f$ is shared by all the systems which extend it, whatever their size,
+ * and the walk only visits systems small enough to lower the current bound on the strength of at least one level.
+ * A search can be reused for several projections, so that its storage is allocated once.
+ */
+template <typename MATRIX>
+class StrengthSearch
+{
+    public:
+        /**
+         * Returns the strength of each level, capped by its initial bound.
+         * The result is valid until the next call.
+         * @param baseMatrices Generating matrices.
+         * @param nColsFirstLevel Number of columns of the first level. Each level has one more column than the previous one.
+         * @param maxSubProj Maximum of the t-values of the subprojections for each level.
+         * @param kMax Upper bound on the strength of all the levels.
+         */
+        const std::vector<unsigned int>& compute(const MatricesView<MATRIX>& baseMatrices, unsigned int nColsFirstLevel, const std::vector<unsigned int>& maxSubProj, unsigned int kMax)
+        {
+            m_baseMatrices = &baseMatrices;
+            m_nColsFirstLevel = nColsFirstLevel;
+            m_bounds.resize(maxSubProj.size());
+            for (unsigned int i = 0; i < m_bounds.size(); i++){
+                unsigned int nColsLevel = nColsFirstLevel + i;
+                m_bounds[i] = std::min(kMax, nColsLevel - std::min(maxSubProj[i], nColsLevel));
+            }
+            m_maxBound = *std::max_element(m_bounds.begin(), m_bounds.end());
+            m_basis.reset(baseMatrices[0].nCols());
+            explore(0, 0);
+            return m_bounds;
         }
-    }
-    return smallestFullRankIndex;
-}
 
-unsigned int GaussMethod::computeTValue(std::vector<GeneratingMatrix> baseMatrices, unsigned int maxSubProj, int verbose=0)
-{
-    unsigned int s = (unsigned int) baseMatrices.size();
-    if (s == 1)
-    {
-        return 0;
-    }
+    private:
+        const MatricesView<MATRIX>* m_baseMatrices; // generating matrices of the current projection
+        unsigned int m_nColsFirstLevel; // number of columns of the first level
+        std::vector<unsigned int> m_bounds; // current upper bound on the strength of each level
+        unsigned int m_maxBound; // maximum of the bounds
+        PivotBasis<MATRIX> m_basis; // basis of the current system
 
-    return GaussMethod::computeTValue(baseMatrices, baseMatrices[0].nCols()-1, {maxSubProj}, verbose)[0];
-}
+        /**
+         * Takes into account a system of \c nRows rows which is not full rank on the first levels.
+         * @param nLevels Number of levels, starting from the first one, on which the system is not full rank.
+         * @param nRows Number of rows of the system.
+         */
+        void fail(unsigned int nLevels, unsigned int nRows)
+        {
+            nLevels = std::min(nLevels, (unsigned int) m_bounds.size());
+            if (nLevels == 0){
+                return;
+            }
+            for (unsigned int i = 0; i < nLevels; ++i){
+                m_bounds[i] = std::min(m_bounds[i], nRows - 1);
+            }
+            m_maxBound = *std::max_element(m_bounds.begin(), m_bounds.end());
+        }
+
+        /**
+         * Enumerates the number of rows taken in the matrix \c coord and the following ones.
+         * @param coord Index of the matrix.
+         * @param nRowsSoFar Number of rows taken in the previous matrices.
+         */
+        void explore(unsigned int coord, unsigned int nRowsSoFar)
+        {
+            const MATRIX& mat = (*m_baseMatrices)[coord];
+            const unsigned int remainingCoords = (unsigned int) m_baseMatrices->size() - coord - 1;
+            unsigned int nAddedRows = 0;
+            for (unsigned int d = 1; d <= mat.nRows(); ++d){
+                // smallest system extending the current one: it fails on the levels with fewer columns than required by the current one
+                const unsigned int nRows = nRowsSoFar + d + remainingCoords;
+                if (nRows > m_maxBound){
+                    break;
+                }
+                if (!m_basis.addRow(mat[d-1])){
+                    fail((unsigned int) m_bounds.size(), nRows);
+                    break;
+                }
+                ++nAddedRows;
+                const unsigned int nColsRequired = m_basis.nColsForFullRank();
+                fail((nColsRequired > m_nColsFirstLevel) ? nColsRequired - m_nColsFirstLevel : 0, nRows);
+                if (remainingCoords > 0){
+                    explore(coord + 1, nRowsSoFar + d);
+                }
+            }
+            for (unsigned int i = 0; i < nAddedRows; ++i){
+                m_basis.removeLastRow();
+            }
+        }
+};
 
-std::vector<unsigned int> GaussMethod::computeTValue(std::vector<GeneratingMatrix> baseMatrices, unsigned int mMin, const std::vector<unsigned int>& maxSubProj, int verbose=0)
+template <typename MATRIX>
+std::vector<unsigned int> computeTValueImpl(const MatricesView<MATRIX>& baseMatrices, unsigned int mMin, const std::vector<unsigned int>& maxSubProj)
 {
     unsigned int nRows = baseMatrices[0].nRows();
     unsigned int nCols = baseMatrices[0].nCols();
@@ -93,10 +227,10 @@ std::vector<unsigned int> GaussMethod::computeTValue(std::vector<GeneratingMatri
     unsigned int nLevel = (unsigned int) maxSubProj.size();
     
     if (s == 1){
-        RankComputer rankComputer(nCols);
-        for (unsigned int r=0; r<nRows; r++){
-            rankComputer.addRow(baseMatrices[0].subMatrix(r, 0, 1, nCols));
-        }
+        // the pivots of the first nCols rows do not depend on the rows below
+        unsigned int nRowsToReduce = std::min(nRows, nCols);
+        BasicRankComputer<MATRIX> rankComputer(nCols);
+        rankComputer.addRows(baseMatrices[0].upperLeftSubMatrix(nRowsToReduce, nCols));
         std::map<unsigned int, unsigned int> pivotPos = rankComputer.getPivots();
         
         std::vector<unsigned int> countPivot(nCols);
@@ -115,41 +249,302 @@ std::vector<unsigned int> GaussMethod::computeTValue(std::vector<GeneratingMatri
         return res;
     }
 
-    std::vector<unsigned int> result = maxSubProj;
+    // systems with more rows than columns are never full rank: the strength is at most nCols
+    // and it is useless to look beyond the strength which gives the t-value of the subprojections
+    const unsigned int kMax = std::min(nRows - std::min(maxSubProj.back(), nRows), nCols);
+    const unsigned int nColsFirstLevel = nCols + 1 - nLevel;
+
+    static thread_local StrengthSearch<MATRIX> search;
+    const std::vector<unsigned int>& strengths = search.compute(baseMatrices, nColsFirstLevel, maxSubProj, kMax);
+
+    // the s first rows of each composition are always taken: the strength is at least s-1
+    std::vector<unsigned int> result(nLevel);
+    for (unsigned int i = 0; i < nLevel; i++){
+        unsigned int nColsLevel = nColsFirstLevel + i;
+        unsigned int strength = std::max(strengths[i], s - 1);
+        result[i] = std::max((nColsLevel > strength) ? nColsLevel - strength : 0, maxSubProj[i]);
+    }
+    return result;
+}
 
-    unsigned int diff = 0;
-    if (mMin < s-1){
-        diff = (s-1-mMin);
-        if (nLevel <= (s - 1 - mMin))
+// generating matrices with at most 64 columns are handled with the word-packed representation,
+// packed into buffers reused by the successive calls of the thread
+std::vector<unsigned int> computeTValueWithPacking(const MatricesView<GeneratingMatrix>& baseMatrices, unsigned int mMin, const std::vector<unsigned int>& maxSubProj)
+{
+    if (PackedGeneratingMatrix::fits(baseMatrices[0].nCols()))
+    {
+        static thread_local std::vector<PackedGeneratingMatrix> packedMatrices;
+        static thread_local std::vector<const PackedGeneratingMatrix*> pointers;
+        if (packedMatrices.size() < baseMatrices.size())
         {
-            return result;
+            packedMatrices.resize(baseMatrices.size());
         }
-        nLevel -= (s-1-mMin);
-        mMin = s-1;
-    }
-    for (unsigned int i = 0; i < nLevel; i++){
-        result[i+diff] = std::max(nCols-(nLevel-1-i)-s+1, maxSubProj[i+diff]);
+        pointers.clear();
+        for (size_t i = 0; i < baseMatrices.size(); ++i)
+        {
+            packedMatrices[i].assign(baseMatrices[i]);
+            pointers.push_back(&packedMatrices[i]);
+        }
+        return computeTValueImpl(MatricesView<PackedGeneratingMatrix>(pointers), mMin, maxSubProj);
     }
-    unsigned int previousIndSmallestInvertible = nLevel;
-    
+    return computeTValueImpl(baseMatrices, mMin, maxSubProj);
+}
+
+/**
+ * Bit-sliced computation of the t-values of a batch of projections which only differ by their last matrix.
+ *
+ * Let \f$F\f$ be the system made of the first \f$d_1, \dots, d_{s-1} \geq 1\f$ rows of the common matrices, with \f$K = d_1 + \dots + d_{s-1}\f$,
+ * and let \f$e(F)\f$ be the number of leading rows of the last matrix which are linearly independent modulo the span of \f$F\f$.
+ * Given the t-value of the subprojections, the strength \f$m - t\f$ of a projection is the minimum of the strength of its subprojections
+ * and of \f$K + e(F)\f$ over all such systems. The reduction of \f$F\f$ is shared by all the projections whereas
+ * \f$e(F)\f$ is computed for all the projections at once, using one bit per projection in each word.
+ * A batch can be reused for several groups of projections, so that its storage is allocated once.
+ */
+class BitSlicedTValueBatch
+{
+    public:
+        typedef uint64_t Lanes; // one bit per projection of the batch
+
+        /**
+         * Returns the t-value of each projection.
+         * @param commonMatrices Generating matrices shared by all the projections.
+         * @param lastMatrices Last generating matrix of each projection.
+         * @param maxSubProj Maximum of the t-values of the subprojections of each projection.
+         */
+        std::vector<unsigned int> compute(const MatricesView<PackedGeneratingMatrix>& commonMatrices, const MatricesView<PackedGeneratingMatrix>& lastMatrices, const std::vector<unsigned int>& maxSubProj)
+        {
+            m_commonMatrices = &commonMatrices;
+            m_nCols = lastMatrices[0].nCols();
+            m_nLanes = (unsigned int) lastMatrices.size();
+            m_slicedRows.resize(m_nCols * m_nCols);
+            m_reducedRows.resize(m_nCols * m_nCols);
+            m_pivots.resize(m_nCols * m_nCols);
+            m_bounds.resize(m_nLanes);
+            m_basis.reset(m_nCols);
 
-    for (unsigned int k=nRows-maxSubProj.back(); k >= s; k--){
-        unsigned int smallestFullRankIndex = iteration_on_k(baseMatrices, k, verbose-1);
-        if (smallestFullRankIndex == nCols){
-            continue;
+            uint64_t block[64];
+            for (unsigned int r = 0; r < m_nCols; ++r){
+                std::fill(block, block + 64, 0);
+                for (unsigned int l = 0; l < m_nLanes; ++l){
+                    block[l] = lastMatrices[l][r];
+                }
+                PackedGeneratingMatrix::transpose64(block);
+                std::copy(block, block + m_nCols, &m_slicedRows[r * m_nCols]);
+            }
+            for (unsigned int l = 0; l < m_nLanes; ++l){
+                m_bounds[l] = m_nCols - std::min(maxSubProj[l], m_nCols);
+            }
+
+            explore(0, 0);
+            std::vector<unsigned int> res(m_nLanes);
+            for (unsigned int l = 0; l < m_nLanes; ++l){
+                res[l] = m_nCols - m_bounds[l];
+            }
+            return res;
         }
-        for (unsigned int i= ((smallestFullRankIndex > mMin) ? smallestFullRankIndex-mMin: 0); i<previousIndSmallestInvertible; i++){
-            result[i+diff] = std::max(nCols-(nLevel-1-i)-k, maxSubProj[i+diff]);
+
+    private:
+        const MatricesView<PackedGeneratingMatrix>* m_commonMatrices; // generating matrices shared by the projections
+        unsigned int m_nCols; // number of rows and columns of the matrices
+        unsigned int m_nLanes; // number of projections
+        std::vector<Lanes> m_slicedRows; // bit l of word r * m_nCols + j is element (r, j) of the last matrix of projection l
+        std::vector<Lanes> m_reducedRows; // reduced bit-sliced rows of the last matrices
+        std::vector<Lanes> m_pivots; // bit l of word r * m_nCols + j is set if column j is the pivot of reduced row r of projection l
+        std::vector<unsigned int> m_bounds; // current upper bound on the strength of each projection
+        PivotBasis<PackedGeneratingMatrix> m_basis; // basis of the system made of the rows of the common matrices
+
+        unsigned int maxBound() const
+        {
+            return *std::max_element(m_bounds.begin(), m_bounds.end());
         }
-        if (smallestFullRankIndex <= mMin){
-            break;
-        } 
-        previousIndSmallestInvertible = smallestFullRankIndex-mMin;
-    
+
+        void lowerBounds(Lanes lanes, unsigned int value)
+        {
+            for (; lanes; lanes &= lanes - 1){
+                unsigned int l = PackedGeneratingMatrix::lowestBit(lanes);
+                m_bounds[l] = std::min(m_bounds[l], value);
+            }
+        }
+
+        Lanes lanesAbove(unsigned int value) const
+        {
+            Lanes lanes = 0;
+            for (unsigned int l = 0; l < m_nLanes; ++l){
+                if (m_bounds[l] > value){
+                    lanes |= Lanes(1) << l;
+                }
+            }
+            return lanes;
+        }
+
+        /**
+         * Enumerates the number of rows taken in the common matrix \c level and the following ones.
+         */
+        void explore(unsigned int level, unsigned int sum)
+        {
+            if (level == m_commonMatrices->size()){
+                evaluate(sum);
+                return;
+            }
+            const unsigned int remainingLevels = (unsigned int) m_commonMatrices->size() - level - 1;
+            unsigned int nAddedRows = 0;
+            for (unsigned int d = 1; d <= m_nCols; ++d){
+                const unsigned int minSum = sum + d + remainingLevels; // smallest size of the completed systems
+                if (minSum + 1 > maxBound()){
+                    break;
+                }
+                if (!m_basis.addRow((*m_commonMatrices)[level][d-1])){
+                    // the completed systems are not of full rank: the smallest one bounds the strength
+                    lowerBounds(lanesAbove(minSum), minSum);
+                    break;
+                }
+                ++nAddedRows;
+                explore(level + 1, sum + d);
+            }
+            for (unsigned int i = 0; i < nAddedRows; ++i){
+                m_basis.removeLastRow();
+            }
+        }
+
+        /**
+         * Computes \f$e(F)\f$ for all the projections whose bound may decrease.
+         */
+        void evaluate(unsigned int sum)
+        {
+            Lanes alive = lanesAbove(sum);
+            if (!alive){
+                return;
+            }
+            unsigned int cols[PackedGeneratingMatrix::maxNumCols]; // pivots of the common system, in increasing order
+            unsigned int nPivots = 0;
+            for (unsigned int col = 0; col < m_nCols; ++col){
+                if (m_basis.hasPivot(col)){
+                    cols[nPivots++] = col;
+                }
+            }
+            const unsigned int nRowsNeeded = maxBound() - sum;
+            for (unsigned int r = 0; r < nRowsNeeded; ++r){
+                Lanes* v = &m_reducedRows[r * m_nCols];
+                std::copy(&m_slicedRows[r * m_nCols], &m_slicedRows[(r + 1) * m_nCols], v);
+
+                // reduction modulo the common system
+                for (unsigned int i = 0; i < nPivots; ++i){
+                    const unsigned int col = cols[i];
+                    const Lanes w = v[col];
+                    if (w){
+                        for (PackedGeneratingMatrix::Row bits = m_basis.row(col) & ~(PackedGeneratingMatrix::Row(1) << col); bits; bits &= bits - 1){
+                            v[PackedGeneratingMatrix::lowestBit(bits)] ^= w;
+                        }
+                        v[col] = 0;
+                    }
+                }
+
+                // reduction modulo the previous rows of the last matrix
+                for (unsigned int i = 0; i < r; ++i){
+                    const Lanes* pivots = &m_pivots[i * m_nCols];
+                    Lanes t = 0;
+                    for (unsigned int j = 0; j < m_nCols; ++j){
+                        t |= pivots[j] & v[j];
+                    }
+                    if (t){
+                        const Lanes* row = &m_reducedRows[i * m_nCols];
+                        for (unsigned int j = 0; j < m_nCols; ++j){
+                            v[j] ^= t & row[j];
+                        }
+                    }
+                }
+
+                // pivot of the row
+                Lanes* pivots = &m_pivots[r * m_nCols];
+                Lanes nonZero = 0;
+                for (unsigned int j = 0; j < m_nCols; ++j){
+                    pivots[j] = v[j] & ~nonZero;
+                    nonZero |= v[j];
+                }
+
+                lowerBounds(alive & ~nonZero, sum + r);
+                alive &= nonZero & lanesAbove(sum + r + 1);
+                if (!alive){
+                    break;
+                }
+            }
+        }
+};
+
+}
+
+constexpr unsigned int GaussMethod::batchSize;
+
+std::vector<unsigned int> GaussMethod::computeTValues(const MatricesView<PackedGeneratingMatrix>& commonMatrices, const MatricesView<PackedGeneratingMatrix>& lastMatrices, const std::vector<unsigned int>& maxTValuesSubProj)
+{
+    assert(lastMatrices.size() <= batchSize);
+    if (lastMatrices.size() == 0)
+    {
+        return {};
     }
-    return result;
+    if (commonMatrices.size() == 0)
+    {
+        return std::vector<unsigned int>(lastMatrices.size(), 0);
+    }
+    if (commonMatrices.size() + 1 > lastMatrices[0].nCols())
+    {
+        return maxTValuesSubProj;
+    }
+    static thread_local BitSlicedTValueBatch batch;
+    return batch.compute(commonMatrices, lastMatrices, maxTValuesSubProj);
 }
 
+unsigned int GaussMethod::computeTValue(std::vector<GeneratingMatrix> baseMatrices, unsigned int maxSubProj, int verbose)
+{
+    return computeTValue(MatricesView<GeneratingMatrix>(pointersTo(baseMatrices)), maxSubProj, verbose);
 }
- 
 
+std::vector<unsigned int> GaussMethod::computeTValue(std::vector<GeneratingMatrix> baseMatrices, unsigned int mMin, const std::vector<unsigned int>& maxSubProj, int)
+{
+    return computeTValueWithPacking(MatricesView<GeneratingMatrix>(pointersTo(baseMatrices)), mMin, maxSubProj);
+}
+
+unsigned int GaussMethod::computeTValue(std::vector<PackedGeneratingMatrix> baseMatrices, unsigned int maxSubProj, int verbose)
+{
+    return computeTValue(MatricesView<PackedGeneratingMatrix>(pointersTo(baseMatrices)), maxSubProj, verbose);
+}
+
+std::vector<unsigned int> GaussMethod::computeTValue(std::vector<PackedGeneratingMatrix> baseMatrices, unsigned int mMin, const std::vector<unsigned int>& maxSubProj, int)
+{
+    return computeTValueImpl(MatricesView<PackedGeneratingMatrix>(pointersTo(baseMatrices)), mMin, maxSubProj);
+}
+
+unsigned int GaussMethod::computeTValue(const MatricesView<GeneratingMatrix>& baseMatrices, unsigned int maxSubProj, int)
+{
+    unsigned int s = (unsigned int) baseMatrices.size();
+    if (s == 1)
+    {
+        return 0;
+    }
+
+    return computeTValueWithPacking(baseMatrices, baseMatrices[0].nCols()-1, {maxSubProj})[0];
+}
+
+std::vector<unsigned int> GaussMethod::computeTValue(const MatricesView<GeneratingMatrix>& baseMatrices, const std::vector<unsigned int>& maxSubProj, int)
+{
+    return computeTValueWithPacking(baseMatrices, 0, maxSubProj);
+}
+
+unsigned int GaussMethod::computeTValue(const MatricesView<PackedGeneratingMatrix>& baseMatrices, unsigned int maxSubProj, int)
+{
+    unsigned int s = (unsigned int) baseMatrices.size();
+    if (s == 1)
+    {
+        return 0;
+    }
+
+    unsigned int nCols = baseMatrices[0].nCols();
+    return computeTValueImpl(baseMatrices, nCols-1, {maxSubProj})[0];
+}
+
+std::vector<unsigned int> GaussMethod::computeTValue(const MatricesView<PackedGeneratingMatrix>& baseMatrices, const std::vector<unsigned int>& maxSubProj, int)
+{
+    return computeTValueImpl(baseMatrices, 0, maxSubProj);
+}
+
+}
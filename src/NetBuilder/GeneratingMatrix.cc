@@ -15,6 +15,7 @@
 // limitations under the License.
 
 #include "netbuilder/GeneratingMatrix.h"
+#include "netbuilder/PackedGeneratingMatrix.h"
 
 #include <algorithm>
 
@@ -47,7 +48,7 @@ std::vector<unsigned long> GeneratingMatrix::getColsReverse() const{
     for (unsigned int j=0; j<nCols(); j++){
         unsigned long s = 0;
         for (unsigned int i=0; i<nRows(); i++){
-            s += (*this)(i, j) << (nRows() - i -1);
+            s += (unsigned long) (*this)(i, j) << (nRows() - i -1);
         }
         res[j] = s;
     }
@@ -85,6 +86,11 @@ GeneratingMatrix::Row& GeneratingMatrix::operator[](unsigned int i)
     return m_data[i];
 }
 
+void GeneratingMatrix::resetRow(unsigned int i)
+{
+    m_data[i].reset();
+}
+
 bool GeneratingMatrix::operator()(unsigned int i, unsigned j) const
 {
     return m_data[i][j];
@@ -184,13 +190,29 @@ std::string GeneratingMatrix::formatToColumnsReverse(unsigned int nBits) const
 GeneratingMatrix GeneratingMatrix::operator*(const GeneratingMatrix& m) const
 {
     assert ((*this).nCols() == m.nRows());
-    GeneratingMatrix res(nRows(),m.nCols());
+    if (PackedGeneratingMatrix::fits(nCols()) && PackedGeneratingMatrix::fits(m.nCols())){
+        return (PackedGeneratingMatrix(*this) * PackedGeneratingMatrix(m)).toGeneratingMatrix();
+    }
 
+    GeneratingMatrix res(nRows(),m.nCols());
     for (unsigned int i=0; i<(*this).nRows(); i++){
-        for (unsigned int j=0; j<(*this).nCols(); j++){
-            if ((*this)(i, j)){
-                res[i] ^= m[j];
-            }
+        for (Row::size_type j = m_data[i].find_first(); j != Row::npos; j = m_data[i].find_next(j)){
+            res[i] ^= m[j];
+        }
+    }
+    return res;
+}
+
+GeneratingMatrix GeneratingMatrix::transpose() const
+{
+    if (PackedGeneratingMatrix::fits(nRows()) && PackedGeneratingMatrix::fits(nCols())){
+        return PackedGeneratingMatrix(*this).transpose().toGeneratingMatrix();
+    }
+
+    GeneratingMatrix res(nCols(), nRows());
+    for (unsigned int i=0; i<nRows(); i++){
+        for (Row::size_type j = m_data[i].find_first(); j != Row::npos; j = m_data[i].find_next(j)){
+            res(j, i) = true;
         }
     }
     return res;
@@ -0,0 +1,150 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "netbuilder/Helpers/GrayCodeMatrixEnumerator.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace NetBuilder {
+
+constexpr unsigned int GrayCodeMatrixEnumerator::maxNumElements;
+
+void GrayCodeMatrixEnumerator::checkNumElements(unsigned int nMatrices, unsigned int nRows, unsigned int nCols)
+{
+    const uInteger nElements = (uInteger) nMatrices * nRows * nCols;
+    if (nElements > maxNumElements)
+    {
+        throw std::logic_error("The space of all matrices is far too big to be exhaustively explored: the generating matrices have "
+            + std::to_string(nElements) + " elements in total, while at most " + std::to_string(maxNumElements) + " elements are supported.");
+    }
+}
+
+GrayCodeMatrixEnumerator::GrayCodeMatrixEnumerator(unsigned int nMatrices, unsigned int nRows, unsigned int nCols, bool fullRankOnly):
+    m_nRows(nRows),
+    m_nCols(nCols),
+    m_fullRankOnly(fullRankOnly),
+    m_fullRank(std::min(nRows, nCols)),
+    m_matrices(nMatrices, PackedGeneratingMatrix(nRows, nCols)),
+    m_modified(nMatrices, false)
+{
+    checkNumElements(nMatrices, nRows, nCols);
+    m_nGrayCodes = uInteger(1) << (nMatrices * nRows * nCols);
+
+    if (m_fullRankOnly)
+    {
+        // number of k x m matrices of full rank: prod_{i < min(k,m)} (2^max(k,m) - 2^i)
+        const unsigned int largestDim = std::max(nRows, nCols);
+        uInteger nFullRank = 1;
+        for (unsigned int i = 0; i < m_fullRank; ++i)
+        {
+            nFullRank *= (uInteger(1) << largestDim) - (uInteger(1) << i);
+        }
+        m_size = 1;
+        for (unsigned int k = 0; k < nMatrices; ++k)
+        {
+            m_size *= nFullRank;
+        }
+    }
+    else
+    {
+        m_size = m_nGrayCodes;
+    }
+
+    reset();
+}
+
+void GrayCodeMatrixEnumerator::reset()
+{
+    m_grayIndex = 0;
+    m_count = 0;
+    m_started = false;
+    for (auto& mat : m_matrices)
+    {
+        mat = PackedGeneratingMatrix(m_nRows, m_nCols);
+    }
+    if (m_fullRankOnly)
+    {
+        m_rankComputers.assign(m_matrices.size(), PackedRankComputer(m_nCols));
+        for (auto& rankComputer : m_rankComputers)
+        {
+            rankComputer.addRows(PackedGeneratingMatrix(m_nRows, m_nCols));
+        }
+        m_nRankDeficient = (m_fullRank > 0) ? (unsigned int) m_matrices.size() : 0;
+    }
+    else
+    {
+        m_nRankDeficient = 0;
+    }
+}
+
+void GrayCodeMatrixEnumerator::flipBit(unsigned int bit)
+{
+    const unsigned int nElements = m_nRows * m_nCols;
+    const unsigned int k = bit / nElements;
+    const unsigned int row = (bit % nElements) / m_nCols;
+    const unsigned int col = bit % m_nCols;
+
+    m_matrices[k].flip(row, col);
+    m_modified[k] = true;
+
+    if (m_fullRankOnly)
+    {
+        PackedRankComputer& rankComputer = m_rankComputers[k];
+        const bool wasFullRank = rankComputer.computeRank() == m_fullRank;
+        rankComputer.flip(row, col);
+        const bool isFullRank = rankComputer.computeRank() == m_fullRank;
+        if (wasFullRank && !isFullRank)
+        {
+            ++m_nRankDeficient;
+        }
+        else if (!wasFullRank && isFullRank)
+        {
+            --m_nRankDeficient;
+        }
+    }
+}
+
+bool GrayCodeMatrixEnumerator::goToNextMatrices()
+{
+    std::fill(m_modified.begin(), m_modified.end(), false);
+
+    if (!m_started)
+    {
+        m_started = true;
+        std::fill(m_modified.begin(), m_modified.end(), true);
+        if (m_nRankDeficient == 0)
+        {
+            ++m_count;
+            return true;
+        }
+    }
+
+    while (m_grayIndex + 1 < m_nGrayCodes)
+    {
+        ++m_grayIndex;
+        flipBit(PackedGeneratingMatrix::lowestBit(m_grayIndex)); // the Gray codes of i - 1 and i differ by the lowest set bit of i
+        if (m_nRankDeficient == 0)
+        {
+            ++m_count;
+            return true;
+        }
+    }
+    return false;
+}
+
+}
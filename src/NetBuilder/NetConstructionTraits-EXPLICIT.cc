@@ -38,12 +38,18 @@ namespace NetBuilder {
 
     GeneratingMatrix*  NetConstructionTraits<NetConstruction::EXPLICIT>::createGeneratingMatrix(const GenValue& genValue, const SizeParameter& sizeParameter, const Dimension& dimension_j, const unsigned int nRows)
     {
-        unsigned int finalnRows = (nRows == 0)? NetConstructionTraits<NetConstruction::EXPLICIT>::nRows(sizeParameter) : nRows;
-        GeneratingMatrix* genMat = new GeneratingMatrix(genValue);
-        genMat->resize(finalnRows, nCols(sizeParameter));
+        GeneratingMatrix* genMat = new GeneratingMatrix();
+        fillGeneratingMatrix(*genMat, genValue, sizeParameter, dimension_j, nRows);
         return genMat;
     }
 
+    void NetConstructionTraits<NetConstruction::EXPLICIT>::fillGeneratingMatrix(GeneratingMatrix& genMat, const GenValue& genValue, const SizeParameter& sizeParameter, const Dimension& dimension_j, const unsigned int nRows)
+    {
+        unsigned int finalnRows = (nRows == 0)? NetConstructionTraits<NetConstruction::EXPLICIT>::nRows(sizeParameter) : nRows;
+        genMat = genValue;
+        genMat.resize(finalnRows, nCols(sizeParameter));
+    }
+
     std::vector<GenValue> NetConstructionTraits<NetConstruction::EXPLICIT>::genValueSpaceCoord(Dimension coord, const SizeParameter& sizeParameter)
     {
         throw std::logic_error("The space of all matrices is far too big to be exhautively explored.");
@@ -44,12 +44,18 @@ namespace NetBuilder {
 
     GeneratingMatrix*  NetConstructionTraits<NetConstruction::LMS>::createGeneratingMatrix(const GenValue& genValue, const SizeParameter& sizeParameter, const Dimension& dimension_j, const unsigned int nRows)
     {
-        GeneratingMatrix* result = new GeneratingMatrix(genValue * *sizeParameter.second[dimension_j]);
-        unsigned int finalnRows = (nRows == 0)? NetConstructionTraits<NetConstruction::LMS>::nRows(sizeParameter) : nRows;
-        result->resize(finalnRows, nCols(sizeParameter));
+        GeneratingMatrix* result = new GeneratingMatrix();
+        fillGeneratingMatrix(*result, genValue, sizeParameter, dimension_j, nRows);
         return result;
     }
 
+    void NetConstructionTraits<NetConstruction::LMS>::fillGeneratingMatrix(GeneratingMatrix& genMat, const GenValue& genValue, const SizeParameter& sizeParameter, const Dimension& dimension_j, const unsigned int nRows)
+    {
+        genMat = genValue * *sizeParameter.second[dimension_j];
+        unsigned int finalnRows = (nRows == 0)? NetConstructionTraits<NetConstruction::LMS>::nRows(sizeParameter) : nRows;
+        genMat.resize(finalnRows, nCols(sizeParameter));
+    }
+
     std::vector<GenValue> NetConstructionTraits<NetConstruction::LMS>::genValueSpaceCoord(Dimension coord, const SizeParameter& sizeParameter)
     {
         throw std::logic_error("The space of all matrices is far too big to be exhautively explored.");
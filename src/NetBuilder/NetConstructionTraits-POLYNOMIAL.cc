@@ -21,6 +21,7 @@
 #include "latbuilder/Util.h"
 
 #include <NTL/GF2X.h>
+#include <limits>
 #include <sstream>
 #include <boost/algorithm/string/erase.hpp>
 
@@ -44,33 +45,80 @@ namespace NetBuilder {
     unsigned int NetConstructionTraits<NetConstruction::POLYNOMIAL>::nCols(const SizeParameter& sizeParameter) {return (unsigned int) deg(sizeParameter); }
 
 
-    void expandSeries(const GenValue& genValue, const SizeParameter& sizeParameter, std::vector<unsigned int>& expansion, unsigned int expansion_limit){
-        int m = (int) deg(sizeParameter); 
-        for(int l = 1; l<= (int) expansion_limit ; l++){
-            int res =  (m-l >=0 && IsOne(coeff(genValue, m-l)))? 1 : 0;
-            int start = (l-m > 1) ? (l-m) : 1;
-            for( int p = start; p < l; p++){
-                res = ( res + expansion[p-1] * NTL::conv<int>(coeff(sizeParameter, m-(l-p)))) %2;        
+    /// Type of the words used to store bit strings.
+    typedef GeneratingMatrix::Row::block_type Block;
+
+    /// Number of bits in a word.
+    constexpr unsigned int BLOCK_BITS = std::numeric_limits<Block>::digits;
+
+    /**
+     * Computes the first \c expansion_limit coefficients of the Laurent series expansion of
+     * <code>genValue / sizeParameter</code> in powers of <code>1/z</code>. The expansion is obtained by long division:
+     * the remainder is kept as a bit string of words, multiplied by <code>z</code> with a shift and reduced modulo 
+     * \c sizeParameter with a XOR. The coefficient of <code>z^{-l}</code> is stored in bit <code>l-1</code> of 
+     * \c expansion, which is filled by words.
+     * The words of the remainder and of the modulus are kept across calls by each thread.
+     */
+    void expandSeries(const GenValue& genValue, const SizeParameter& sizeParameter, std::vector<Block>& expansion, unsigned int expansion_limit){
+        const unsigned int m = (unsigned int) deg(sizeParameter);
+        const unsigned int nWords = m / BLOCK_BITS + 1; // number of words of a polynomial of degree m
+        const unsigned int topWord = m / BLOCK_BITS;
+        const Block topBit = Block(1) << (m % BLOCK_BITS);
+
+        static thread_local std::vector<Block> modulus;
+        static thread_local std::vector<Block> remainder;
+        modulus.assign(nWords, 0);
+        remainder.assign(nWords, 0);
+        for(unsigned int i = 0; i <= m; i++){
+            if (IsOne(coeff(sizeParameter, i))){
+                modulus[i / BLOCK_BITS] |= Block(1) << (i % BLOCK_BITS);
+            }
+            if (i < m && IsOne(coeff(genValue, i))){
+                remainder[i / BLOCK_BITS] |= Block(1) << (i % BLOCK_BITS);
+            }
+        }
+
+        expansion.assign((expansion_limit + BLOCK_BITS - 1) / BLOCK_BITS, 0);
+        for(unsigned int l = 0; l < expansion_limit; l++){
+            for(unsigned int w = nWords - 1; w > 0; w--){
+                remainder[w] = (remainder[w] << 1) | (remainder[w-1] >> (BLOCK_BITS - 1));
+            }
+            remainder[0] <<= 1;
+            if (remainder[topWord] & topBit){
+                expansion[l / BLOCK_BITS] |= Block(1) << (l % BLOCK_BITS);
+                for(unsigned int w = 0; w < nWords; w++){
+                    remainder[w] ^= modulus[w];
+                }
             }
-            expansion[l-1] = res;
         }
     }
 
     GeneratingMatrix*  NetConstructionTraits<NetConstruction::POLYNOMIAL>::createGeneratingMatrix(const GenValue& genValue, const SizeParameter& sizeParameter, const Dimension& dimension_j, const unsigned int nRows)
+    {
+        GeneratingMatrix* genMat = new GeneratingMatrix();
+        fillGeneratingMatrix(*genMat, genValue, sizeParameter, dimension_j, nRows);
+        return genMat;
+    }
+
+    void NetConstructionTraits<NetConstruction::POLYNOMIAL>::fillGeneratingMatrix(GeneratingMatrix& genMat, const GenValue& genValue, const SizeParameter& sizeParameter, const Dimension& dimension_j, const unsigned int nRows)
     {
         unsigned int m = (unsigned int) (deg(sizeParameter));
         unsigned int finalnRows = (nRows == 0)? m : nRows;
-        GeneratingMatrix* genMat = new GeneratingMatrix(finalnRows, m);
-        std::vector<unsigned int> expansion(finalnRows + m);
+        static thread_local std::vector<Block> expansion;
         expandSeries(genValue, sizeParameter, expansion, finalnRows + m);
-        for(unsigned int c = 0; c < m; c++)
+
+        // the matrix is a Hankel matrix: row i is the window of the expansion starting at bit i
+        static thread_local GeneratingMatrix::Row window;
+        window.clear();
+        window.append(expansion.begin(), expansion.end());
+        genMat.resize(finalnRows, m);
+        for(unsigned int row = 0; row < finalnRows; row++)
         {
-            for(unsigned int row = 0; row < finalnRows; row++)
-            {
-                (*genMat)(row,c) = expansion[c + row];
-            }
+            GeneratingMatrix::Row& genRow = genMat[row];
+            genRow = window;
+            genRow.resize(m);
+            window >>= 1;
         }
-        return genMat;
     }
 
     typename NetConstructionTraits<NetConstruction::POLYNOMIAL>::GenValueSpaceCoordSeq NetConstructionTraits<NetConstruction::POLYNOMIAL>::genValueSpaceCoord(Dimension coord, const SizeParameter& sizeParameter)
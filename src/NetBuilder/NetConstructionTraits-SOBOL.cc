@@ -120,6 +120,13 @@ namespace NetBuilder {
     }
 
     GeneratingMatrix*  NetConstructionTraits<NetConstruction::SOBOL>::createGeneratingMatrix(const GenValue& genValue, const SizeParameter& sizeParam, const Dimension& dimension_j, const unsigned int nRows)
+    {
+        GeneratingMatrix* tmp = new GeneratingMatrix();
+        fillGeneratingMatrix(*tmp, genValue, sizeParam, dimension_j, nRows);
+        return tmp;
+    }
+
+    void NetConstructionTraits<NetConstruction::SOBOL>::fillGeneratingMatrix(GeneratingMatrix& genMat, const GenValue& genValue, const SizeParameter& sizeParam, const Dimension& dimension_j, const unsigned int nRows)
     {
         unsigned int m  = nCols(sizeParam);
         unsigned int finalnRows = (nRows == 0)? m : nRows;
@@ -127,11 +134,12 @@ namespace NetBuilder {
 
         if (coord==0) // special case for the first dimension
         {
-            GeneratingMatrix* tmp = new GeneratingMatrix(m,m);
+            genMat.resize(m,m);
             for(unsigned int k = 0; k<m; ++k){
-            (*tmp)(k,k) = 1; // start with identity
+            genMat.resetRow(k);
+            genMat(k,k) = 1; // start with identity
             }
-            return tmp;
+            return;
         }
 
         // compute the vector defining the linear recurrence on the columns of the matrix
@@ -140,7 +148,11 @@ namespace NetBuilder {
         auto poly_rep = p.second;
         boost::dynamic_bitset<> mask(degree,(poly_rep << 1) + 1);
         unsigned int matrixSize = std::max(degree,m);
-        GeneratingMatrix* tmp = new GeneratingMatrix(matrixSize, matrixSize);
+        genMat.resize(matrixSize, matrixSize);
+        for(unsigned int i = 0; i < matrixSize; ++i)
+        {
+            genMat.resetRow(i);
+        }
         std::list<boost::dynamic_bitset<>> reg;
         unsigned int k = 1;
         for(auto dirNum : genValue.second)
@@ -148,17 +160,16 @@ namespace NetBuilder {
             reg.push_back(boost::dynamic_bitset<>(k,dirNum));
             for(unsigned int i = 0; i < k; ++i)
             {
-                (*tmp)(i,k-1) = reg.back()[k-i-1];
+                genMat(i,k-1) = reg.back()[k-i-1];
             }
             ++k;
         }
         while (k<=matrixSize)
         {
-            makeIteration(*tmp, reg, mask, k);
+            makeIteration(genMat, reg, mask, k);
             ++k;
         }
-        tmp->resize(finalnRows, m);
-        return tmp;
+        genMat.resize(finalnRows, m);
     }
 
    NetConstructionTraits<NetConstruction::SOBOL>::GenValueSpaceCoordSeq::GenValueSpaceCoordSeq(Dimension coord):
@@ -0,0 +1,243 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "netbuilder/PackedGeneratingMatrix.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace NetBuilder {
+
+PackedGeneratingMatrix::PackedGeneratingMatrix(unsigned int nRows, unsigned int nCols):
+    m_data(nRows, 0),
+    m_nRows(nRows),
+    m_nCols(nCols)
+{
+    assert(fits(nCols));
+};
+
+PackedGeneratingMatrix::PackedGeneratingMatrix(unsigned int nRows, unsigned int nCols, std::vector<uInteger> init):
+    m_data(nRows),
+    m_nRows(nRows),
+    m_nCols(nCols)
+{
+    assert(fits(nCols));
+    assert(init.size() == m_nRows);
+    const Row colMask = mask(m_nCols);
+    for(unsigned int i = 0; i < m_nRows; ++i)
+    {
+        m_data[i] = Row(init[i]) & colMask;
+    }
+};
+
+PackedGeneratingMatrix::PackedGeneratingMatrix(const GeneratingMatrix& mat):
+    m_nRows(0),
+    m_nCols(0)
+{
+    assign(mat);
+}
+
+void PackedGeneratingMatrix::assign(const GeneratingMatrix& mat)
+{
+    assert(fits(mat.nCols()));
+    m_nRows = mat.nRows();
+    m_nCols = mat.nCols();
+    m_data.resize(m_nRows);
+    typedef GeneratingMatrix::Row::block_type Block;
+    Block blocks[maxNumCols]; // a row of at most 64 columns has at most 64 blocks
+    for(unsigned int i = 0; i < m_nRows; ++i)
+    {
+        const size_t nBlocks = mat[i].num_blocks();
+        boost::to_block_range(mat[i], blocks);
+        Row row = 0;
+        for(unsigned int b = 0; b < nBlocks && b * GeneratingMatrix::Row::bits_per_block < maxNumCols; ++b)
+        {
+            row |= Row(blocks[b]) << (b * GeneratingMatrix::Row::bits_per_block);
+        }
+        m_data[i] = row;
+    }
+}
+
+GeneratingMatrix PackedGeneratingMatrix::toGeneratingMatrix() const
+{
+    std::vector<GeneratingMatrix::uInteger> init(m_data.begin(), m_data.end());
+    return GeneratingMatrix(m_nRows, m_nCols, std::move(init));
+}
+
+void PackedGeneratingMatrix::resize(unsigned int nRows, unsigned int nCols)
+{
+    assert(fits(nCols));
+    m_data.resize(nRows, 0);
+    if (nCols < m_nCols)
+    {
+        const Row colMask = mask(nCols);
+        for(auto& row : m_data)
+        {
+            row &= colMask;
+        }
+    }
+    m_nRows = nRows;
+    m_nCols = nCols;
+}
+
+PackedGeneratingMatrix PackedGeneratingMatrix::upperLeftSubMatrix(unsigned int nRows, unsigned int nCols) const
+{
+    return subMatrix(0, 0, nRows, nCols);
+}
+
+PackedGeneratingMatrix PackedGeneratingMatrix::subMatrix(unsigned int startingRow, unsigned int startingCol, unsigned int nRows, unsigned int nCols) const
+{
+    PackedGeneratingMatrix res(nRows, nCols);
+    const Row colMask = mask(nCols);
+    for(unsigned int i = 0; i < nRows; ++i)
+    {
+        res.m_data[i] = (m_data[startingRow + i] >> startingCol) & colMask;
+    }
+    return res;
+}
+
+void PackedGeneratingMatrix::transpose64(Row* a)
+{
+    Row mask = 0x00000000FFFFFFFFULL;
+    for (unsigned int width = 32; width != 0; width >>= 1, mask ^= (mask << width))
+    {
+        for (unsigned int k = 0; k < 64; k = ((k | width) + 1) & ~width)
+        {
+            Row t = ((a[k] >> width) ^ a[k | width]) & mask;
+            a[k] ^= t << width;
+            a[k | width] ^= t;
+        }
+    }
+}
+
+PackedGeneratingMatrix PackedGeneratingMatrix::transpose() const
+{
+    assert(fits(m_nRows));
+    Row block[maxNumCols] = {};
+    std::copy(m_data.begin(), m_data.end(), block);
+    transpose64(block);
+    PackedGeneratingMatrix res(m_nCols, m_nRows);
+    std::copy(block, block + m_nCols, res.m_data.begin());
+    return res;
+}
+
+namespace {
+    // maximal number of columns of the right factor for which the product is computed with parities
+    const unsigned int maxColsParity = 4;
+
+    // number of rows of the right factor combined in each table of the Method of Four Russians: building the tables costs
+    // 2^k operations per group of k rows and each row of the product one lookup per group
+    unsigned int fourRussiansBits(unsigned int nRows)
+    {
+        return (nRows < 128) ? 4 : (nRows < 512) ? 6 : 8;
+    }
+
+    // size of the tables of all the groups for the largest number of rows in a group
+    const unsigned int maxTablesSize = (PackedGeneratingMatrix::maxNumCols / 8) * 256;
+}
+
+PackedGeneratingMatrix PackedGeneratingMatrix::operator*(const PackedGeneratingMatrix& m) const
+{
+    assert(nCols() == m.nRows());
+    PackedGeneratingMatrix res(nRows(), m.nCols());
+    if (m.nCols() <= maxColsParity)
+    {
+        Row cols[maxColsParity] = {}; // columns of m
+        for(unsigned int j = 0; j < m.nRows(); ++j)
+        {
+            for(unsigned int c = 0; c < m.nCols(); ++c)
+            {
+                cols[c] |= ((m.m_data[j] >> c) & 1) << j;
+            }
+        }
+        for(unsigned int i = 0; i < nRows(); ++i)
+        {
+            Row acc = 0;
+            for(unsigned int c = 0; c < m.nCols(); ++c)
+            {
+                acc |= Row(parity(m_data[i] & cols[c])) << c;
+            }
+            res.m_data[i] = acc;
+        }
+        return res;
+    }
+
+    // tabulate the combinations of the rows of each group, the missing rows of the last group being zero
+    const unsigned int tableBits = fourRussiansBits(nRows());
+    const unsigned int tableSize = 1u << tableBits;
+    const unsigned int nGroups = (nCols() + tableBits - 1) / tableBits;
+    Row tables[maxTablesSize];
+    for(unsigned int g = 0; g < nGroups; ++g)
+    {
+        Row* table = &tables[g * tableSize];
+        table[0] = 0;
+        for(unsigned int k = 1; k < tableSize; ++k) // each combination adds one row to a smaller one
+        {
+            const unsigned int row = g * tableBits + lowestBit(k);
+            table[k] = table[k & (k - 1)] ^ (row < m.nRows() ? m.m_data[row] : 0);
+        }
+    }
+
+    const Row groupMask = tableSize - 1;
+    for(unsigned int i = 0; i < nRows(); ++i)
+    {
+        Row row = m_data[i];
+        Row acc = 0;
+        for(unsigned int g = 0; g < nGroups; ++g, row >>= tableBits)
+        {
+            acc ^= tables[g * tableSize + (row & groupMask)];
+        }
+        res.m_data[i] = acc;
+    }
+    return res;
+}
+
+void PackedGeneratingMatrix::stackRight(const PackedGeneratingMatrix& block)
+{
+    assert(block.nRows() == m_nRows);
+    assert(fits(m_nCols + block.nCols()));
+    if (block.nCols() > 0)
+    {
+        for(unsigned int i = 0; i < m_nRows; ++i)
+        {
+            m_data[i] |= block.m_data[i] << m_nCols;
+        }
+    }
+    m_nCols += block.nCols();
+}
+
+void PackedGeneratingMatrix::stackBelow(const PackedGeneratingMatrix& block)
+{
+    m_data.insert(m_data.end(), block.m_data.begin(), block.m_data.end());
+    m_nRows += block.nRows();
+}
+
+std::ostream& operator<<(std::ostream& os, const PackedGeneratingMatrix& mat)
+{
+    for(unsigned int i = 0; i < mat.m_nRows; ++i)
+    {
+        for(unsigned int j = 0; j < mat.m_nCols; ++j)
+        {
+            os << mat(i,j);
+            if (j < mat.m_nCols - 1)
+                os << " ";
+        }
+        os << std::endl;
+    }
+    return os;
+}
+
+}
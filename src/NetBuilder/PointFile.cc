@@ -0,0 +1,180 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "netbuilder/PointFile.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define NETBUILDER_POINT_FILE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace NetBuilder {
+
+static_assert(sizeof(PointFileHeader) == 64, "The header of point files must have 64 bytes.");
+
+constexpr size_t PointFileWriter::defaultBlockBytes;
+
+PointFileWriter::PointFileWriter(std::string filename, PointFormat format, PointOrder order, uInteger numPoints, Dimension dimension,
+                                 uint64_t modulus, bool useMemoryMap, uInteger numReplicates, size_t blockBytes):
+    m_filename(std::move(filename)),
+    m_format(format),
+    m_order(order),
+    m_numPoints(numPoints),
+    m_dimension(dimension),
+    m_modulus(modulus),
+    m_useMemoryMap(useMemoryMap),
+    m_numReplicates(numReplicates)
+{
+    const size_t pointBytes = std::max<size_t>(1, valueSize(m_format) * m_dimension);
+    m_blockSize = std::max<uInteger>(1, blockBytes / pointBytes);
+}
+
+size_t PointFileWriter::valueSize(PointFormat format)
+{
+    switch (format)
+    {
+        case PointFormat::FLOAT64: return sizeof(double);
+        case PointFormat::FLOAT32: return sizeof(float);
+        case PointFormat::UINT32: return sizeof(uint32_t);
+        case PointFormat::UINT64: return sizeof(uint64_t);
+    }
+    throw std::logic_error("Point file: unknown point format.");
+}
+
+PointFileHeader PointFileWriter::header() const
+{
+    PointFileHeader res;
+    std::memset(&res, 0, sizeof(res));
+    std::memcpy(res.magic, "LATNETPT", sizeof(res.magic));
+    res.version = 1;
+    res.headerSize = sizeof(PointFileHeader);
+    res.format = (uint32_t) m_format;
+    res.order = (uint32_t) m_order;
+    res.numPoints = m_numPoints;
+    res.dimension = m_dimension;
+    res.modulus = m_modulus;
+    res.numReplicates = m_numReplicates;
+    return res;
+}
+
+void PointFileWriter::write(const BlockGenerator& generateBlock) const
+{
+#ifdef NETBUILDER_POINT_FILE_MMAP
+    if (m_useMemoryMap)
+    {
+        writeMemoryMap(generateBlock);
+        return;
+    }
+#endif
+    writeStream(generateBlock);
+}
+
+void PointFileWriter::writeStream(const BlockGenerator& generateBlock) const
+{
+    std::ofstream file(m_filename, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        throw std::runtime_error("Point file: cannot open " + m_filename + ".");
+    }
+    const PointFileHeader head = header();
+    file.write(reinterpret_cast<const char*>(&head), sizeof(head));
+
+    const size_t pointBytes = valueSize(m_format) * m_dimension;
+    const uInteger totalPoints = m_numReplicates * m_numPoints;
+    std::vector<char> buffer(std::min(m_blockSize, totalPoints) * pointBytes);
+    for(uInteger first = 0; first < totalPoints; first += m_blockSize)
+    {
+        const uInteger count = std::min(m_blockSize, totalPoints - first);
+        generateBlock(buffer.data(), first, count);
+        file.write(buffer.data(), count * pointBytes);
+        if (!file)
+        {
+            throw std::runtime_error("Point file: cannot write " + m_filename + ".");
+        }
+    }
+}
+
+void PointFileWriter::writeMemoryMap(const BlockGenerator& generateBlock) const
+{
+#ifdef NETBUILDER_POINT_FILE_MMAP
+    const size_t pointBytes = valueSize(m_format) * m_dimension;
+    const uInteger totalPoints = m_numReplicates * m_numPoints;
+    const size_t fileBytes = sizeof(PointFileHeader) + totalPoints * pointBytes;
+    const size_t pageBytes = (size_t) sysconf(_SC_PAGESIZE);
+
+    const int fd = open(m_filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Point file: cannot open " + m_filename + ": " + std::strerror(errno));
+    }
+    auto fail = [&](const std::string& what)
+    {
+        const int error = errno;
+        close(fd);
+        throw std::runtime_error("Point file: cannot " + what + " " + m_filename + ": " + std::strerror(error));
+    };
+
+    if (ftruncate(fd, (off_t) fileBytes) != 0)
+    {
+        fail("resize");
+    }
+    const PointFileHeader head = header();
+    if (pwrite(fd, &head, sizeof(head), 0) != (ssize_t) sizeof(head))
+    {
+        fail("write");
+    }
+
+    // each block is mapped on its own, so that only one block is resident at a time
+    for(uInteger first = 0; first < totalPoints; first += m_blockSize)
+    {
+        const uInteger count = std::min(m_blockSize, totalPoints - first);
+        const size_t offset = sizeof(PointFileHeader) + first * pointBytes;
+        const size_t mapOffset = offset - offset % pageBytes;
+        const size_t mapBytes = offset - mapOffset + count * pointBytes;
+        void* data = mmap(nullptr, mapBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, (off_t) mapOffset);
+        if (data == MAP_FAILED)
+        {
+            fail("map");
+        }
+        try
+        {
+            generateBlock(static_cast<char*>(data) + (offset - mapOffset), first, count);
+        }
+        catch(...)
+        {
+            munmap(data, mapBytes);
+            close(fd);
+            throw;
+        }
+        munmap(data, mapBytes);
+    }
+    close(fd);
+#else
+    writeStream(generateBlock);
+#endif
+}
+
+}
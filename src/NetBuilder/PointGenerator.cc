@@ -0,0 +1,249 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "netbuilder/PointGenerator.h"
+#include "netbuilder/PackedGeneratingMatrix.h"
+
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace NetBuilder {
+
+namespace {
+
+    // the columns of the generating matrices are stored in words of type unsigned long
+    void checkNumBits(unsigned int nBits)
+    {
+        if (nBits > (unsigned int) std::numeric_limits<unsigned long>::digits)
+        {
+            throw std::runtime_error("Point generator: the generating matrices have more rows than the number of bits of their columns.");
+        }
+    }
+
+    std::vector<std::vector<unsigned long>> columnsOf(const AbstractDigitalNet& net, unsigned int nRows)
+    {
+        checkNumBits((nRows == 0) ? net.numRows() : nRows); // before the columns are extracted
+        if (nRows != 0)
+        {
+            return net.generatingMatricesColumns(nRows);
+        }
+        std::vector<std::vector<unsigned long>> columns;
+        columns.reserve(net.dimension());
+        for(Dimension coord = 0; coord < net.dimension(); ++coord)
+        {
+            columns.push_back(net.generatingMatrix(coord).getColsReverse());
+        }
+        return columns;
+    }
+}
+
+PointGenerator::PointGenerator(const AbstractDigitalNet& net, unsigned int interlacingFactor, unsigned int nRows):
+    PointGenerator((nRows == 0) ? net.numRows() : nRows, columnsOf(net, nRows), interlacingFactor)
+{}
+
+PointGenerator::PointGenerator(unsigned int nBits, const std::vector<std::vector<unsigned long>>& columns, unsigned int interlacingFactor):
+    m_dimension(0),
+    m_interlacingFactor(interlacingFactor),
+    m_nCols(0),
+    m_numPoints(1)
+{
+    init(nBits, columns);
+}
+
+void PointGenerator::init(unsigned int nBits, const std::vector<std::vector<unsigned long>>& columns)
+{
+    const unsigned int digitsPerWord = std::numeric_limits<Digits>::digits;
+    checkNumBits(nBits);
+    if (m_interlacingFactor == 0 || columns.size() % m_interlacingFactor != 0)
+    {
+        throw std::runtime_error("Point generator: the number of components must be a multiple of the interlacing factor.");
+    }
+    m_dimension = columns.size() / m_interlacingFactor;
+    m_nCols = columns.empty() ? 0 : (unsigned int) columns[0].size();
+    if (m_nCols >= (unsigned int) std::numeric_limits<uInteger>::digits)
+    {
+        throw std::runtime_error("Point generator: too many columns in the generating matrices.");
+    }
+    m_numPoints = uInteger(1) << m_nCols;
+
+    m_directions.assign(m_nCols * m_dimension, 0);
+    for(Dimension component = 0; component < columns.size(); ++component)
+    {
+        if (columns[component].size() != m_nCols)
+        {
+            throw std::runtime_error("Point generator: the generating matrices must have the same number of columns.");
+        }
+        const Dimension coord = component / m_interlacingFactor;
+        const unsigned int shift = component % m_interlacingFactor;
+        for(unsigned int c = 0; c < m_nCols; ++c)
+        {
+            Digits& direction = m_directions[c * m_dimension + coord];
+            for(unsigned int row = 0; row < nBits; ++row)
+            {
+                const unsigned int digit = row * m_interlacingFactor + shift; // position of the digit in the coordinate
+                if (digit >= digitsPerWord)
+                {
+                    break;
+                }
+                if ((columns[component][c] >> (nBits - 1 - row)) & 1)
+                {
+                    direction |= Digits(1) << (digitsPerWord - 1 - digit);
+                }
+            }
+        }
+    }
+}
+
+void PointGenerator::checkRange(uInteger first, uInteger count) const
+{
+    if (first > m_numPoints || count > m_numPoints - first)
+    {
+        throw std::runtime_error("Point generator: the positions of the points are out of range.");
+    }
+}
+
+void PointGenerator::initialDigits(Digits* point, uInteger position) const
+{
+    std::fill(point, point + m_dimension, 0);
+    const uInteger gray = position ^ (position >> 1);
+    for(unsigned int c = 0; c < m_nCols; ++c)
+    {
+        if ((gray >> c) & 1)
+        {
+            const Digits* direction = &m_directions[c * m_dimension];
+            for(Dimension j = 0; j < m_dimension; ++j)
+            {
+                point[j] ^= direction[j];
+            }
+        }
+    }
+}
+
+template <typename T, typename CONVERT>
+void PointGenerator::enumerate(T* points, uInteger first, uInteger count, CONVERT convert) const
+{
+    checkRange(first, count);
+    if (count == 0)
+    {
+        return;
+    }
+    std::vector<Digits> point(m_dimension);
+    initialDigits(point.data(), first);
+    for(uInteger i = first; ; ++i)
+    {
+        for(Dimension j = 0; j < m_dimension; ++j)
+        {
+            *points++ = convert(point[j]);
+        }
+        if (i + 1 == first + count)
+        {
+            break;
+        }
+        // the next point differs from the current one by the column of the lowest set bit of its position
+        const Digits* direction = &m_directions[PackedGeneratingMatrix::lowestBit(i + 1) * m_dimension];
+        for(Dimension j = 0; j < m_dimension; ++j)
+        {
+            point[j] ^= direction[j];
+        }
+    }
+}
+
+void PointGenerator::generateDigits(Digits* digits, uInteger first, uInteger count) const
+{
+    enumerate(digits, first, count, [](Digits x) { return x; });
+}
+
+void PointGenerator::generateDigits(uint32_t* digits, uInteger first, uInteger count) const
+{
+    enumerate(digits, first, count, [](Digits x) { return (uint32_t) (x >> 32); });
+}
+
+void PointGenerator::generate(Real* points, uInteger first, uInteger count) const
+{
+    enumerate(points, first, count, &PointGenerator::toReal);
+}
+
+void PointGenerator::generate(float* points, uInteger first, uInteger count) const
+{
+    enumerate(points, first, count, &PointGenerator::toFloat);
+}
+
+void PointGenerator::generate(PointFormat format, void* points, uInteger first, uInteger count) const
+{
+    switch (format)
+    {
+        case PointFormat::FLOAT64: generate(static_cast<Real*>(points), first, count); return;
+        case PointFormat::FLOAT32: generate(static_cast<float*>(points), first, count); return;
+        case PointFormat::UINT32: generateDigits(static_cast<uint32_t*>(points), first, count); return;
+        case PointFormat::UINT64: generateDigits(static_cast<Digits*>(points), first, count); return;
+    }
+}
+
+void PointGenerator::generate(PointFormat format, void* points, uInteger first, uInteger count, unsigned int nThreads) const
+{
+    nThreads = (unsigned int) std::max<uInteger>(1, std::min<uInteger>(nThreads, count));
+    const uInteger blockSize = (count + nThreads - 1) / nThreads;
+    const size_t pointBytes = PointFileWriter::valueSize(format) * m_dimension;
+
+    std::vector<std::exception_ptr> errors(nThreads);
+    auto work = [&](unsigned int t)
+    {
+        try
+        {
+            const uInteger begin = std::min(t * blockSize, count);
+            const uInteger end = std::min(begin + blockSize, count);
+            generate(format, static_cast<char*>(points) + begin * pointBytes, first + begin, end - begin);
+        }
+        catch(...)
+        {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(unsigned int t = 1; t < nThreads; ++t)
+    {
+        threads.emplace_back(work, t);
+    }
+    work(0);
+    for(auto& thread : threads)
+    {
+        thread.join();
+    }
+    for(const auto& error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+void PointGenerator::generate(Real* points, unsigned int nThreads) const
+{
+    generate(PointFormat::FLOAT64, points, 0, m_numPoints, nThreads);
+}
+
+void PointGenerator::generateToFile(const std::string& filename, PointFormat format, bool useMemoryMap, unsigned int nThreads) const
+{
+    PointFileWriter writer(filename, format, PointOrder::GRAY_CODE, m_numPoints, m_dimension, 0, useMemoryMap);
+    writer.write([&](void* points, uInteger first, uInteger count) { generate(format, points, first, count, nThreads); });
+}
+
+}
@@ -0,0 +1,340 @@
+// This file is part of LatNet Builder.
+//
+// Copyright (C) 2012-2021  The LatNet Builder author's, supervised by Pierre L'Ecuyer, Universite de Montreal.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "netbuilder/RandomizedPointGenerator.h"
+#include "netbuilder/GeneratingMatrix.h"
+
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace NetBuilder {
+
+namespace {
+
+    constexpr unsigned int digitsPerWord = std::numeric_limits<RandomizedPointGenerator::Digits>::digits;
+
+    // number of points randomized at once, so that the buffers fit in the cache
+    constexpr uInteger chunkSize = 1024;
+
+    // number of coordinates scrambled at once by the nested uniform scramble
+    constexpr unsigned int scramblingLanes = 8;
+
+    /** Bijective 64-bit mixing function (finalizer of SplitMix64). */
+    inline uint64_t mix(uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+}
+
+constexpr unsigned int RandomizedPointGenerator::s_nRows;
+
+RandomizedPointGenerator::Replicate::Replicate(PointGenerator points, std::vector<Digits> shift, std::vector<uint64_t> scramblingSeeds, unsigned int scramblingDepth):
+    m_points(std::move(points)),
+    m_shift(std::move(shift)),
+    m_scramblingSeeds(std::move(scramblingSeeds)),
+    m_scramblingDepth(scramblingDepth)
+{}
+
+void RandomizedPointGenerator::Replicate::randomize(Digits* digits, uInteger count) const
+{
+    const Dimension dim = dimension();
+    const uInteger size = count * dim;
+    if (!m_shift.empty())
+    {
+        for(uInteger i = 0; i < size; i += dim)
+        {
+            for(Dimension j = 0; j < dim; ++j)
+            {
+                digits[i + j] ^= m_shift[j];
+            }
+        }
+    }
+    if (!m_scramblingSeeds.empty())
+    {
+        // The hash of the first k digits of a coordinate is updated with digit k. The coordinates are processed by groups
+        // of scramblingLanes, digit after digit, so that the hash chains of a group are independent from one another.
+        for(uInteger v0 = 0; v0 < size; v0 += scramblingLanes)
+        {
+            const unsigned int lanes = (unsigned int) std::min<uInteger>(scramblingLanes, size - v0);
+            Digits x[scramblingLanes] = {};
+            uint64_t state[scramblingLanes];
+            Digits flips[scramblingLanes] = {};
+            for(unsigned int l = 0; l < scramblingLanes; ++l)
+            {
+                if (l < lanes)
+                {
+                    x[l] = digits[v0 + l];
+                }
+                state[l] = m_scramblingSeeds[(v0 + l) % dim];
+            }
+            for(unsigned int k = 0; k < m_scramblingDepth; ++k)
+            {
+                const unsigned int bit = digitsPerWord - 1 - k;
+                for(unsigned int l = 0; l < scramblingLanes; ++l)
+                {
+                    flips[l] |= (state[l] >> (digitsPerWord - 1)) << bit;
+                    state[l] = mix(state[l] ^ (((x[l] >> bit) & 1) ? 0x9e3779b97f4a7c15ULL : 0x3c6ef372fe94f82aULL));
+                }
+            }
+            if (m_scramblingDepth < digitsPerWord)
+            {
+                for(unsigned int l = 0; l < scramblingLanes; ++l)
+                {
+                    flips[l] |= mix(state[l]) >> m_scramblingDepth;
+                }
+            }
+            for(unsigned int l = 0; l < lanes; ++l)
+            {
+                digits[v0 + l] = x[l] ^ flips[l];
+            }
+        }
+    }
+}
+
+void RandomizedPointGenerator::Replicate::generateDigits(Digits* digits, uInteger first, uInteger count) const
+{
+    m_points.generateDigits(digits, first, count);
+    for(uInteger i = 0; i < count; i += chunkSize)
+    {
+        randomize(digits + i * dimension(), std::min(chunkSize, count - i));
+    }
+}
+
+void RandomizedPointGenerator::Replicate::generate(PointFormat format, void* points, uInteger first, uInteger count) const
+{
+    if (format == PointFormat::UINT64)
+    {
+        generateDigits(static_cast<Digits*>(points), first, count);
+        return;
+    }
+    const Dimension dim = dimension();
+    std::vector<Digits> buffer(std::min(chunkSize, count) * dim);
+    for(uInteger i = 0; i < count; i += chunkSize)
+    {
+        const uInteger chunk = std::min(chunkSize, count - i);
+        generateDigits(buffer.data(), first + i, chunk);
+        const uInteger offset = i * dim;
+        const uInteger size = chunk * dim;
+        switch (format)
+        {
+            case PointFormat::FLOAT64:
+                std::transform(buffer.begin(), buffer.begin() + size, static_cast<Real*>(points) + offset, &PointGenerator::toReal);
+                break;
+            case PointFormat::FLOAT32:
+                std::transform(buffer.begin(), buffer.begin() + size, static_cast<float*>(points) + offset, &PointGenerator::toFloat);
+                break;
+            case PointFormat::UINT32:
+                std::transform(buffer.begin(), buffer.begin() + size, static_cast<uint32_t*>(points) + offset, [](Digits x) { return (uint32_t) (x >> 32); });
+                break;
+            case PointFormat::UINT64:
+                break;
+        }
+    }
+}
+
+RandomizedPointGenerator::RandomizedPointGenerator(const AbstractDigitalNet& net, Randomization randomization, unsigned int interlacingFactor,
+                                                   LatBuilder::LFSR258::seed_type seed, unsigned int scramblingDepth):
+    m_randomization(randomization),
+    m_interlacingFactor(interlacingFactor),
+    m_nCols(net.numColumns()),
+    m_scramblingDepth(scramblingDepth),
+    m_seed(std::move(seed)),
+    m_columns(net.generatingMatricesColumns(s_nRows))
+{
+    if (m_randomization == Randomization::RANDOM_SHIFT)
+    {
+        throw std::runtime_error("Randomized point generator: random shifts modulo 1 apply to ordinary lattices, use a digital shift for digital nets.");
+    }
+    if (m_interlacingFactor == 0 || m_columns.size() % m_interlacingFactor != 0)
+    {
+        throw std::runtime_error("Randomized point generator: the number of components must be a multiple of the interlacing factor.");
+    }
+    if (m_nCols >= (unsigned int) std::numeric_limits<uInteger>::digits)
+    {
+        throw std::runtime_error("Randomized point generator: too many columns in the generating matrices.");
+    }
+    if (m_scramblingDepth == 0)
+    {
+        m_scramblingDepth = std::min(digitsPerWord, m_nCols * m_interlacingFactor);
+    }
+    if (m_scramblingDepth > digitsPerWord)
+    {
+        throw std::runtime_error("Randomized point generator: the scrambling depth cannot exceed 64 digits.");
+    }
+}
+
+LatBuilder::LFSR258::seed_type RandomizedPointGenerator::seedFromInteger(uint64_t seed)
+{
+    // smallest valid values of the components of the seed of LFSR258
+    const LatBuilder::LFSR258::seed_type lowerBounds = {{2, 512, 4096, 131072, 8388608}};
+    LatBuilder::LFSR258::seed_type res;
+    for(unsigned int k = 0; k < res.size(); ++k)
+    {
+        seed += 0x9e3779b97f4a7c15ULL;
+        res[k] = mix(seed);
+        if (res[k] < lowerBounds[k])
+        {
+            res[k] += lowerBounds[k];
+        }
+    }
+    return res;
+}
+
+auto RandomizedPointGenerator::draw(LatBuilder::LFSR258 randomGen) const -> Replicate
+{
+    const bool lms = (m_randomization == Randomization::LMS || m_randomization == Randomization::LMS_DIGITAL_SHIFT);
+    const bool shift = (m_randomization == Randomization::DIGITAL_SHIFT || m_randomization == Randomization::LMS_DIGITAL_SHIFT);
+    const bool scrambling = (m_randomization == Randomization::NESTED_UNIFORM_SCRAMBLING);
+
+    std::vector<std::vector<unsigned long>> scrambledColumns;
+    if (lms)
+    {
+        // column c of LC is the sum of the columns of L selected by the rows of column c of C
+        scrambledColumns.reserve(m_columns.size());
+        for(const auto& columns : m_columns)
+        {
+            const std::vector<unsigned long> scramblingColumns = GeneratingMatrix::createRandomLowerTriangularMatrix(digitsPerWord, s_nRows, randomGen).getColsReverse();
+            std::vector<unsigned long> scrambled(m_nCols, 0);
+            for(unsigned int c = 0; c < m_nCols; ++c)
+            {
+                for(unsigned int row = 0; row < s_nRows; ++row)
+                {
+                    if ((columns[c] >> (s_nRows - 1 - row)) & 1)
+                    {
+                        scrambled[c] ^= scramblingColumns[row];
+                    }
+                }
+            }
+            scrambledColumns.push_back(std::move(scrambled));
+        }
+    }
+    PointGenerator points = lms ? PointGenerator(digitsPerWord, scrambledColumns, m_interlacingFactor) : PointGenerator(s_nRows, m_columns, m_interlacingFactor);
+
+    std::vector<Digits> shiftDigits;
+    std::vector<uint64_t> scramblingSeeds;
+    for(Dimension j = 0; j < dimension(); ++j)
+    {
+        if (shift)
+        {
+            shiftDigits.push_back(randomGen());
+        }
+        if (scrambling)
+        {
+            scramblingSeeds.push_back(randomGen());
+        }
+    }
+    return Replicate(std::move(points), std::move(shiftDigits), std::move(scramblingSeeds), m_scramblingDepth);
+}
+
+auto RandomizedPointGenerator::replicate(unsigned int replicate) const -> Replicate
+{
+    LatBuilder::LFSR258 randomGen(m_seed);
+    for(unsigned int r = 0; r < replicate; ++r)
+    {
+        randomGen.jump();
+    }
+    return draw(randomGen);
+}
+
+auto RandomizedPointGenerator::replicates(unsigned int firstReplicate, unsigned int numReplicates) const -> std::vector<Replicate>
+{
+    LatBuilder::LFSR258 randomGen(m_seed);
+    for(unsigned int r = 0; r < firstReplicate; ++r)
+    {
+        randomGen.jump();
+    }
+    std::vector<Replicate> res;
+    res.reserve(numReplicates);
+    for(unsigned int r = 0; r < numReplicates; ++r)
+    {
+        res.push_back(draw(randomGen));
+        randomGen.jump();
+    }
+    return res;
+}
+
+void RandomizedPointGenerator::generateBlock(const std::vector<Replicate>& replicates, PointFormat format, void* points, uInteger first, uInteger count, unsigned int nThreads) const
+{
+    const uInteger n = numPoints();
+    if (first > replicates.size() * n || count > replicates.size() * n - first)
+    {
+        throw std::runtime_error("Randomized point generator: the positions of the points are out of range.");
+    }
+    nThreads = (unsigned int) std::max<uInteger>(1, std::min<uInteger>(nThreads, count));
+    const uInteger blockSize = (count + nThreads - 1) / nThreads;
+    const size_t pointBytes = PointFileWriter::valueSize(format) * dimension();
+
+    std::vector<std::exception_ptr> errors(nThreads);
+    auto work = [&](unsigned int t)
+    {
+        try
+        {
+            const uInteger begin = std::min(t * blockSize, count);
+            const uInteger end = std::min(begin + blockSize, count);
+            // the block of the thread may span several replicates
+            for(uInteger i = begin; i < end; )
+            {
+                const uInteger r = (first + i) / n;
+                const uInteger position = (first + i) % n;
+                const uInteger size = std::min(end - i, n - position);
+                replicates[r].generate(format, static_cast<char*>(points) + i * pointBytes, position, size);
+                i += size;
+            }
+        }
+        catch(...)
+        {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(unsigned int t = 1; t < nThreads; ++t)
+    {
+        threads.emplace_back(work, t);
+    }
+    work(0);
+    for(auto& thread : threads)
+    {
+        thread.join();
+    }
+    for(const auto& error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+void RandomizedPointGenerator::generateReplicates(PointFormat format, void* points, unsigned int firstReplicate, unsigned int numReplicates, unsigned int nThreads) const
+{
+    const std::vector<Replicate> reps = replicates(firstReplicate, numReplicates);
+    generateBlock(reps, format, points, 0, numReplicates * numPoints(), nThreads);
+}
+
+void RandomizedPointGenerator::generateToFile(const std::string& filename, unsigned int numReplicates, PointFormat format, bool useMemoryMap, unsigned int nThreads) const
+{
+    const std::vector<Replicate> reps = replicates(0, numReplicates);
+    PointFileWriter writer(filename, format, PointOrder::GRAY_CODE, numPoints(), dimension(), 0, useMemoryMap, numReplicates);
+    writer.write([&](void* points, uInteger first, uInteger count) { generateBlock(reps, format, points, first, count, nThreads); });
+}
+
+}
@@ -18,148 +18,221 @@
 
 #include <algorithm>
 #include <iterator>
+#include <stdexcept>
 
 namespace NetBuilder{
 
-    RankComputer::RankComputer(unsigned int nCols)
+namespace {
+
+    inline bool testBit(const GeneratingMatrix::Row& row, unsigned int j) { return row[j]; }
+    inline bool testBit(const PackedGeneratingMatrix::Row& row, unsigned int j) { return (row >> j) & 1; }
+
+    inline void assignBit(GeneratingMatrix::Row& row, unsigned int j, bool value) { row.set(j, value); }
+    inline void assignBit(PackedGeneratingMatrix::Row& row, unsigned int j, bool value)
+    {
+        row = value ? (row | (PackedGeneratingMatrix::Row(1) << j)) : (row & ~(PackedGeneratingMatrix::Row(1) << j));
+    }
+
+    // sets the mask to n bits all equal to one
+    inline void setMask(GeneratingMatrix::Row& mask, unsigned int n) { mask.clear(); mask.resize(n, true); }
+    inline void setMask(PackedGeneratingMatrix::Row& mask, unsigned int n) { mask = PackedGeneratingMatrix::mask(n); }
+
+    // appends a bit to a mask of n bits
+    inline void appendBit(GeneratingMatrix::Row& mask, unsigned int n, bool value) { mask.resize(n + 1, value); }
+    inline void appendBit(PackedGeneratingMatrix::Row& mask, unsigned int n, bool value) { assignBit(mask, n, value); }
+
+    // index of the lowest bit j >= from such that row[j] == 1 and mask[j] == inMask, or notFound if there is none
+    inline unsigned int findFirst(const GeneratingMatrix::Row& row, const GeneratingMatrix::Row& mask, bool inMask, unsigned int from, unsigned int notFound)
+    {
+        for(auto j = (from == 0) ? row.find_first() : row.find_next(from - 1); j != GeneratingMatrix::Row::npos; j = row.find_next(j))
+        {
+            if (mask[j] == inMask)
+            {
+                return (unsigned int) j;
+            }
+        }
+        return notFound;
+    }
+    inline unsigned int findFirst(const PackedGeneratingMatrix::Row& row, const PackedGeneratingMatrix::Row& mask, bool inMask, unsigned int from, unsigned int notFound)
+    {
+        if (from >= PackedGeneratingMatrix::maxNumCols)
+        {
+            return notFound;
+        }
+        PackedGeneratingMatrix::Row bits = (inMask ? (row & mask) : (row & ~mask)) & (~PackedGeneratingMatrix::Row(0) << from);
+        return bits ? PackedGeneratingMatrix::lowestBit(bits) : notFound;
+    }
+
+}
+
+    template <typename MATRIX>
+    constexpr unsigned int BasicRankComputer<MATRIX>::noPivot;
+
+    template <typename MATRIX>
+    BasicRankComputer<MATRIX>::BasicRankComputer(unsigned int nCols)
     {
         reset(nCols);
     };
 
-    void RankComputer::reset(unsigned int nCols)  
+    template <typename MATRIX>
+    void BasicRankComputer<MATRIX>::reset(unsigned int nCols)  
     {
         m_nCols = nCols;
         m_nRows = 0;
         m_smallestFullRank = nCols;
-        m_redMat = GeneratingMatrix(0, m_nCols);
+        m_redMat = MATRIX(0, m_nCols);
         #ifdef DEBUG_ROW_REDUCER
-        m_baseMatrix = GeneratingMatrix(0, m_nCols);
+        m_baseMatrix = MATRIX(0, m_nCols);
         #endif
-        m_columnsWithoutPivot.clear();
-        for(unsigned int j = 0; j < nCols; ++j)
-        {
-            m_columnsWithoutPivot.insert(m_columnsWithoutPivot.end(), j);
-        }
-        m_rowsWithoutPivot.clear();
-        m_pivotsColRowPositions.clear();
-        m_pivotsRowColPositions.clear();
+        m_rank = 0;
+        setMask(m_columnsWithoutPivot, nCols);
+        m_pivotRowOfColumn.assign(nCols, noPivot);
+        m_pivotColumnOfRow.clear();
         m_rowOperations.resize(0,m_nCols);
     }
 
-    unsigned int RankComputer::computeRank() const
+    template <typename MATRIX>
+    unsigned int BasicRankComputer<MATRIX>::computeRank() const
     {
-        return (unsigned int) m_pivotsColRowPositions.size();
+        return m_rank;
     }
 
-    std::vector<unsigned int> RankComputer::computeRanks(unsigned int firstCol, unsigned int numCol) const
+    template <typename MATRIX>
+    std::vector<unsigned int> BasicRankComputer<MATRIX>::computeRanks(unsigned int firstCol, unsigned int numCol) const
     {
         unsigned int rank = 0;
-        std::vector<unsigned int> ranks(numCol, rank);
-        unsigned int lastCol = firstCol;
+        std::vector<unsigned int> ranks(numCol);
 
-        for(const auto& colRow : m_pivotsColRowPositions)
+        for(unsigned int col = 0; col < std::min(firstCol, m_nCols); ++col)
         {
-            if(colRow.first >= firstCol+numCol)
-            {
-                break;
-            }
-
-            for(unsigned int col = lastCol; col < colRow.first ; ++col)
-            {
-                ranks[col-firstCol] = rank;
-            }
-
-            rank+=1;
-
-            if (colRow.first >= firstCol)
-            {
-                lastCol = colRow.first;
-            }
+            rank += (m_pivotRowOfColumn[col] != noPivot);
         }
 
-        for(unsigned int col = lastCol; col < firstCol + numCol; ++col)
+        for(unsigned int col = firstCol; col < firstCol + numCol; ++col)
         {
+            if (col < m_nCols && m_pivotRowOfColumn[col] != noPivot)
+            {
+                rank+=1;
+            }
             ranks[col-firstCol] = rank;
         }
 
         return ranks;
     }
 
-    unsigned int RankComputer::pivotRowAndFindNewPivot(unsigned int rowIndex)
+    template <typename MATRIX>
+    std::map<unsigned int, unsigned int> BasicRankComputer<MATRIX>::getPivots() const
     {
-
-        for( const auto& colRowPivot : m_pivotsColRowPositions)
+        std::map<unsigned int, unsigned int> pivots;
+        for(unsigned int row = 0; row < m_nRows; ++row)
         {
-            
-            if (m_redMat(rowIndex,colRowPivot.first)) // if required, use the pivot to flip this bit
+            if (m_pivotColumnOfRow[row] != noPivot)
             {
-                m_rowOperations[rowIndex] = m_rowOperations[rowIndex] ^ m_rowOperations[colRowPivot.second];
-                m_redMat[rowIndex] = m_redMat[rowIndex] ^ m_redMat[colRowPivot.second];
+                pivots.emplace_hint(pivots.end(), row, m_pivotColumnOfRow[row]);
             }
         }
+        return pivots;
+    }
+
+    template <typename MATRIX>
+    unsigned int BasicRankComputer<MATRIX>::findNewPivot(unsigned int rowIndex)
+    {
+        unsigned int newPivotColPosition = findFirst(m_redMat[rowIndex], m_columnsWithoutPivot, true, 0, m_nCols);
+
+        if (newPivotColPosition < m_nCols) // if such a pivot exists
+        {
+            assignBit(m_columnsWithoutPivot, newPivotColPosition, false); // this column will have a pivot
+            m_pivotRowOfColumn[newPivotColPosition] = rowIndex;
+            m_pivotColumnOfRow[rowIndex] = newPivotColPosition;
+            ++m_rank;
+        }
+        return newPivotColPosition;
+    }
 
-        unsigned int newPivotColPosition = m_nCols;
-        for(std::set<unsigned int>::iterator it = m_columnsWithoutPivot.begin(); it != m_columnsWithoutPivot.end(); ++it)
+    template <typename MATRIX>
+    unsigned int BasicRankComputer<MATRIX>::pivotRowAndFindNewPivot(unsigned int rowIndex)
+    {
+        // the pivot rows vanish on the other pivot columns: flipping a bit does not affect the other pivot columns
+        for(unsigned int col = findFirst(m_redMat[rowIndex], m_columnsWithoutPivot, false, 0, m_nCols); col < m_nCols; col = findFirst(m_redMat[rowIndex], m_columnsWithoutPivot, false, col + 1, m_nCols))
         {
-            if(m_redMat(rowIndex, *it))
-            {
-                newPivotColPosition = *it;
-                m_columnsWithoutPivot.erase(it); // this column will have a pivot
-                break;
-            }
+            const unsigned int pivotRow = m_pivotRowOfColumn[col]; // use the pivot to flip this bit
+            m_rowOperations[rowIndex] ^= m_rowOperations[pivotRow];
+            m_redMat[rowIndex] ^= m_redMat[pivotRow];
         }
 
+        unsigned int newPivotColPosition = findNewPivot(rowIndex);
+
         if (newPivotColPosition < m_nCols) // if such a pivot exists
         {
-            
-            m_pivotsColRowPositions[newPivotColPosition] = rowIndex;
-            m_pivotsRowColPositions[rowIndex] = newPivotColPosition;
             for(unsigned int i = 0; i < m_nRows; ++i) // for each rowIndex above the inserted rowIndex
             {
                 if(i != rowIndex && m_redMat(i, newPivotColPosition)) // if required, use the rowIndex to flip this bit
                 {
-                    m_redMat[i] = m_redMat[i] ^ m_redMat[rowIndex];
-                    m_rowOperations[i] = m_rowOperations[i] ^ m_rowOperations[rowIndex];
+                    m_redMat[i] ^= m_redMat[rowIndex];
+                    m_rowOperations[i] ^= m_rowOperations[rowIndex];
                 }
             }
-            
-        }
-        else // if not
-        {
-            m_rowsWithoutPivot.push_back(rowIndex);
         }
         return newPivotColPosition;
     }
 
 
-    void RankComputer::addRow(GeneratingMatrix newRow)
+    template <typename MATRIX>
+    void BasicRankComputer<MATRIX>::addRow(MATRIX newRow)
+    {
+        addRow(newRow[0]);
+    }
+
+    template <typename MATRIX>
+    void BasicRankComputer<MATRIX>::addRow(const Row& newRow)
     {
         unsigned int row = m_nRows;
         ++m_nRows;
         m_rowOperations.resize(m_nRows, m_nRows);
         m_rowOperations.flip(row,row);
+        m_pivotColumnOfRow.push_back(noPivot);
 
+        m_redMat.resize(m_nRows, m_nCols);
+        m_redMat[row] = newRow;
         #ifdef DEBUG_ROW_REDUCER
-        m_baseMatrix.stackBelow(newRow);
-        m_redMat.stackBelow(newRow);
-        #else
-        m_redMat.stackBelow(std::move(newRow));
+        m_baseMatrix.resize(m_nRows, m_nCols);
+        m_baseMatrix[row] = newRow;
         #endif
 
         pivotRowAndFindNewPivot(row);
 
-        if (m_pivotsColRowPositions.size() < m_nRows)
+        updateSmallestFullRankAfterAddition();
+    }
+
+    template <typename MATRIX>
+    void BasicRankComputer<MATRIX>::addRows(const MATRIX& block)
+    {
+        for(unsigned int i = 0; i < block.nRows(); ++i)
+        {
+            addRow(block[i]);
+        }
+    }
+
+    template <typename MATRIX>
+    void BasicRankComputer<MATRIX>::updateSmallestFullRankAfterAddition()
+    {
+        if (m_rank < m_nRows)
         {
             m_smallestFullRank = m_nCols + 1;
         }
         else
         {
-            m_smallestFullRank = (*std::max_element(m_pivotsColRowPositions.begin(), m_pivotsColRowPositions.end())).first + 1;
+            unsigned int lastPivotCol = m_nCols;
+            while (lastPivotCol > 0 && m_pivotRowOfColumn[lastPivotCol - 1] == noPivot)
+            {
+                --lastPivotCol;
+            }
+            m_smallestFullRank = lastPivotCol;
         }
-
     }
 
-    void RankComputer::addColumn(GeneratingMatrix newCol)
+    template <typename MATRIX>
+    void BasicRankComputer<MATRIX>::addColumn(MATRIX newCol)
     {
         newCol = m_rowOperations * newCol; // apply the row operations to the new column
         m_redMat.stackRight(newCol); // stack right the new column
@@ -172,43 +245,50 @@ namespace NetBuilder{
         ++m_nCols;
 
         unsigned int newPivotRowPosition = m_nRows;
-        for(std::list<unsigned int>::iterator it = m_rowsWithoutPivot.begin(); it != m_rowsWithoutPivot.end(); ++it)
+        for(unsigned int i = 0; i < m_nRows; ++i)
         {
-            if(m_redMat(*it,col))
+            if(m_pivotColumnOfRow[i] == noPivot && m_redMat(i,col))
             {
-                newPivotRowPosition = *it;
-                m_rowsWithoutPivot.erase(it); // this row will have a pivot
+                newPivotRowPosition = i; // this row will have a pivot
                 break;
             }
         }
 
         if(newPivotRowPosition < m_nRows)
         {
-            m_pivotsColRowPositions[col] = newPivotRowPosition;
-            m_pivotsRowColPositions[newPivotRowPosition] = col;
+            appendBit(m_columnsWithoutPivot, col, false);
+            m_pivotRowOfColumn.push_back(newPivotRowPosition);
+            m_pivotColumnOfRow[newPivotRowPosition] = col;
+            ++m_rank;
 
             for(unsigned int i = 0; i < m_nRows; ++i)
             {
                 if( i != newPivotRowPosition && m_redMat(i,col))
                 {
                     m_redMat.flip(i,col);
-                    m_rowOperations[i] = m_rowOperations[i] ^ m_rowOperations[newPivotRowPosition];
+                    m_rowOperations[i] ^= m_rowOperations[newPivotRowPosition];
                 }
             }
         }
         else
         {
-            m_columnsWithoutPivot.insert(col);
+            appendBit(m_columnsWithoutPivot, col, true);
+            m_pivotRowOfColumn.push_back(noPivot);
         }
     }
 
-    void RankComputer::replaceRow(unsigned int rowIndex, GeneratingMatrix&& newRow, int verbose)
+    template <typename MATRIX>
+    void BasicRankComputer<MATRIX>::replaceRow(unsigned int rowIndex, MATRIX&& newRow, int verbose)
     {
-        auto rowIndexColPivPos = m_pivotsRowColPositions.find(rowIndex);
+        replaceRow(rowIndex, newRow[0]);
+    }
 
-        if (rowIndexColPivPos != m_pivotsRowColPositions.end())
+    template <typename MATRIX>
+    void BasicRankComputer<MATRIX>::replaceRow(unsigned int rowIndex, const Row& newRow)
+    {
+        if (m_pivotColumnOfRow[rowIndex] != noPivot)
         {
-            unsigned int colPositionPivot = (*rowIndexColPivPos).second;
+            unsigned int colPositionPivot = m_pivotColumnOfRow[rowIndex];
             unsigned int firstRowToDepivot = 0;
             if (m_rowOperations(rowIndex, rowIndex) != 1){
                 for(unsigned int tmpIndex = 0; tmpIndex < m_nRows; ++tmpIndex)
@@ -217,18 +297,17 @@ namespace NetBuilder{
                         m_redMat.swapRows(tmpIndex, rowIndex);
                         m_rowOperations.swapRows(tmpIndex, rowIndex);
 
-                        auto tmpIndexPivPos = m_pivotsRowColPositions.find(tmpIndex);
-                        int tmpIndexColPivPos;
-                        if(tmpIndexPivPos != m_pivotsRowColPositions.end())
+                        unsigned int tmpIndexColPivPos = m_pivotColumnOfRow[tmpIndex];
+                        if(tmpIndexColPivPos != noPivot)
                         {
-                            tmpIndexColPivPos = (*tmpIndexPivPos).second;
-                            m_pivotsColRowPositions.erase(tmpIndexColPivPos);
-                            m_columnsWithoutPivot.insert(tmpIndexColPivPos);
+                            m_pivotRowOfColumn[tmpIndexColPivPos] = noPivot;
+                            assignBit(m_columnsWithoutPivot, tmpIndexColPivPos, true);
+                            --m_rank;
                         }
                         
-                        m_pivotsRowColPositions.erase(rowIndex);
-                        m_pivotsColRowPositions[colPositionPivot] = tmpIndex;
-                        m_pivotsRowColPositions[tmpIndex] = colPositionPivot;
+                        m_pivotColumnOfRow[rowIndex] = noPivot;
+                        m_pivotRowOfColumn[colPositionPivot] = tmpIndex;
+                        m_pivotColumnOfRow[tmpIndex] = colPositionPivot;
                         
                         firstRowToDepivot = tmpIndex+1;
                         break;
@@ -236,29 +315,28 @@ namespace NetBuilder{
                 }
             }
             else{
-                m_pivotsRowColPositions.erase(rowIndex);
-                m_pivotsColRowPositions.erase(colPositionPivot);
-                m_columnsWithoutPivot.insert(colPositionPivot);
+                m_pivotColumnOfRow[rowIndex] = noPivot;
+                m_pivotRowOfColumn[colPositionPivot] = noPivot;
+                assignBit(m_columnsWithoutPivot, colPositionPivot, true);
+                --m_rank;
             }
 
             for(unsigned int i = firstRowToDepivot; i < m_nRows; ++i)
             {
                 if(i!=rowIndex && m_rowOperations(i,rowIndex))
                 {
-                    m_redMat[i] = m_redMat[i] ^ m_redMat[rowIndex];
-                    m_rowOperations[i] = m_rowOperations[i] ^ m_rowOperations[rowIndex];
+                    m_redMat[i] ^= m_redMat[rowIndex];
+                    m_rowOperations[i] ^= m_rowOperations[rowIndex];
                 }
             }
         }
 
+        m_redMat[rowIndex] = newRow;
         #ifdef DEBUG_ROW_REDUCER
-        m_redMat[rowIndex] = newRow[0];
-        m_baseMatrix[rowIndex] = newRow[0];
-        #else
-        m_redMat[rowIndex] = std::move(newRow[0]);
+        m_baseMatrix[rowIndex] = newRow;
         #endif
 
-        m_rowOperations[rowIndex].reset();
+        m_rowOperations.resetRow(rowIndex);
         m_rowOperations(rowIndex, rowIndex) = 1;
 
         unsigned int newPivotPos = pivotRowAndFindNewPivot(rowIndex);
@@ -266,7 +344,60 @@ namespace NetBuilder{
         m_smallestFullRank = std::max(m_smallestFullRank, newPivotPos + 1);
     }
 
-    bool RankComputer::checkIfInvertible(GeneratingMatrix matrix)
+    template <typename MATRIX>
+    void BasicRankComputer<MATRIX>::flip(unsigned int rowIndex, unsigned int colIndex)
+    {
+        // the flip adds the column rowIndex of the row operations to the column colIndex of the reduced matrix:
+        // the affected rows are those whose operations involve the row rowIndex of the current matrix
+        // choose the affected row which absorbs the flip: a row without pivot if any (it is zero),
+        // otherwise the pivot row with the last pivot column (the other pivot rows do not depend on its non-pivot part)
+        unsigned int chosenRow = m_nRows;
+        for(unsigned int i = 0; i < m_nRows; ++i)
+        {
+            if(m_rowOperations(i, rowIndex))
+            {
+                if(m_pivotColumnOfRow[i] == noPivot)
+                {
+                    chosenRow = i;
+                    break;
+                }
+                if(chosenRow == m_nRows || m_pivotColumnOfRow[i] > m_pivotColumnOfRow[chosenRow])
+                {
+                    chosenRow = i;
+                }
+            }
+        }
+
+        // the other affected rows get the chosen row, which cancels the flip on them
+        for(unsigned int i = 0; i < m_nRows; ++i)
+        {
+            if(i != chosenRow && m_rowOperations(i, rowIndex))
+            {
+                m_redMat[i] ^= m_redMat[chosenRow];
+                m_rowOperations[i] ^= m_rowOperations[chosenRow];
+            }
+        }
+
+        const unsigned int colPositionPivot = m_pivotColumnOfRow[chosenRow];
+        if(colPositionPivot != noPivot)
+        {
+            m_pivotColumnOfRow[chosenRow] = noPivot;
+            m_pivotRowOfColumn[colPositionPivot] = noPivot;
+            assignBit(m_columnsWithoutPivot, colPositionPivot, true);
+            --m_rank;
+        }
+        m_redMat.flip(chosenRow, colIndex);
+        #ifdef DEBUG_ROW_REDUCER
+        m_baseMatrix.flip(rowIndex, colIndex);
+        #endif
+
+        pivotRowAndFindNewPivot(chosenRow);
+
+        updateSmallestFullRankAfterAddition();
+    }
+
+    template <typename MATRIX>
+    bool BasicRankComputer<MATRIX>::checkIfInvertible(MATRIX matrix)
     {
         int k = matrix.nRows();
         int m = matrix.nCols();
@@ -286,7 +417,7 @@ namespace NetBuilder{
         while (i_pivot < k && j < m-1){
             j++;
             int i_temp = i_pivot;
-            while (i_temp < k && matrix[i_temp][j] == 0){
+            while (i_temp < k && !matrix(i_temp, j)){
                 i_temp++;
             }
             if (i_temp >= k){  // pas d'element non nul sur la colonne
@@ -296,7 +427,7 @@ namespace NetBuilder{
 
             Pivots[i_pivot] = j;
             for (int i=i_pivot+1; i<k; i++){
-                if (matrix[i][j] != 0){
+                if (matrix(i, j)){
                     matrix[i] = matrix[i] ^ matrix[i_pivot];
                 }
             }
@@ -307,75 +438,57 @@ namespace NetBuilder{
     }
 
 #ifdef DEBUG_ROW_REDUCER
-void RankComputer::check(){
+template <typename MATRIX>
+void BasicRankComputer<MATRIX>::check(){
 
     if (!checkIfInvertible(m_rowOperations))
     {
-        throw std::runtime_error("Row operations matrix is not invertible.")
+        throw std::runtime_error("Row operations matrix is not invertible.");
     }
 
-    std::vector<bool> check_row (m_nRows, 0);
-    std::vector<bool> check_col (m_nCols, 0);
-
-    GeneratingMatrix prod = m_rowOperations * m_baseMatrix;
-    for (int i=0; i < m_nRows; i++){
-        for (int j=0; j < m_nCols; j++){
+    MATRIX prod = m_rowOperations * m_baseMatrix;
+    for (unsigned int i=0; i < m_nRows; i++){
+        for (unsigned int j=0; j < m_nCols; j++){
             if (prod(i, j) != m_redMat(i, j)){
                 throw std::runtime_error("The left-product of the base matrix by the row-operations matrix does not correspond to the reduced matrix.s");
             }
         }
     }
 
-    for (const auto& colRow : m_pivotsColRowPositions){
-        unsigned int col = colRow.first;
-        unsigned int row = colRow.second;
+    unsigned int rank = 0;
+    for (unsigned int col=0; col < m_nCols; col++){
+        unsigned int row = m_pivotRowOfColumn[col];
+        if (testBit(m_columnsWithoutPivot, col) != (row == noPivot)){
+            throw std::runtime_error("Columns without pivot mask and pivot positions are incompatible.");
+        }
+        if (row == noPivot){
+            continue;
+        }
+        ++rank;
+        if (m_pivotColumnOfRow[row] != col){
+            throw std::runtime_error("RowCol and ColRow positions are incompatible.");
+        }
         for (unsigned int i=0; i < m_nRows; i++){
             if (m_redMat(i, col) != (i == row)){
                 throw std::runtime_error("A column containing a pivot has not the good property.");
             }
         }
-        check_row[row] = 1;
-        check_col[col] = 1;
     }
 
-    for (const auto& rowCol : m_pivotsRowColPositions){
-        unsigned int row = rowCol.first;
-        unsigned int col = rowCol.second;
-        if (check_row[row] != 1 || check_col[col] != 1){
-            throw std::runtime_error("RowCol and ColRow maps are incompatible (1) .");
+    for (unsigned int row=0; row < m_nRows; row++){
+        unsigned int col = m_pivotColumnOfRow[row];
+        if (col != noPivot && m_pivotRowOfColumn[col] != row){
+            throw std::runtime_error("RowCol and ColRow positions are incompatible.");
         }
-        if (m_pivotsColRowPositions[col] != row){
-            throw std::runtime_error("RowCol and ColRow maps are incompatible (2) .");
-        }
-    }
-    if (m_pivotsColRowPositions.size() != m_pivotsRowColPositions.size()){
-        throw std::runtime_error("RowCol and ColRow maps are incompatible (3) .");
     }
 
-    for (const auto& col: m_columnsWithoutPivot){
-        if (check_col[col] != 0){
-            throw std::runtime_error("Column without pivot in pivot map.");
-        }
-        check_col[col] = 1;
-    }
-    for (const auto& row: m_rowsWithoutPivot){
-        if (check_row[row] != 0){
-            throw std::runtime_error("Row without pivot in pivot map.");
-        }
-        check_row[row] = 1;
-    }
-
-    for (const auto& r: check_row){
-        if(r != 1){
-            throw std::runtime_error("Duplicate or missing row.");
-        }
-    }
-    for (const auto& c : check_col){
-        if(c != 1){
-            throw std::runtime_error("Duplicate or missing column.");
-        }
+    if (rank != m_rank){
+        throw std::runtime_error("Wrong number of pivots.");
     }
 }
 #endif
 
+template class BasicRankComputer<GeneratingMatrix>;
+template class BasicRankComputer<PackedGeneratingMatrix>;
+
 }
@@ -18,59 +18,197 @@
 #include "netbuilder/Types.h"
 #include "netbuilder/Helpers/CompositionMaker.h"
 
-#include <list>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 namespace NetBuilder {
 
-int
-getmsb (unsigned long long x)
+namespace {
+
+typedef uint64_t Word;
+
+/**
+ * Rows of the generating matrices packed in machine words.
+ * Each row takes the same number of words and the rows of all the matrices are stored contiguously.
+ * The storage is kept when other matrices are assigned.
+ */
+class PackedRows
+{
+    public:
+        /** Packs the rows of \c matrices. */
+        void assign(const MatricesView<PackedGeneratingMatrix>& matrices)
+        {
+            m_nWords = 1;
+            m_nRows = matrices[0].nRows();
+            m_words.clear();
+            for (size_t coord = 0; coord < matrices.size(); ++coord)
+            {
+                const auto& mat = matrices[coord];
+                m_words.insert(m_words.end(), mat.data(), mat.data() + m_nRows);
+            }
+        }
+
+        /** Packs the rows of \c matrices. */
+        void assign(const MatricesView<GeneratingMatrix>& matrices)
+        {
+            m_nWords = (matrices[0].nCols() + 63) / 64;
+            m_nRows = matrices[0].nRows();
+            m_words.assign(matrices.size() * m_nRows * m_nWords, 0);
+            static_assert(GeneratingMatrix::Row::bits_per_block == 64, "generating matrix rows must be made of 64-bit blocks");
+            Word* it = m_words.data();
+            for (size_t coord = 0; coord < matrices.size(); ++coord)
+            {
+                const auto& mat = matrices[coord];
+                for (unsigned int i = 0; i < m_nRows; ++i, it += m_nWords)
+                {
+                    boost::to_block_range(mat[i], it);
+                }
+            }
+        }
+
+        /** Returns the number of words of each row. */
+        unsigned int nWords() const { return m_nWords; }
+
+        /** Returns a pointer to the words of row \c i of matrix \c coord. */
+        const Word* row(unsigned int coord, unsigned int i) const { return m_words.data() + (coord * m_nRows + i) * m_nWords; }
+
+    private:
+        unsigned int m_nWords; // number of words of each row
+        unsigned int m_nRows; // number of rows of each matrix
+        std::vector<Word> m_words; // words of the rows
+};
+
+/**
+ * XORs \c row into \c v and returns the index of the lowest non-zero bit of the result,
+ * or \c nWords times 64 if it is zero. If \c N_WORDS is non-zero, it is the number of words of the rows.
+ */
+template <unsigned int N_WORDS>
+inline unsigned int xorAndFindFirst(Word* v, const Word* row, unsigned int nWords)
 {
-    int r = 0;
-    if (x < 1) return 0;
-    while (x >>= 1) r++;
-    return r;
+    if (N_WORDS != 0)
+    {
+        nWords = N_WORDS;
+    }
+    unsigned int j = 0;
+    #ifdef __AVX2__
+    for (; j + 4 <= nWords; j += 4)
+    {
+        __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*) (v + j)), _mm256_loadu_si256((const __m256i*) (row + j)));
+        _mm256_storeu_si256((__m256i*) (v + j), x);
+    }
+    #endif
+    for (; j < nWords; ++j)
+    {
+        v[j] ^= row[j];
+    }
+    for (j = 0; j < nWords; ++j)
+    {
+        if (v[j])
+        {
+            return 64 * j + PackedGeneratingMatrix::lowestBit(v[j]);
+        }
+    }
+    return 64 * nWords;
 }
 
-typedef GeneratingMatrix GeneratingMatrix;
+/**
+ * Number of bits of the precomputed part of the flipping order.
+ */
+constexpr unsigned int flipTableBits = 16;
 
-unsigned int SchmidMethod::computeTValue(std::vector<GeneratingMatrix> matrices, unsigned int maxTValuesSubProj, int verbose=0)
+/**
+ * Returns the index of the bit which changes between the Gray codes of \c r and \c r + 1 for \c r smaller than
+ * \f$2^{16} - 1\f$, that is the number of trailing zeros of \c r + 1. The table is computed once.
+ */
+const std::vector<unsigned char>& flipTable()
 {
-    unsigned int m = matrices[0].nCols();
-    unsigned int s = (unsigned int)matrices.size();
+    static const std::vector<unsigned char> table = []()
+    {
+        std::vector<unsigned char> res((1u << flipTableBits) - 1);
+        for (unsigned int r = 0; r < res.size(); ++r)
+        {
+            res[r] = (unsigned char) PackedGeneratingMatrix::lowestBit(r + 1);
+        }
+        return res;
+    }();
+    return table;
+}
 
-    if (s==1){ return 0; } 
+/**
+ * Walks the \f$2^k - 1\f$ non-zero linear combinations of \c k rows in Gray code order: \c flip is called with the index
+ * of the row which changes at each step, and the walk stops as soon as it returns \c true.
+ * The flipping order of \f$2^k - 1\f$ steps is made of copies of the precomputed order of \f$2^{16} - 1\f$ steps separated by
+ * flips of rows with a larger index. Returns whether the walk was stopped.
+ */
+template <typename FLIP>
+inline bool walkGrayCode(unsigned int k, FLIP&& flip)
+{
+    const std::vector<unsigned char>& table = flipTable();
+    const unsigned int tableBits = std::min(k, flipTableBits);
+    const unsigned char* begin = table.data();
+    const unsigned char* end = begin + ((1u << tableBits) - 1);
+    const uint64_t nBlocks = uint64_t(1) << (k - tableBits);
+    for (uint64_t b = 1; ; ++b)
+    {
+        for (const unsigned char* it = begin; it != end; ++it)
+        {
+            if (flip(*it))
+            {
+                return true;
+            }
+        }
+        if (b == nBlocks)
+        {
+            return false;
+        }
+        if (flip(tableBits + PackedGeneratingMatrix::lowestBit(b)))
+        {
+            return true;
+        }
+    }
+}
 
-    uInteger upperLimit = (1<<(m-maxTValuesSubProj))-1;
-    std::vector<unsigned int> flipingOrder(upperLimit);
-    for(uInteger r = 0; r < upperLimit; ++r)
+/**
+ * Gathers the first rows of each matrix given by the composition.
+ */
+inline void gatherRows(const PackedRows& rows, const std::vector<unsigned int>& comp, std::vector<const Word*>& res)
+{
+    unsigned int idx = 0;
+    for (unsigned int coord = 0; coord < comp.size(); ++coord)
     {
-        flipingOrder[r] = getmsb(((r >> 1) ^ r)^(((r+1) >> 1) ^ (r+1)));
+        for (unsigned int j = 0; j < comp[coord]; ++j)
+        {
+            res[idx++] = rows.row(coord, j);
+        }
     }
+}
+
+template <unsigned int N_WORDS>
+unsigned int computeTValueImpl(const PackedRows& rows, unsigned int m, unsigned int s, unsigned int maxTValuesSubProj)
+{
+    const unsigned int nWords = rows.nWords();
+    const unsigned int notFound = 64 * nWords;
+    static thread_local std::vector<const Word*> tmp;
+    static thread_local std::vector<Word> v;
+    tmp.resize(m);
+    v.resize(nWords);
 
     for(unsigned int k = s ; k <= m-maxTValuesSubProj; ++k)
     {
         CompositionMaker compMaker(k,s);
         do
         { 
-            std::vector<unsigned int> comp = compMaker.currentComposition();
-            std::vector<GeneratingMatrix::Row*> tmp(k);
-            unsigned int idx = 0;
-            for(Dimension coord = 0; coord < s; ++coord)
-            {
-                for(unsigned int j = 0; j < comp[coord]; ++j)
-                {
-                    tmp[idx] = &(matrices[coord][j]);
-                    ++idx;
-                }
-            }
-            boost::dynamic_bitset<> v(m);
-            for(uInteger r = 0; r < (unsigned int) ((1 << k) - 1); ++r)
+            gatherRows(rows, compMaker.currentComposition(), tmp);
+            std::fill(v.begin(), v.end(), 0);
+            const bool dependent = walkGrayCode(k, [&](unsigned int flip) { return xorAndFindFirst<N_WORDS>(v.data(), tmp[flip], nWords) == notFound; });
+            if (dependent)
             {
-                v ^= *tmp[flipingOrder[r]];
-                if (v.none())
-                {
-                    return m-(k-1);
-                }
+                return m-(k-1);
             }
         }
         while(compMaker.goToNextComposition());
@@ -78,76 +216,44 @@ unsigned int SchmidMethod::computeTValue(std::vector<GeneratingMatrix> matrices,
     return maxTValuesSubProj;
 }
 
-std::vector<unsigned int> SchmidMethod::computeTValue(std::vector<GeneratingMatrix> matrices, const std::vector<unsigned int>& maxTValuesSubProj, int verbose=0)
+template <unsigned int N_WORDS>
+std::vector<unsigned int> computeTValueImpl(const PackedRows& rows, unsigned int m, unsigned int s, const std::vector<unsigned int>& maxTValuesSubProj)
 {
-    unsigned int m = matrices[0].nCols();
-    unsigned int s = (unsigned int)matrices.size();
-
-    if (s==1){ return std::vector<unsigned int>(m, 0); } 
+    const unsigned int nWords = rows.nWords();
+    static thread_local std::vector<const Word*> tmp;
+    static thread_local std::vector<Word> v;
+    tmp.resize(m);
+    v.resize(nWords);
 
-    uInteger upperLimit ;
     std::vector<unsigned int> res = maxTValuesSubProj;
 
-    upperLimit= (1<<(m-maxTValuesSubProj.back()))-1;
-
-    std::list<unsigned int> flipingOrder;
-    for(uInteger r = 0; r < upperLimit; ++r)
-    {
-        flipingOrder.push_back(getmsb(((r >> 1) ^ r)^(((r+1) >> 1) ^ (r+1))));
-    }
-
     unsigned int nextToCompute = s-1;
     for(unsigned int k = s ; k <= m-maxTValuesSubProj.back(); ++k)
     {
         CompositionMaker compMaker(k, s);
         do
         {
-            std::vector<unsigned int> comp = compMaker.currentComposition();
-            std::vector<GeneratingMatrix::Row*> tmp(k);
-            unsigned int idx = 0;
-            for(Dimension coord = 0; coord < s; ++coord)
-            {
-                for(unsigned int j = 0; j < comp[coord]; ++j)
-                {
-                    tmp[idx] = &(matrices[coord][j]);
-                    ++idx;
-                }
-            }
-
-            boost::dynamic_bitset<> v(m);
-            unsigned int r = 0;
-            unsigned int currentLimit = (unsigned int) ((1 << k) - 1);
-            for(unsigned int flip : flipingOrder)
+            gatherRows(rows, compMaker.currentComposition(), tmp);
+            std::fill(v.begin(), v.end(), 0);
+            const bool done = walkGrayCode(k, [&](unsigned int flip)
             {
-                v ^= *tmp[flip];
-
-                auto numberOfZeros = v.find_first();
-                
-                if (numberOfZeros == GeneratingMatrix::Row::npos)
-                {
-                    numberOfZeros = m;
-                }
+                unsigned int zeros = std::min(xorAndFindFirst<N_WORDS>(v.data(), tmp[flip], nWords), m);
 
-                for(unsigned int i = nextToCompute; i < numberOfZeros; ++i)
+                for(unsigned int i = nextToCompute; i < zeros; ++i)
                 {
                     res[i] = std::max(i+1-(k-1), res[i]);
                 }
 
-                if (nextToCompute < (unsigned int) numberOfZeros)
+                if (nextToCompute < zeros)
                 {
-                    nextToCompute = (unsigned int) numberOfZeros;
+                    nextToCompute = zeros;
                 }
 
-                if (nextToCompute == m)
-                {
-                    return res;
-                }
-
-                ++r;
-                if(r >= currentLimit)
-                {
-                    break;
-                }
+                return nextToCompute == m;
+            });
+            if (done)
+            {
+                return res;
             }
         }
         while(compMaker.goToNextComposition());
@@ -155,5 +261,81 @@ std::vector<unsigned int> SchmidMethod::computeTValue(std::vector<GeneratingMatr
     return res;
 }
 
+template <typename MATRIX>
+unsigned int computeTValueImpl(const MatricesView<MATRIX>& matrices, unsigned int maxTValuesSubProj)
+{
+    unsigned int m = matrices[0].nCols();
+    unsigned int s = (unsigned int)matrices.size();
+
+    if (s==1){ return 0; } 
+
+    static thread_local PackedRows rows;
+    rows.assign(matrices);
+    if (rows.nWords() == 1)
+    {
+        return computeTValueImpl<1>(rows, m, s, maxTValuesSubProj);
+    }
+    return computeTValueImpl<0>(rows, m, s, maxTValuesSubProj);
+}
+
+template <typename MATRIX>
+std::vector<unsigned int> computeTValueImpl(const MatricesView<MATRIX>& matrices, const std::vector<unsigned int>& maxTValuesSubProj)
+{
+    unsigned int m = matrices[0].nCols();
+    unsigned int s = (unsigned int)matrices.size();
+
+    if (s==1){ return std::vector<unsigned int>(m, 0); } 
+
+    static thread_local PackedRows rows;
+    rows.assign(matrices);
+    if (rows.nWords() == 1)
+    {
+        return computeTValueImpl<1>(rows, m, s, maxTValuesSubProj);
+    }
+    return computeTValueImpl<0>(rows, m, s, maxTValuesSubProj);
+}
+
+}
+
+unsigned int SchmidMethod::computeTValue(std::vector<GeneratingMatrix> matrices, unsigned int maxTValuesSubProj, int)
+{
+    return computeTValueImpl(MatricesView<GeneratingMatrix>(pointersTo(matrices)), maxTValuesSubProj);
+}
+
+std::vector<unsigned int> SchmidMethod::computeTValue(std::vector<GeneratingMatrix> matrices, const std::vector<unsigned int>& maxTValuesSubProj, int)
+{
+    return computeTValueImpl(MatricesView<GeneratingMatrix>(pointersTo(matrices)), maxTValuesSubProj);
+}
+
+unsigned int SchmidMethod::computeTValue(std::vector<PackedGeneratingMatrix> matrices, unsigned int maxTValuesSubProj, int)
+{
+    return computeTValueImpl(MatricesView<PackedGeneratingMatrix>(pointersTo(matrices)), maxTValuesSubProj);
+}
+
+std::vector<unsigned int> SchmidMethod::computeTValue(std::vector<PackedGeneratingMatrix> matrices, const std::vector<unsigned int>& maxTValuesSubProj, int)
+{
+    return computeTValueImpl(MatricesView<PackedGeneratingMatrix>(pointersTo(matrices)), maxTValuesSubProj);
+}
+
+unsigned int SchmidMethod::computeTValue(const MatricesView<GeneratingMatrix>& matrices, unsigned int maxTValuesSubProj, int)
+{
+    return computeTValueImpl(matrices, maxTValuesSubProj);
+}
+
+std::vector<unsigned int> SchmidMethod::computeTValue(const MatricesView<GeneratingMatrix>& matrices, const std::vector<unsigned int>& maxTValuesSubProj, int)
+{
+    return computeTValueImpl(matrices, maxTValuesSubProj);
+}
+
+unsigned int SchmidMethod::computeTValue(const MatricesView<PackedGeneratingMatrix>& matrices, unsigned int maxTValuesSubProj, int)
+{
+    return computeTValueImpl(matrices, maxTValuesSubProj);
+}
+
+std::vector<unsigned int> SchmidMethod::computeTValue(const MatricesView<PackedGeneratingMatrix>& matrices, const std::vector<unsigned int>& maxTValuesSubProj, int)
+{
+    return computeTValueImpl(matrices, maxTValuesSubProj);
+}
+
 
 }
\ No newline at end of file
@@ -29,6 +29,10 @@
 #include "netbuilder/Parser/EmbeddingTypeParser.h"
 #include "netbuilder/Parser/NetConstructionParser.h"
 #include "netbuilder/Parser/OutputStyleParser.h"
+#include "netbuilder/Parser/PointFormatParser.h"
+#include "netbuilder/Parser/RandomizationParser.h"
+#include "netbuilder/PointGenerator.h"
+#include "netbuilder/RandomizedPointGenerator.h"
 #include "netbuilder/Task/Task.h"
 
 #include "latbuilder/Parser/Common.h"
@@ -74,12 +78,12 @@ makeOptionsDescription()
    ("exploration-method,e", po::value<std::string>(),
     "(required) exploration method; possible values:\n"
     "  evaluation:<net_description>\n" 
-    "  exhaustive\n"
+    "  exhaustive[:full-rank]\n"
     "  random:<r>\n"
     "  full-CBC\n"
     "  random-CBC:<r>\n"
     "  mixed-CBC:<r>:<nb_full>\n"
-    "where <net_description> is a net description (see documentation), <r> is the number of samples, and <nb_full> the number of coordinates for which full CBC exploration is used.")
+    "where <net_description> is a net description (see documentation), <r> is the number of samples, and <nb_full> the number of coordinates for which full CBC exploration is used. For explicit nets, the exhaustive exploration enumerates the generating matrices in a Gray-code order and the full-rank option skips the nets with a generating matrix which is not of full rank.")
    ("figure-of-merit,f", po::value<std::string>(),
     "(required) type of figure of merit; format: <merit>\n"
     "  and where <merit> is one of:\n"
@@ -135,7 +139,37 @@ makeOptionsDescription()
     ("output-style,O", po::value<std::string>()->default_value(""),
     "(optional) TBD\n")
     ("merit-digits-displayed", po::value<unsigned int>()->default_value(0),
-    "(optional) number of significant figures to use when displaying merit values\n");
+    "(optional) number of significant figures to use when displaying merit values\n")
+    ("threads,T", po::value<unsigned int>()->default_value(1),
+    "(optional) number of threads used to evaluate the candidate nets of CBC explorations, or the projections of the net for evaluations, and to generate the points written with --output-points (default: 1)\n")
+    ("producer-threads", po::value<unsigned int>()->default_value(0),
+    "(optional) number of threads constructing the candidate nets of CBC explorations while the threads given by --threads evaluate them; "
+    "if 0 (default), the candidate nets are constructed by the evaluation threads\n")
+    ("output-points", po::value<std::string>(),
+    "(optional) path to a binary file where the points of the resulting net are written in Gray-code order, after a 64-byte header "
+    "giving the format, the ordering, the number of points and the dimension (see netbuilder/PointFile.h). The file is overwritten.\n")
+    ("output-points-format", po::value<std::string>()->default_value("float64"),
+    "(optional) format of the values written with --output-points; possible values:\n"
+    "  float64 (default)\n"
+    "  float32\n"
+    "  uint32 (first 32 binary digits of each coordinate)\n"
+    "  uint64 (first 64 binary digits of each coordinate)\n")
+    ("output-points-mmap", po::value<std::string>()->default_value("false"),
+    "(optional) write the points through a memory mapping of the file instead of a stream; possible values:\n"
+    "  false (default)\n"
+    "  true\n")
+    ("output-points-randomization", po::value<std::string>()->default_value("none"),
+    "(optional) randomization of the points written with --output-points; possible values:\n"
+    "  none (default)\n"
+    "  digital-shift (random digital shift)\n"
+    "  lms (left matrix scramble)\n"
+    "  lms-digital-shift (left matrix scramble followed by a random digital shift)\n"
+    "  nested-uniform (Owen's nested uniform scramble)\n")
+    ("output-points-replicates", po::value<unsigned int>()->default_value(1),
+    "(optional) number of independent randomizations of the net written one after the other with --output-points (default: 1)\n")
+    ("output-points-seed", po::value<uint64_t>()->default_value(0),
+    "(optional) seed of the randomizations of the points written with --output-points; replicate r only depends on the seed and on r "
+    "(default: 0, the default seed of the LFSR258 generator)\n");
 
    return desc;
 }
@@ -182,6 +216,8 @@ cmd.s_figure = opt["figure-of-merit"].as<std::string>();\
 cmd.s_weights       = opt["weights"].as<std::vector<std::string>>();\
 cmd.m_normType = boost::lexical_cast<Real>(opt["norm-type"].as<std::string>());\
 cmd.m_interlacingFactor = opt["interlacing-factor"].as<unsigned int>(); \
+cmd.m_nThreads = opt["threads"].as<unsigned int>(); \
+cmd.m_nProducerThreads = opt["producer-threads"].as<unsigned int>(); \
 interlacingFactor = cmd.m_interlacingFactor;\
 if (opt.count("combiner") < 1){\
   cmd.s_combiner = "";\
@@ -231,6 +267,34 @@ void TaskOutput(const Task::Task &task, std::string outputFolder, OutputStyle ou
 }
 
 
+void PointsOutput(const Task::Task &task, const PointFileOptions& options, unsigned int interlacingFactor, unsigned int nThreads)
+{
+  using namespace std::chrono;
+  auto t0 = high_resolution_clock::now();
+  uInteger numPoints;
+  Dimension dimension;
+  if (options.randomization == Randomization::NONE){
+    PointGenerator generator(task.outputNetObject(), interlacingFactor, std::numeric_limits<unsigned long>::digits);
+    generator.generateToFile(options.filename, options.format, options.useMemoryMap, nThreads);
+    numPoints = generator.numPoints();
+    dimension = generator.dimension();
+  }
+  else{
+    auto seed = (options.seed == 0) ? LatBuilder::LFSR258::default_seed : RandomizedPointGenerator::seedFromInteger(options.seed);
+    RandomizedPointGenerator generator(task.outputNetObject(), options.randomization, interlacingFactor, seed);
+    generator.generateToFile(options.filename, options.numReplicates, options.format, options.useMemoryMap, nThreads);
+    numPoints = generator.numPoints();
+    dimension = generator.dimension();
+  }
+  auto dt = duration_cast<duration<double>>(high_resolution_clock::now() - t0);
+  std::cout << "Points written in " << options.filename << " (" << numPoints << " points in dimension " << dimension;
+  if (options.randomization != Randomization::NONE){
+    std::cout << ", " << options.numReplicates << " replicates";
+  }
+  std::cout << ") in " << dt.count() << " seconds" << std::endl;
+}
+
+
 int main(int argc, const char *argv[])
 {
 
@@ -258,6 +322,26 @@ int main(int argc, const char *argv[])
         std::string s_multilevel = opt["multilevel"].as<std::string>();
         std::string s_construction = opt["construction"].as<std::string>();
         std::string s_outputStyle = opt["output-style"].as<std::string>();
+
+        PointFileOptions pointsOutput;
+        if (opt.count("output-points") >= 1){
+          pointsOutput.filename = opt["output-points"].as<std::string>();
+          pointsOutput.format = NetBuilder::Parser::PointFormatParser::parse(opt["output-points-format"].as<std::string>());
+          std::string s_mmap = opt["output-points-mmap"].as<std::string>();
+          if (s_mmap != "true" && s_mmap != "false"){
+            throw std::runtime_error("--output-points-mmap must be true or false (try --help)");
+          }
+          pointsOutput.useMemoryMap = (s_mmap == "true");
+          pointsOutput.randomization = NetBuilder::Parser::RandomizationParser::parse(opt["output-points-randomization"].as<std::string>());
+          pointsOutput.numReplicates = opt["output-points-replicates"].as<unsigned int>();
+          pointsOutput.seed = opt["output-points-seed"].as<uint64_t>();
+          if (pointsOutput.randomization == Randomization::RANDOM_SHIFT){
+            throw std::runtime_error("--output-points-randomization random-shift only applies to ordinary lattice rules, use digital-shift (try --help)");
+          }
+          if (pointsOutput.randomization == Randomization::NONE && pointsOutput.numReplicates != 1){
+            throw std::runtime_error("--output-points-replicates requires --output-points-randomization (try --help)");
+          }
+        }
         NetBuilder::EmbeddingType embeddingType = NetBuilder::Parser::EmbeddingTypeParser::parse(s_multilevel);
 
         NetBuilder::NetConstruction netConstruction;
@@ -352,6 +436,9 @@ int main(int argc, const char *argv[])
           TaskOutput(*task, outputFolder, outputStyle, interlacingFactor, inputCL);
           std::cout << std::endl;
           std::cout << "ELAPSED CPU TIME: " << dt.count() << " seconds" << std::endl;
+          if (pointsOutput.filename != ""){
+            PointsOutput(*task, pointsOutput, interlacingFactor, opt["threads"].as<unsigned int>());
+          }
           task->reset();
       }
    }